@@ -37,10 +37,10 @@ extension Dictionary {
     
     /// Use this dictionary to decode the given object type.
     public func rsd_decode<T>(_ type: T.Type, bundle: Bundle? = nil) throws -> T where T : Decodable {
-        let decoder = RSDFactory.shared.createJSONDecoder(bundle: bundle)
         let jsonData = try JSONSerialization.data(withJSONObject: self, options: [])
-        let decodable = try decoder.decode(type, from: jsonData)
-        return decodable
+        return try RSDFactory.shared.withJSONDecoder(bundle: bundle) { decoder in
+            try decoder.decode(type, from: jsonData)
+        }
     }
 }
 
@@ -48,10 +48,10 @@ extension Array {
     
     /// Use this array to decode an array of objects of the given type.
     public func rsd_decode<T>(_ type: Array<T>.Type, bundle: Bundle? = nil) throws -> Array<T> where T : Decodable {
-        let decoder = RSDFactory.shared.createJSONDecoder(bundle: bundle)
         let jsonData = try JSONSerialization.data(withJSONObject: self, options: [])
-        let decodable = try decoder.decode(type, from: jsonData)
-        return decodable
+        return try RSDFactory.shared.withJSONDecoder(bundle: bundle) { decoder in
+            try decoder.decode(type, from: jsonData)
+        }
     }
 }
 
@@ -56,3 +56,278 @@ public let rsd_ISO8601TimeOnlyFormatter: DateFormatter = {
     formatter.locale = Locale(identifier: "en_US_POSIX")
     return formatter
 }()
+
+/// The shape of a string that is formatted using one of the ISO 8601 formats supported by `RSDFactory`.
+/// The shape is determined by scanning the string once rather than by trying each formatter in turn.
+internal enum RSDISO8601Shape {
+    
+    /// A timestamp that includes date, time, and time zone. Timestamps are fully parsed while scanning.
+    case timestamp(Date)
+    
+    /// A date-only string with the format "yyyy-MM-dd".
+    case dateOnly
+    
+    /// A time-only string with the format "HH:mm:ss.SSS".
+    case timeOnly
+    
+    /// A time-only string with the format "HH:mm:ss".
+    case timeOnlyWithoutFraction
+    
+    /// A string that does not match any of the expected shapes or that has values that are out of range.
+    case unknown
+    
+    /// Scan the string for its shape.
+    ///
+    /// Timestamps are parsed for strings with the format "yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ", where the time zone
+    /// may be "Z", "+hh:mm" or "+hhmm", and for strings with the format "yyyy-MM-dd'T'HH:mm:ssZZZZZ". Other
+    /// timestamp formats are returned as `.unknown`. The parser uses the proleptic Gregorian calendar so years
+    /// that are before the Julian to Gregorian cutover are also returned as `.unknown`.
+    init(_ string: String) {
+        var scanner = _ISO8601Scanner(string.utf8.makeIterator())
+        guard let hh = scanner.digits(2) else {
+            self = .unknown
+            return
+        }
+        
+        if scanner.skip(_ISO8601Scanner.colon) {
+            guard scanner.digits(2) != nil, scanner.skip(_ISO8601Scanner.colon), scanner.digits(2) != nil
+                else {
+                    self = .unknown
+                    return
+            }
+            if scanner.isAtEnd {
+                self = .timeOnlyWithoutFraction
+            }
+            else if scanner.skip(_ISO8601Scanner.period), scanner.digits(3) != nil, scanner.isAtEnd {
+                self = .timeOnly
+            }
+            else {
+                self = .unknown
+            }
+            return
+        }
+        
+        guard let yy = scanner.digits(2), scanner.skip(_ISO8601Scanner.dash),
+            let month = scanner.digits(2), scanner.skip(_ISO8601Scanner.dash),
+            let day = scanner.digits(2)
+            else {
+                self = .unknown
+                return
+        }
+        if scanner.isAtEnd {
+            self = .dateOnly
+            return
+        }
+        
+        guard scanner.skip(_ISO8601Scanner.timeSeparator),
+            let hour = scanner.digits(2), scanner.skip(_ISO8601Scanner.colon),
+            let minute = scanner.digits(2), scanner.skip(_ISO8601Scanner.colon),
+            let second = scanner.digits(2)
+            else {
+                self = .unknown
+                return
+        }
+        
+        var milliseconds: Int?
+        if scanner.skip(_ISO8601Scanner.period) {
+            guard let ms = scanner.digits(3) else {
+                self = .unknown
+                return
+            }
+            milliseconds = ms
+        }
+        
+        var offset = 0
+        var isExtendedZone = true
+        if !scanner.skip(_ISO8601Scanner.utc) {
+            let sign: Int
+            if scanner.skip(_ISO8601Scanner.plus) {
+                sign = 1
+            } else if scanner.skip(_ISO8601Scanner.dash) {
+                sign = -1
+            } else {
+                self = .unknown
+                return
+            }
+            guard let offsetHours = scanner.digits(2) else {
+                self = .unknown
+                return
+            }
+            isExtendedZone = scanner.skip(_ISO8601Scanner.colon)
+            guard let offsetMinutes = scanner.digits(2), offsetHours <= 18, offsetMinutes < 60 else {
+                self = .unknown
+                return
+            }
+            offset = sign * (offsetHours * 3600 + offsetMinutes * 60)
+        }
+        
+        // Timestamps without fractional seconds are only supported with the extended time zone format.
+        let year = hh * 100 + yy
+        guard scanner.isAtEnd, (milliseconds != nil || isExtendedZone),
+            year >= rsd_ISO8601MinimumGregorianYear,
+            month >= 1, month <= 12, day >= 1, day <= rsd_daysInMonth(month, year: year),
+            hour < 24, minute < 60, second < 60
+            else {
+                self = .unknown
+                return
+        }
+        
+        let days = rsd_daysFromCivil(year: year, month: month, day: day)
+        let seconds = Int64(days) * 86400 + Int64(hour * 3600 + minute * 60 + second - offset)
+        let totalMilliseconds = seconds * 1000 + Int64(milliseconds ?? 0)
+        self = .timestamp(Date(timeIntervalSince1970: Double(totalMilliseconds) / 1000.0))
+    }
+}
+
+/// Format the date using the same format as `rsd_ISO8601TimestampFormatter` without using a `DateFormatter`.
+///
+/// - parameters:
+///     - date: The date to format.
+///     - timeZone: The time zone to use for the local time.
+/// - returns: The formatted string or `nil` if the date cannot be formatted without using a formatter.
+internal func rsd_ISO8601TimestampString(from date: Date, timeZone: TimeZone) -> String? {
+    let offset = timeZone.secondsFromGMT(for: date)
+    let interval = date.timeIntervalSince1970 * 1000.0
+    guard offset % 60 == 0, interval.isFinite, abs(interval) < 1.0e15 else { return nil }
+    
+    // Match the formatter which truncates toward the earlier millisecond.
+    let localMilliseconds = Int64(interval.rounded(.down)) + Int64(offset) * 1000
+    let millisecondsPerDay: Int64 = 86400 * 1000
+    var days = localMilliseconds / millisecondsPerDay
+    var dayMilliseconds = localMilliseconds % millisecondsPerDay
+    if dayMilliseconds < 0 {
+        days -= 1
+        dayMilliseconds += millisecondsPerDay
+    }
+    let civil = rsd_civilFromDays(Int(days))
+    guard civil.year >= rsd_ISO8601MinimumGregorianYear, civil.year <= 9999 else { return nil }
+    
+    let ms = Int(dayMilliseconds)
+    let hour = ms / 3600000
+    let minute = (ms / 60000) % 60
+    let second = (ms / 1000) % 60
+    let fraction = ms % 1000
+    
+    // "yyyy-MM-ddTHH:mm:ss.SSS+hh:mm" is at most 29 bytes.
+    var storage: (UInt64, UInt64, UInt64, UInt64) = (0, 0, 0, 0)
+    return withUnsafeMutableBytes(of: &storage) { buffer -> String in
+        var idx = 0
+        func writeDigits(_ value: Int, count digits: Int) {
+            var value = value
+            var ii = idx + digits - 1
+            while ii >= idx {
+                buffer[ii] = 0x30 + UInt8(value % 10)
+                value /= 10
+                ii -= 1
+            }
+            idx += digits
+        }
+        func writeByte(_ char: UInt8) {
+            buffer[idx] = char
+            idx += 1
+        }
+        writeDigits(civil.year, count: 4)
+        writeByte(_ISO8601Scanner.dash)
+        writeDigits(civil.month, count: 2)
+        writeByte(_ISO8601Scanner.dash)
+        writeDigits(civil.day, count: 2)
+        writeByte(_ISO8601Scanner.timeSeparator)
+        writeDigits(hour, count: 2)
+        writeByte(_ISO8601Scanner.colon)
+        writeDigits(minute, count: 2)
+        writeByte(_ISO8601Scanner.colon)
+        writeDigits(second, count: 2)
+        writeByte(_ISO8601Scanner.period)
+        writeDigits(fraction, count: 3)
+        if offset == 0 {
+            writeByte(_ISO8601Scanner.utc)
+        }
+        else {
+            writeByte(offset < 0 ? _ISO8601Scanner.dash : _ISO8601Scanner.plus)
+            let offsetMinutes = abs(offset) / 60
+            writeDigits(offsetMinutes / 60, count: 2)
+            writeByte(_ISO8601Scanner.colon)
+            writeDigits(offsetMinutes % 60, count: 2)
+        }
+        return String(decoding: buffer[..<idx], as: UTF8.self)
+    }
+}
+
+/// `DateFormatter` uses the Julian calendar for dates before the Gregorian cutover in October 1582.
+fileprivate let rsd_ISO8601MinimumGregorianYear = 1583
+
+/// Days since 1970-01-01 in the proleptic Gregorian calendar.
+/// - seealso: http://howardhinnant.github.io/date_algorithms.html
+fileprivate func rsd_daysFromCivil(year: Int, month: Int, day: Int) -> Int {
+    let y = month <= 2 ? year - 1 : year
+    let era = (y >= 0 ? y : y - 399) / 400
+    let yoe = y - era * 400
+    let mp = month > 2 ? month - 3 : month + 9
+    let doy = (153 * mp + 2) / 5 + day - 1
+    let doe = yoe * 365 + yoe / 4 - yoe / 100 + doy
+    return era * 146097 + doe - 719468
+}
+
+/// The calendar date for the given number of days since 1970-01-01 in the proleptic Gregorian calendar.
+fileprivate func rsd_civilFromDays(_ days: Int) -> (year: Int, month: Int, day: Int) {
+    let z = days + 719468
+    let era = (z >= 0 ? z : z - 146096) / 146097
+    let doe = z - era * 146097
+    let yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365
+    let doy = doe - (365 * yoe + yoe / 4 - yoe / 100)
+    let mp = (5 * doy + 2) / 153
+    let day = doy - (153 * mp + 2) / 5 + 1
+    let month = mp < 10 ? mp + 3 : mp - 9
+    let year = yoe + era * 400 + (month <= 2 ? 1 : 0)
+    return (year, month, day)
+}
+
+fileprivate func rsd_daysInMonth(_ month: Int, year: Int) -> Int {
+    switch month {
+    case 2:
+        let isLeapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0
+        return isLeapYear ? 29 : 28
+    case 4, 6, 9, 11:
+        return 30
+    default:
+        return 31
+    }
+}
+
+/// Reads the UTF8 bytes of a string one at a time without copying the string.
+fileprivate struct _ISO8601Scanner {
+    static let colon = UInt8(ascii: ":")
+    static let dash = UInt8(ascii: "-")
+    static let plus = UInt8(ascii: "+")
+    static let period = UInt8(ascii: ".")
+    static let timeSeparator = UInt8(ascii: "T")
+    static let utc = UInt8(ascii: "Z")
+    
+    private var iterator: String.UTF8View.Iterator
+    private var current: UInt8?
+    
+    init(_ iterator: String.UTF8View.Iterator) {
+        self.iterator = iterator
+        self.current = self.iterator.next()
+    }
+    
+    var isAtEnd: Bool {
+        return current == nil
+    }
+    
+    mutating func skip(_ char: UInt8) -> Bool {
+        guard current == char else { return false }
+        current = iterator.next()
+        return true
+    }
+    
+    mutating func digits(_ count: Int) -> Int? {
+        var value = 0
+        for _ in 0..<count {
+            guard let char = current, char >= 0x30, char <= 0x39 else { return nil }
+            value = value * 10 + Int(char - 0x30)
+            current = iterator.next()
+        }
+        return value
+    }
+}
@@ -41,6 +41,14 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param symbol   The symbol for the unit.
 + (NSUnitLength * _Nullable)unitLengthFromSymbol:(NSString *)symbol;
 
+/// Convert the localized name into a unit of length. The lookup table includes the symbol and the
+/// short, medium, and long singular and plural names for each unit. It is built once per locale and unit
+/// style and then shared by all callers.
+/// @param string       The symbol or localized name for the unit.
+/// @param locale       The locale to use to localize the unit names.
+/// @param unitStyle    The unit style with the names to use if more than one unit has the same name.
++ (NSUnitLength * _Nullable)unitLengthFromLocalizedString:(NSString *)string locale:(NSLocale *)locale unitStyle:(NSFormattingUnitStyle)unitStyle;
+
 @end
 
 @interface NSUnitMass (RSDUnitConversion)
@@ -49,6 +57,14 @@ NS_ASSUME_NONNULL_BEGIN
 /// @param symbol   The symbol for the unit.
 + (NSUnitMass * _Nullable)unitMassFromSymbol:(NSString *)symbol;
 
+/// Convert the localized name into a unit of mass. The lookup table includes the symbol and the
+/// short, medium, and long singular and plural names for each unit. It is built once per locale and unit
+/// style and then shared by all callers.
+/// @param string       The symbol or localized name for the unit.
+/// @param locale       The locale to use to localize the unit names.
+/// @param unitStyle    The unit style with the names to use if more than one unit has the same name.
++ (NSUnitMass * _Nullable)unitMassFromLocalizedString:(NSString *)string locale:(NSLocale *)locale unitStyle:(NSFormattingUnitStyle)unitStyle;
+
 @end
 
 @interface NSUnitDuration (RSDUnitConversion)
@@ -59,4 +75,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+@interface NSDimension (RSDUnitConversion)
+
+/// Convert the values in place from one unit to another unit of the same dimension. For linear unit
+/// converters, the scale and offset are calculated once so that the loop over the buffer can be
+/// vectorized by the compiler.
+/// @param values   A contiguous buffer of values to convert.
+/// @param count    The number of values in the buffer.
+/// @param fromUnit The unit of the input values.
+/// @param toUnit   The unit to convert the values to.
++ (void)convertValues:(double *)values count:(NSUInteger)count fromUnit:(NSDimension *)fromUnit toUnit:(NSDimension *)toUnit;
+
+@end
+
 NS_ASSUME_NONNULL_END
@@ -33,17 +33,119 @@
 
 #import "NSUnit+RSDUnitConversion.h"
 
+/// Build a lookup table of symbol to unit. If more than one unit has the same symbol, then the first unit
+/// in the array is used.
+static NSDictionary<NSString *, id> * RSDUnitSymbolIndex(NSArray<NSUnit *> *units) {
+    NSMutableDictionary *index = [NSMutableDictionary dictionaryWithCapacity:units.count];
+    for (NSUnit *unit in units) {
+        if (index[unit.symbol] == nil) {
+            index[unit.symbol] = unit;
+        }
+    }
+    return [index copy];
+}
+
+/// Returns the cached lookup table of localized unit name to unit for the given locale and unit style,
+/// building it using the given block if this is the first request for that key.
+static NSDictionary<NSString *, id> * RSDLocalizedUnitIndex(NSString *dimension,
+                                                            NSLocale *locale,
+                                                            NSFormattingUnitStyle unitStyle,
+                                                            NSDictionary<NSString *, id> * (^buildIndex)(void)) {
+    static NSMutableDictionary<NSString *, NSDictionary *> *cache;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        cache = [NSMutableDictionary new];
+    });
+    
+    NSString *key = [NSString stringWithFormat:@"%@|%@|%ld", dimension, locale.localeIdentifier, (long)unitStyle];
+    @synchronized (cache) {
+        NSDictionary *index = cache[key];
+        if (index == nil) {
+            index = buildIndex();
+            cache[key] = index;
+        }
+        return index;
+    }
+}
+
+/// Add the singular and plural localized names for the unit to the index. If more than one unit has the
+/// same name, then the first unit added is used.
+static void RSDAddLocalizedUnitNames(NSMutableDictionary *index, NSString *singular, NSString *plural, NSUnit *unit) {
+    if ((singular.length > 0) && (index[singular] == nil)) {
+        index[singular] = unit;
+    }
+    if ((plural.length > 0) && (index[plural] == nil)) {
+        index[plural] = unit;
+    }
+}
+
+/// Build a lookup table that includes the symbol and the short, medium, and long singular and plural
+/// names for each unit. The names for the given unit style are added first so that they take priority
+/// if the same name is used by more than one unit.
+static NSDictionary<NSString *, id> * RSDBuildLocalizedUnitIndex(NSDictionary<NSNumber *, NSUnit *> *unitConversions,
+                                                                 NSFormattingUnitStyle unitStyle,
+                                                                 NSString * (^unitString)(NSFormattingUnitStyle style, double value, NSInteger formatterUnit)) {
+    NSMutableArray<NSNumber *> *styles = [@[@(unitStyle)] mutableCopy];
+    for (NSNumber *style in @[@(NSFormattingUnitStyleLong), @(NSFormattingUnitStyleMedium), @(NSFormattingUnitStyleShort)]) {
+        if (![styles containsObject:style]) {
+            [styles addObject:style];
+        }
+    }
+    
+    NSMutableDictionary *index = [NSMutableDictionary new];
+    for (NSNumber *style in styles) {
+        [unitConversions enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, NSUnit *unit, BOOL *stop) {
+            NSFormattingUnitStyle formattingStyle = style.integerValue;
+            RSDAddLocalizedUnitNames(index,
+                                     unitString(formattingStyle, 1, key.integerValue),
+                                     unitString(formattingStyle, 100, key.integerValue),
+                                     unit);
+        }];
+    }
+    [unitConversions enumerateKeysAndObjectsUsingBlock:^(NSNumber *key, NSUnit *unit, BOOL *stop) {
+        RSDAddLocalizedUnitNames(index, unit.symbol, nil, unit);
+    }];
+    return [index copy];
+}
+
 @implementation NSUnitLength (RSDUnitConversion)
 
 /// Convert the symbol into a unit of length.
 + (NSUnitLength * _Nullable)unitLengthFromSymbol:(NSString *)symbol {
     NSString *searchSymbol = [symbol stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-    for (NSUnitLength *unit in [self units]) {
-        if ([unit.symbol isEqualToString:searchSymbol]) {
-            return unit;
-        }
-    }
-    return nil;
+    return [self symbolIndex][searchSymbol];
+}
+
++ (NSDictionary <NSString *, NSUnitLength *> *)symbolIndex {
+    static dispatch_once_t once;
+    static NSDictionary <NSString *, NSUnitLength *> * symbolIndex;
+    dispatch_once(&once, ^{
+        symbolIndex = RSDUnitSymbolIndex([self units]);
+    });
+    return symbolIndex;
+}
+
++ (NSUnitLength * _Nullable)unitLengthFromLocalizedString:(NSString *)string locale:(NSLocale *)locale unitStyle:(NSFormattingUnitStyle)unitStyle {
+    NSDictionary *index = RSDLocalizedUnitIndex(@"length", locale, unitStyle, ^NSDictionary *{
+        NSDictionary * unitConversions = @{
+                                           @(NSLengthFormatterUnitInch) : NSUnitLength.inches,
+                                           @(NSLengthFormatterUnitFoot) : NSUnitLength.feet,
+                                           @(NSLengthFormatterUnitYard) : NSUnitLength.yards,
+                                           @(NSLengthFormatterUnitMile) : NSUnitLength.miles,
+                                           @(NSLengthFormatterUnitMeter) : NSUnitLength.meters,
+                                           @(NSLengthFormatterUnitKilometer) : NSUnitLength.kilometers,
+                                           @(NSLengthFormatterUnitCentimeter) : NSUnitLength.centimeters,
+                                           @(NSLengthFormatterUnitMillimeter) : NSUnitLength.millimeters };
+        
+        NSLengthFormatter *formatter = [NSLengthFormatter new];
+        formatter.numberFormatter.locale = locale;
+        
+        return RSDBuildLocalizedUnitIndex(unitConversions, unitStyle, ^NSString *(NSFormattingUnitStyle style, double value, NSInteger formatterUnit) {
+            formatter.unitStyle = style;
+            return [formatter unitStringFromValue:value unit:formatterUnit];
+        });
+    });
+    return index[string];
 }
 
 + (NSArray <NSUnitLength *> *)units {
@@ -84,12 +186,36 @@
 /// Convert the symbol into a unit of Mass.
 + (NSUnitMass * _Nullable)unitMassFromSymbol:(NSString *)symbol {
     NSString *searchSymbol = [symbol stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-    for (NSUnitMass *unit in [self units]) {
-        if ([unit.symbol isEqualToString:searchSymbol]) {
-            return unit;
-        }
-    }
-    return nil;
+    return [self symbolIndex][searchSymbol];
+}
+
++ (NSDictionary <NSString *, NSUnitMass *> *)symbolIndex {
+    static dispatch_once_t once;
+    static NSDictionary <NSString *, NSUnitMass *> * symbolIndex;
+    dispatch_once(&once, ^{
+        symbolIndex = RSDUnitSymbolIndex([self units]);
+    });
+    return symbolIndex;
+}
+
++ (NSUnitMass * _Nullable)unitMassFromLocalizedString:(NSString *)string locale:(NSLocale *)locale unitStyle:(NSFormattingUnitStyle)unitStyle {
+    NSDictionary *index = RSDLocalizedUnitIndex(@"mass", locale, unitStyle, ^NSDictionary *{
+        NSDictionary * unitConversions = @{
+                                           @(NSMassFormatterUnitGram) : NSUnitMass.grams,
+                                           @(NSMassFormatterUnitKilogram) : NSUnitMass.kilograms,
+                                           @(NSMassFormatterUnitOunce) : NSUnitMass.ounces,
+                                           @(NSMassFormatterUnitPound) : NSUnitMass.poundsMass,
+                                           @(NSMassFormatterUnitStone) : NSUnitMass.stones};
+        
+        NSMassFormatter *formatter = [NSMassFormatter new];
+        formatter.numberFormatter.locale = locale;
+        
+        return RSDBuildLocalizedUnitIndex(unitConversions, unitStyle, ^NSString *(NSFormattingUnitStyle style, double value, NSInteger formatterUnit) {
+            formatter.unitStyle = style;
+            return [formatter unitStringFromValue:value unit:formatterUnit];
+        });
+    });
+    return index[string];
 }
 
 + (NSArray <NSUnitMass *> *)units {
@@ -125,12 +251,16 @@
 /// @param symbol   The symbol for the unit.
 + (NSUnitDuration * _Nullable)unitDurationFromSymbol:(NSString *)symbol {
     NSString *searchSymbol = [symbol stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
-    for (NSUnitDuration *unit in [self units]) {
-        if ([unit.symbol isEqualToString:searchSymbol]) {
-            return unit;
-        }
-    }
-    return [self longUnits][symbol];
+    return [self symbolIndex][searchSymbol] ? : [self longUnits][symbol];
+}
+
++ (NSDictionary <NSString *, NSUnitDuration *> *)symbolIndex {
+    static dispatch_once_t once;
+    static NSDictionary <NSString *, NSUnitDuration *> * symbolIndex;
+    dispatch_once(&once, ^{
+        symbolIndex = RSDUnitSymbolIndex([self units]);
+    });
+    return symbolIndex;
 }
 
 + (NSArray <NSUnitDuration *> *)units {
@@ -158,3 +288,33 @@
 }
 
 @end
+
+@implementation NSDimension (RSDUnitConversion)
+
++ (void)convertValues:(double *)values count:(NSUInteger)count fromUnit:(NSDimension *)fromUnit toUnit:(NSDimension *)toUnit {
+    if ((count == 0) || [fromUnit isEqual:toUnit]) {
+        return;
+    }
+    
+    NSUnitConverter *fromConverter = fromUnit.converter;
+    NSUnitConverter *toConverter = toUnit.converter;
+    if ([fromConverter isKindOfClass:[NSUnitConverterLinear class]] &&
+        [toConverter isKindOfClass:[NSUnitConverterLinear class]]) {
+        
+        // base = value * c1 + k1, and result = (base - k2) / c2 so combine into a single scale and offset.
+        NSUnitConverterLinear *fromLinear = (NSUnitConverterLinear *)fromConverter;
+        NSUnitConverterLinear *toLinear = (NSUnitConverterLinear *)toConverter;
+        const double scale = fromLinear.coefficient / toLinear.coefficient;
+        const double offset = (fromLinear.constant - toLinear.constant) / toLinear.coefficient;
+        for (NSUInteger ii = 0; ii < count; ii++) {
+            values[ii] = values[ii] * scale + offset;
+        }
+        
+    } else {
+        for (NSUInteger ii = 0; ii < count; ii++) {
+            values[ii] = [toConverter valueFromBaseUnitValue:[fromConverter baseUnitValueFromValue:values[ii]]];
+        }
+    }
+}
+
+@end
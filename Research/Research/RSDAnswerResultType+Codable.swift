@@ -440,8 +440,9 @@ fileprivate struct AnswerResultTypeCodingWrapper : Codable {
     }
     
     func jsonValue() throws -> RSDJSONSerializable {
-        let jsonEncoder = RSDFactory.shared.createJSONEncoder()
-        let data = try jsonEncoder.encode(self)
+        let data = try RSDFactory.shared.withJSONEncoder { jsonEncoder in
+            try jsonEncoder.encode(self)
+        }
         let json = try JSONSerialization.jsonObject(with: data, options: [])
         guard let dictionary = json as? [String : Any],
             let value = dictionary[CodingKeys.object.rawValue] as? RSDJSONValue
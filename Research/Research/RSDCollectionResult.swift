@@ -41,6 +41,23 @@ public protocol RSDCollectionResult : RSDResult, RSDAnswerResultFinder {
     /// The list of input results associated with this step. These are generally assumed to be answers to
     /// field inputs, but they are not required to implement the `RSDAnswerResult` protocol.
     var inputResults: [RSDResult] { get set }
+    
+    /// Find a result within this collection.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    func findResult(with identifier: String) -> RSDResult?
+    
+    /// Append the result to the end of the input results, replacing the previous instance with the same identifier.
+    /// - parameter result: The result to add to the input results.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating func appendInputResults(with result: RSDResult) -> RSDResult?
+    
+    /// Remove the result with the given identifier.
+    /// - parameter result: The result to remove from the input results.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating func removeInputResult(with identifier: String) -> RSDResult?
 }
 
 extension RSDCollectionResult {
@@ -51,7 +51,11 @@ public struct RSDCollectionResultObject : RSDCollectionResult, RSDNavigationResu
     
     /// The list of input results associated with this step. These are generally assumed to be answers to
     /// field inputs, but they are not required to implement the `RSDAnswerResult` protocol.
-    public var inputResults: [RSDResult]
+    public var inputResults: [RSDResult] {
+        get { return _inputResults.results }
+        set { _inputResults = RSDIndexedResults(newValue) }
+    }
+    private var _inputResults = RSDIndexedResults()
     
     /// The identifier for the step to go to following this result. If non-nil, then this will be used in
     /// navigation handling.
@@ -64,7 +68,6 @@ public struct RSDCollectionResultObject : RSDCollectionResult, RSDNavigationResu
     public init(identifier: String) {
         self.identifier = identifier
         self.type = .collection
-        self.inputResults = []
     }
     
     private enum CodingKeys : String, CodingKey, CaseIterable {
@@ -111,12 +114,38 @@ public struct RSDCollectionResultObject : RSDCollectionResult, RSDNavigationResu
         copy.startDate = self.startDate
         copy.endDate = self.endDate
         copy.type = self.type
-        copy.inputResults = self.inputResults
+        copy._inputResults = self._inputResults
         copy.skipToIdentifier = self.skipToIdentifier
         return copy
     }
 }
 
+extension RSDCollectionResultObject {
+    
+    /// Find a result within this collection.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    public func findResult(with identifier: String) -> RSDResult? {
+        return _inputResults.result(with: identifier)
+    }
+    
+    /// Append the result to the end of the input results, replacing the previous instance with the same identifier.
+    /// - parameter result: The result to add to the input results.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating public func appendInputResults(with result: RSDResult) -> RSDResult? {
+        return _inputResults.appendReplacing(result)
+    }
+    
+    /// Remove the result with the given identifier.
+    /// - parameter result: The result to remove from the input results.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating public func removeInputResult(with identifier: String) -> RSDResult? {
+        return _inputResults.remove(with: identifier)
+    }
+}
+
 extension RSDCollectionResultObject : RSDDocumentableCodableObject {
     
     static func codingKeys() -> [CodingKey] {
@@ -52,11 +52,47 @@ public final class RSDColorMatrix {
         }
         return _registeredLibraries!
     }
-    private var _registeredLibraries: [RSDColorLibrary]?
+    private var _registeredLibraries: [RSDColorLibrary]? {
+        didSet {
+            _lookupIndex = nil
+        }
+    }
+    
+    /// Should the libraries be decoded one version at a time as they are requested? If `false`, then all
+    /// the libraries are decoded the first time that any library is accessed.
+    internal var loadsLibrariesLazily: Bool = true
+    
+    /// The memory-mapped color matrix file.
+    private var _libraryData: Data?
+    
+    /// The byte range of each library in the color matrix file, keyed by version. The file is scanned
+    /// once and each library is only decoded when it is requested.
+    private var _libraryRanges: [Int : Range<Int>]?
+    
+    /// The sorted list of the library versions included in the color matrix file.
+    private var _libraryVersions: [Int]?
+    
+    /// The libraries that have been decoded, keyed by version.
+    private var _decodedLibraries: [Int : RSDColorLibrary] = [:]
+    
+    /// The lookup tables used to find a color key or color tile. These are built when the libraries are
+    /// decoded and released with the libraries.
+    private var lookupIndex: LookupIndex {
+        if let index = _lookupIndex {
+            return index
+        }
+        let index = LookupIndex(libraries: self.registeredLibraries)
+        _lookupIndex = index
+        return index
+    }
+    private var _lookupIndex: LookupIndex?
     
     /// The current version of the default color library.
     public var currentVersion: Int {
-        return self.registeredLibraries.last!.version
+        guard loadsLibrariesLazily else {
+            return self.registeredLibraries.last!.version
+        }
+        return self.libraryVersions.last!
     }
     
     private init() {
@@ -69,32 +105,203 @@ public final class RSDColorMatrix {
         // min supported library version, but for now, the file is only 18kb and this is really a "just in case"
         // where keeping the whole thing in memory isn't expected to cause problems. syoung 04/12/2019
         NotificationCenter.default.addObserver(forName: UIApplication.didReceiveMemoryWarningNotification, object: self, queue: .main) { (_) in
-            self._registeredLibraries = nil
+            self.releaseLibraries()
         }
         #endif
     }
     
+    /// Release the libraries and the memory-mapped file. They will be reloaded when next requested.
+    internal func releaseLibraries() {
+        _registeredLibraries = nil
+        _libraryData = nil
+        _libraryRanges = nil
+        _libraryVersions = nil
+        _decodedLibraries = [:]
+    }
+    
     private func _decodeLibraries() {
-        guard let url = Bundle(for: RSDColorMatrix.self).url(forResource: "ColorMatrix", withExtension: "json")
-            else {
-                fatalError("Could not decode the color matrix. Something is very wrong.")
+        guard loadsLibrariesLazily else {
+            _decodeAllLibraries()
+            return
+        }
+        let missing = Set(self.libraryVersions).subtracting(_decodedLibraries.keys)
+        _decodeLibraries(with: missing)
+        let libraries = _decodedLibraries.values.sorted()
+        self._registeredLibraries = libraries
+        self._lookupIndex = LookupIndex(libraries: libraries)
+    }
+    
+    private func _decodeAllLibraries() {
+        guard let url = _libraryURL() else {
+            fatalError("Could not decode the color matrix. Something is very wrong.")
         }
         do {
             let data = try Data(contentsOf: url)
             let jsonDecoder = JSONDecoder()
-            let libraries = try jsonDecoder.decode([RSDColorLibrary].self, from: data)
-            self._registeredLibraries = libraries.sorted()
+            let libraries = try jsonDecoder.decode([RSDColorLibrary].self, from: data).sorted()
+            self._registeredLibraries = libraries
+            self._lookupIndex = LookupIndex(libraries: libraries)
+        }
+        catch let err {
+            fatalError("Could not decode the color matrix. Something is very wrong. \(err)")
+        }
+    }
+    
+    private func _libraryURL() -> URL? {
+        return Bundle(for: RSDColorMatrix.self).url(forResource: "ColorMatrix", withExtension: "json")
+    }
+    
+    /// The sorted list of library versions. The first call will scan the color matrix file for the byte
+    /// range and version of each library without decoding the swatches.
+    private var libraryVersions: [Int] {
+        if let versions = _libraryVersions {
+            return versions
+        }
+        let versions = self.libraryRanges.keys.sorted()
+        _libraryVersions = versions
+        return versions
+    }
+    
+    /// The byte range of each library in the memory-mapped color matrix file, keyed by version.
+    private var libraryRanges: [Int : Range<Int>] {
+        if let ranges = _libraryRanges {
+            return ranges
+        }
+        guard let url = _libraryURL() else {
+            fatalError("Could not decode the color matrix. Something is very wrong.")
+        }
+        do {
+            let data = try Data(contentsOf: url, options: .mappedIfSafe)
+            guard let ranges = data.withUnsafeBytes({ RSDColorMatrix.scanLibraryRanges(in: $0) }) else {
+                fatalError("Could not decode the color matrix. The file is not an array of libraries.")
+            }
+            _libraryData = data
+            _libraryRanges = ranges
+            return ranges
+        }
+        catch let err {
+            fatalError("Could not decode the color matrix. Something is very wrong. \(err)")
+        }
+    }
+    
+    /// Decode the libraries with the given versions and add them to the decoded libraries. Only the bytes
+    /// for the requested versions are decoded.
+    private func _decodeLibraries(with versions: Set<Int>) {
+        guard versions.count > 0 else { return }
+        let ranges = self.libraryRanges
+        guard let data = _libraryData else { return }
+        do {
+            let jsonDecoder = JSONDecoder()
+            for version in versions where _decodedLibraries[version] == nil {
+                guard let range = ranges[version] else { continue }
+                let slice = data.subdata(in: range)
+                _decodedLibraries[version] = try jsonDecoder.decode(RSDColorLibrary.self, from: slice)
+            }
         }
         catch let err {
             fatalError("Could not decode the color matrix. Something is very wrong. \(err)")
         }
     }
     
+    /// Scan the bytes of the color matrix file for the top-level library objects. This only tracks the
+    /// nesting depth and string literals of the JSON and reads the `version` key of each library, so the
+    /// swatches are not parsed.
+    ///
+    /// - parameter bytes: The bytes of a JSON array of color libraries.
+    /// - returns: The byte range of each library keyed by version, or `nil` if a library does not have a
+    ///            version or the array is not closed.
+    static func scanLibraryRanges(in bytes: UnsafeRawBufferPointer) -> [Int : Range<Int>]? {
+        let quote = UInt8(ascii: "\""), backslash = UInt8(ascii: "\\"), colon = UInt8(ascii: ":")
+        let openBrace = UInt8(ascii: "{"), closeBrace = UInt8(ascii: "}")
+        let openBracket = UInt8(ascii: "["), closeBracket = UInt8(ascii: "]")
+        let versionKey = Array("version".utf8)
+        
+        var ranges: [Int : Range<Int>] = [:]
+        var depth = 0
+        var objectStart = 0
+        var version: Int?
+        var stringStart: Int?
+        var isEscaped = false
+        var idx = 0
+        
+        func skipWhitespace(_ index: inout Int) {
+            while index < bytes.count, [0x20, 0x09, 0x0A, 0x0D].contains(bytes[index]) {
+                index += 1
+            }
+        }
+        
+        while idx < bytes.count {
+            let byte = bytes[idx]
+            if let start = stringStart {
+                if isEscaped {
+                    isEscaped = false
+                }
+                else if byte == backslash {
+                    isEscaped = true
+                }
+                else if byte == quote {
+                    stringStart = nil
+                    // Keys of the library object are at depth 2. A string is a key if it is followed
+                    // by a colon.
+                    if depth == 2, version == nil, idx - start == versionKey.count,
+                        versionKey.indices.allSatisfy({ bytes[start + $0] == versionKey[$0] }) {
+                        var next = idx + 1
+                        skipWhitespace(&next)
+                        if next < bytes.count, bytes[next] == colon {
+                            next += 1
+                            skipWhitespace(&next)
+                            var value = 0, digitCount = 0
+                            while next < bytes.count, bytes[next] >= 0x30, bytes[next] <= 0x39 {
+                                value = value * 10 + Int(bytes[next] - 0x30)
+                                digitCount += 1
+                                next += 1
+                            }
+                            if digitCount > 0 {
+                                version = value
+                            }
+                        }
+                    }
+                }
+            }
+            else if byte == quote {
+                stringStart = idx + 1
+            }
+            else if byte == openBrace || byte == openBracket {
+                if depth == 1 && byte == openBrace {
+                    objectStart = idx
+                    version = nil
+                }
+                depth += 1
+            }
+            else if byte == closeBrace || byte == closeBracket {
+                depth -= 1
+                if depth == 1 && byte == closeBrace {
+                    guard let ver = version else { return nil }
+                    ranges[ver] = objectStart..<(idx + 1)
+                }
+                else if depth < 0 {
+                    return nil
+                }
+            }
+            idx += 1
+        }
+        return (depth == 0 && stringStart == nil) ? ranges : nil
+    }
+    
     /// The library for a given version.
     ///
     /// - parameter version: The version to return or `nil` to return the most recent.
     /// - returns: The color library for this version.
     public func library(for version: Int?) -> RSDColorLibrary {
+        if loadsLibrariesLazily && _registeredLibraries == nil {
+            let versions = self.libraryVersions
+            let ver = version.flatMap { versions.contains($0) ? $0 : nil } ?? versions.last!
+            if let library = _decodedLibraries[ver] {
+                return library
+            }
+            _decodeLibraries(with: [ver])
+            return _decodedLibraries[ver]!
+        }
         guard let ver = version,
             let library = self.registeredLibraries.first(where: { $0.version == ver })
             else {
@@ -175,6 +382,12 @@ public final class RSDColorMatrix {
     /// - parameter color: The color to find.
     /// - returns: The color tile for this color, if found.
     public func findColorKey(for colorName: String) -> RSDColorKey? {
+        guard let location = lookupIndex.colorNames[colorName] else { return nil }
+        return RSDColorKey(index: location.index, swatch: location.swatch)
+    }
+    
+    /// The original implementation of `findColorKey(for:)` that searches each library.
+    internal func _linearFindColorKey(for colorName: String) -> RSDColorKey? {
         for library in self.registeredLibraries.reversed() {
             for swatch in library.swatches {
                 for (ii, colorTile) in swatch.colorTiles.enumerated() {
@@ -193,6 +406,14 @@ public final class RSDColorMatrix {
     /// - parameter color: The color to find.
     /// - returns: The color tile for this color, if found.
     public func findColorTile(for color: RSDColor) -> RSDColorTile? {
+        guard let key = RGBAKey(color) else {
+            return _linearFindColorTile(for: color)
+        }
+        return lookupIndex.colorTiles[key]?.first(where: { $0.color == color })
+    }
+    
+    /// The original implementation of `findColorTile(for:)` that searches each library.
+    internal func _linearFindColorTile(for color: RSDColor) -> RSDColorTile? {
         for colorTile in RSDGrayScale().colorTiles {
             if colorTile.color == color {
                 return colorTile
@@ -216,6 +437,76 @@ public final class RSDColorMatrix {
         }
         return nil
     }
+    
+    /// The location of a color tile within the registered libraries.
+    fileprivate struct ColorLocation {
+        let version: Int
+        let swatch: RSDColorSwatch
+        let index: Int
+    }
+    
+    /// A color key that uses the RGBA components of the color. Colors that are equal have the same
+    /// components so the key can be used to find the candidate tiles for a color before comparing the colors.
+    fileprivate struct RGBAKey : Hashable {
+        let red: Int
+        let green: Int
+        let blue: Int
+        let alpha: Int
+        
+        init?(_ color: RSDColor) {
+            var r: CGFloat = 0
+            var g: CGFloat = 0
+            var b: CGFloat = 0
+            var a: CGFloat = 0
+            #if os(macOS)
+            guard let rgbColor = color.usingColorSpace(.sRGB) else { return nil }
+            rgbColor.getRed(&r, green: &g, blue: &b, alpha: &a)
+            #else
+            if !color.getRed(&r, green: &g, blue: &b, alpha: &a) {
+                var w: CGFloat = 0
+                guard color.getWhite(&w, alpha: &a) else { return nil }
+                r = w; g = w; b = w
+            }
+            #endif
+            guard r.isFinite, g.isFinite, b.isFinite, a.isFinite else { return nil }
+            self.red = Int((r * 255).rounded())
+            self.green = Int((g * 255).rounded())
+            self.blue = Int((b * 255).rounded())
+            self.alpha = Int((a * 255).rounded())
+        }
+    }
+    
+    /// Hash indices from the color name and from the color components into the registered libraries. The
+    /// indices are built by walking the libraries in the same order as the linear search so that the most
+    /// recent library wins.
+    fileprivate struct LookupIndex {
+        
+        /// The first location for each color name.
+        var colorNames: [String : ColorLocation] = [:]
+        
+        /// The color tiles for each color key in search order.
+        var colorTiles: [RGBAKey : [RSDColorTile]] = [:]
+        
+        init(libraries: [RSDColorLibrary]) {
+            RSDGrayScale().colorTiles.forEach { addColorTile($0) }
+            for library in libraries.reversed() {
+                for swatch in library.swatches {
+                    for (ii, colorTile) in swatch.colorTiles.enumerated() {
+                        if let colorName = colorTile.colorName, colorNames[colorName] == nil {
+                            colorNames[colorName] = ColorLocation(version: library.version, swatch: swatch, index: ii)
+                        }
+                        addColorTile(colorTile)
+                    }
+                }
+                library.grayScale?.colorTiles.forEach { addColorTile($0) }
+            }
+        }
+        
+        private mutating func addColorTile(_ colorTile: RSDColorTile) {
+            guard let key = RGBAKey(colorTile.color) else { return }
+            colorTiles[key, default: []].append(colorTile)
+        }
+    }
 }
 
 
@@ -0,0 +1,405 @@
+//
+//  RSDColumnarSampleEncoder.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDColumnarSampleEncoder` collects samples into the columns of a `RSDColumnarSampleFormat` block.
+///
+/// Each sample is encoded using a lightweight `Encoder` that writes each top-level value directly into
+/// the column for its coding key. Keys that are not included in the format are ignored. When the block
+/// is full (or the file is closed), the owner calls `encodeBlock()` to get the block data and reset the
+/// columns.
+///
+/// An instance of this class is **not** thread-safe. It is intended to be owned by a single logger.
+internal final class RSDColumnarSampleEncoder {
+    
+    /// The format used to encode the samples.
+    let format: RSDColumnarSampleFormat
+    
+    /// The factory to use when encoding dates and data.
+    let factory: RSDFactory
+    
+    /// The number of rows in the current block.
+    private(set) var rowCount: Int = 0
+    
+    /// Is the current block full?
+    var isBlockFull: Bool {
+        return rowCount >= format.rowsPerBlock
+    }
+    
+    /// The column index for each column name.
+    private let columnIndex: [String : Int]
+    
+    /// The presence bitmap for each column in the current block.
+    private var presence: [[UInt8]]
+    
+    /// The fixed-width values for each column in the current block.
+    private var values: [Data]
+    
+    /// The index of each string that has been added to the string table.
+    private var stringTable: [String : UInt32] = [:]
+    
+    /// The strings that have been added to the string table since the last block was encoded.
+    private var newStrings: [String] = []
+    
+    /// The column values for the row that is currently being encoded.
+    fileprivate var row: [Value?]
+    
+    /// The error to throw once encoding has finished. The `Encoder` protocol does not allow throwing
+    /// when a container is requested, so errors are stored and thrown at the end of encoding the row.
+    fileprivate var pendingError: Error?
+    
+    fileprivate enum Value {
+        case double(Double)
+        case integer(Int64)
+        case string(String)
+    }
+    
+    init(format: RSDColumnarSampleFormat, factory: RSDFactory = RSDFactory.shared) {
+        self.format = format
+        self.factory = factory
+        var columnIndex = [String : Int](minimumCapacity: format.columns.count)
+        for (idx, column) in format.columns.enumerated() where columnIndex[column.name] == nil {
+            columnIndex[column.name] = idx
+        }
+        self.columnIndex = columnIndex
+        self.presence = Array(repeating: [], count: format.columns.count)
+        self.values = format.columns.map {
+            var data = Data()
+            data.reserveCapacity($0.kind.byteWidth * format.rowsPerBlock)
+            return data
+        }
+        self.row = Array(repeating: nil, count: format.columns.count)
+    }
+    
+    /// Add a sample to the current block.
+    /// - parameter value: The sample to add.
+    /// - throws: `EncodingError` if a value cannot be stored in the column for its key.
+    func append(_ value: Encodable) throws {
+        for idx in row.indices {
+            row[idx] = nil
+        }
+        pendingError = nil
+        try value.encode(to: _ColumnarRowEncoder(owner: self))
+        if let error = pendingError {
+            throw error
+        }
+        
+        let byteIndex = rowCount / 8
+        let mask = UInt8(1) << UInt8(rowCount % 8)
+        for (idx, column) in format.columns.enumerated() {
+            if byteIndex == presence[idx].count {
+                presence[idx].append(0)
+            }
+            guard let value = row[idx] else {
+                values[idx].append(contentsOf: [UInt8](repeating: 0, count: column.kind.byteWidth))
+                continue
+            }
+            presence[idx][byteIndex] |= mask
+            switch value {
+            case .double(let num):
+                values[idx].appendLittleEndian(num.bitPattern)
+            case .integer(let num):
+                values[idx].appendLittleEndian(num)
+            case .string(let string):
+                values[idx].appendLittleEndian(stringIndex(for: string))
+            }
+        }
+        rowCount += 1
+    }
+    
+    /// Returns the data for the current block and resets the columns for the next block.
+    func encodeBlock() -> Data {
+        var data = Data()
+        data.appendLittleEndian(UInt32(rowCount))
+        data.appendLittleEndian(UInt32(newStrings.count))
+        for string in newStrings {
+            let stringData = Data(string.utf8)
+            data.appendLittleEndian(UInt32(stringData.count))
+            data.append(stringData)
+        }
+        for idx in format.columns.indices {
+            data.append(contentsOf: presence[idx])
+            data.append(values[idx])
+            presence[idx].removeAll(keepingCapacity: true)
+            values[idx].removeAll(keepingCapacity: true)
+        }
+        newStrings.removeAll()
+        rowCount = 0
+        return data
+    }
+    
+    /// Reset the string table. This should be called after the last block of a file is encoded so that
+    /// the next file includes its own string table.
+    func resetStringTable() {
+        stringTable.removeAll()
+        newStrings.removeAll()
+    }
+    
+    private func stringIndex(for string: String) -> UInt32 {
+        if let index = stringTable[string] {
+            return index
+        }
+        let index = UInt32(stringTable.count)
+        stringTable[string] = index
+        newStrings.append(string)
+        return index
+    }
+    
+    // MARK: Column values
+    
+    fileprivate func column(for key: CodingKey) -> Int? {
+        return columnIndex[key.stringValue]
+    }
+    
+    fileprivate func setValue(_ value: Value, for key: CodingKey) {
+        guard let column = self.column(for: key) else { return }
+        switch (format.columns[column].kind, value) {
+        case (.double, .double), (.integer, .integer), (.string, .string):
+            row[column] = value
+        case (.double, .integer(let num)):
+            row[column] = .double(Double(num))
+        case (.integer, .double(let num)) where num == num.rounded() && abs(num) < 9.2e18:
+            row[column] = .integer(Int64(num))
+        default:
+            let context = EncodingError.Context(codingPath: [key], debugDescription: "The value \(value) cannot be stored in a column of kind \(format.columns[column].kind).")
+            setError(EncodingError.invalidValue(value, context))
+        }
+    }
+    
+    fileprivate func setNestedContainerError(codingPath: [CodingKey]) {
+        let context = EncodingError.Context(codingPath: codingPath, debugDescription: "A columnar encoding cannot encode a nested array or dictionary.")
+        setError(EncodingError.invalidValue(codingPath.map { $0.stringValue }, context))
+    }
+    
+    private func setError(_ error: Error) {
+        if pendingError == nil {
+            pendingError = error
+        }
+    }
+}
+
+// MARK: Encoder
+
+/// The top-level encoder for a single row.
+fileprivate struct _ColumnarRowEncoder : Encoder {
+    let owner: RSDColumnarSampleEncoder
+    
+    var codingPath: [CodingKey] {
+        return []
+    }
+    
+    var userInfo: [CodingUserInfoKey : Any] {
+        return [.factory : owner.factory]
+    }
+    
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key : CodingKey {
+        return KeyedEncodingContainer(_ColumnarKeyedContainer<Key>(owner: owner))
+    }
+    
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        owner.setNestedContainerError(codingPath: [])
+        return _DiscardingColumnarContainer(codingPath: [])
+    }
+    
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        owner.setNestedContainerError(codingPath: [])
+        return _DiscardingColumnarContainer(codingPath: [])
+    }
+}
+
+/// The keyed container for a single row. Values for keys that are included in the format are written to
+/// the matching column. All other values are ignored.
+fileprivate struct _ColumnarKeyedContainer<Key : CodingKey> : KeyedEncodingContainerProtocol {
+    let owner: RSDColumnarSampleEncoder
+    
+    var codingPath: [CodingKey] {
+        return []
+    }
+    
+    mutating func encodeNil(forKey key: Key) throws {
+    }
+    
+    mutating func encode(_ value: Bool, forKey key: Key) throws {
+        owner.setValue(.integer(value ? 1 : 0), for: key)
+    }
+    
+    mutating func encode(_ value: String, forKey key: Key) throws {
+        owner.setValue(.string(value), for: key)
+    }
+    
+    mutating func encode(_ value: Double, forKey key: Key) throws {
+        owner.setValue(.double(value), for: key)
+    }
+    
+    mutating func encode(_ value: Float, forKey key: Key) throws {
+        // Use the shortest representation of the `Float` to match the JSON encoding.
+        owner.setValue(.double(Double(value.description) ?? Double(value)), for: key)
+    }
+    
+    mutating func encode(_ value: Int, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: Int8, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: Int16, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: Int32, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: Int64, forKey key: Key) throws {
+        owner.setValue(.integer(value), for: key)
+    }
+    
+    mutating func encode(_ value: UInt, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(truncatingIfNeeded: value)), for: key)
+    }
+    
+    mutating func encode(_ value: UInt8, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: UInt16, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: UInt32, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(value)), for: key)
+    }
+    
+    mutating func encode(_ value: UInt64, forKey key: Key) throws {
+        owner.setValue(.integer(Int64(truncatingIfNeeded: value)), for: key)
+    }
+    
+    mutating func encode<T>(_ value: T, forKey key: Key) throws where T : Encodable {
+        guard owner.column(for: key) != nil else { return }
+        switch value {
+        case let date as Date:
+            owner.setValue(.string(owner.factory.encodeString(from: date, codingPath: [key])), for: key)
+        case let data as Data:
+            owner.setValue(.string(owner.factory.encodeString(from: data, codingPath: [key])), for: key)
+        case let url as URL:
+            owner.setValue(.string(url.absoluteString), for: key)
+        default:
+            try value.encode(to: _ColumnarValueEncoder(owner: owner, key: key))
+        }
+    }
+    
+    mutating func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> where NestedKey : CodingKey {
+        if owner.column(for: key) != nil {
+            owner.setNestedContainerError(codingPath: [key])
+        }
+        return KeyedEncodingContainer(_DiscardingColumnarKeyedContainer<NestedKey>(codingPath: [key]))
+    }
+    
+    mutating func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        if owner.column(for: key) != nil {
+            owner.setNestedContainerError(codingPath: [key])
+        }
+        return _DiscardingColumnarContainer(codingPath: [key])
+    }
+    
+    mutating func superEncoder() -> Encoder {
+        return _DiscardingColumnarContainer(codingPath: [])
+    }
+    
+    mutating func superEncoder(forKey key: Key) -> Encoder {
+        guard owner.column(for: key) != nil else {
+            return _DiscardingColumnarContainer(codingPath: [key])
+        }
+        return _ColumnarValueEncoder(owner: owner, key: key)
+    }
+}
+
+/// An encoder used to encode a custom `Encodable` value, such as a string enum, into a single column.
+fileprivate struct _ColumnarValueEncoder : Encoder, SingleValueEncodingContainer {
+    let owner: RSDColumnarSampleEncoder
+    let key: CodingKey
+    
+    var codingPath: [CodingKey] {
+        return [key]
+    }
+    
+    var userInfo: [CodingUserInfoKey : Any] {
+        return [.factory : owner.factory]
+    }
+    
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key : CodingKey {
+        owner.setNestedContainerError(codingPath: codingPath)
+        return KeyedEncodingContainer(_DiscardingColumnarKeyedContainer<Key>(codingPath: codingPath))
+    }
+    
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        owner.setNestedContainerError(codingPath: codingPath)
+        return _DiscardingColumnarContainer(codingPath: codingPath)
+    }
+    
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        return self
+    }
+    
+    mutating func encodeNil() throws { }
+    mutating func encode(_ value: Bool) throws { owner.setValue(.integer(value ? 1 : 0), for: key) }
+    mutating func encode(_ value: String) throws { owner.setValue(.string(value), for: key) }
+    mutating func encode(_ value: Double) throws { owner.setValue(.double(value), for: key) }
+    mutating func encode(_ value: Float) throws { owner.setValue(.double(Double(value.description) ?? Double(value)), for: key) }
+    mutating func encode(_ value: Int) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: Int8) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: Int16) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: Int32) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: Int64) throws { owner.setValue(.integer(value), for: key) }
+    mutating func encode(_ value: UInt) throws { owner.setValue(.integer(Int64(truncatingIfNeeded: value)), for: key) }
+    mutating func encode(_ value: UInt8) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: UInt16) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: UInt32) throws { owner.setValue(.integer(Int64(value)), for: key) }
+    mutating func encode(_ value: UInt64) throws { owner.setValue(.integer(Int64(truncatingIfNeeded: value)), for: key) }
+    
+    mutating func encode<T>(_ value: T) throws where T : Encodable {
+        switch value {
+        case let date as Date:
+            owner.setValue(.string(owner.factory.encodeString(from: date, codingPath: codingPath)), for: key)
+        case let data as Data:
+            owner.setValue(.string(owner.factory.encodeString(from: data, codingPath: codingPath)), for: key)
+        case let url as URL:
+            owner.setValue(.string(url.absoluteString), for: key)
+        default:
+            try value.encode(to: self)
+        }
+    }
+}
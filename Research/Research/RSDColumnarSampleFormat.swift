@@ -0,0 +1,145 @@
+//
+//  RSDColumnarSampleFormat.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDColumnarSampleFormat` describes a compact binary file format that can be used by a
+/// `RSDRecordSampleLogger` to write samples as columns of fixed-width values rather than as JSON or
+/// delimiter-separated text.
+///
+/// The file is self-describing and all the numbers are written in little-endian byte order. The file
+/// begins with a header:
+///
+/// - The 4 byte magic string "RSDC".
+/// - `UInt16` version of the file format.
+/// - `UInt16` number of columns.
+/// - For each column, a `UInt8` value kind, a `UInt16` byte length, and the UTF-8 encoded column name.
+///
+/// The header is followed by blocks of samples. Each block includes:
+///
+/// - `UInt32` number of rows in the block.
+/// - `UInt32` number of strings added to the string table by this block, followed by each string as a
+///   `UInt32` byte length and the UTF-8 encoded string. Strings are interned for the whole file and are
+///   assigned an index in the order in which they are added.
+/// - For each column, a presence bitmap with one bit per row (least significant bit first) followed by
+///   the value for each row. Doubles and integers are written as 8 byte values and strings are written
+///   as the `UInt32` index into the string table. The value for a row that is not present is zero.
+///
+/// - seealso: `RSDColumnarSampleReader`
+public struct RSDColumnarSampleFormat : Equatable {
+    
+    /// The version of the file format written by this version of the framework.
+    public static let currentVersion: UInt16 = 1
+    
+    /// The magic bytes at the start of the file.
+    static let magic: [UInt8] = Array("RSDC".utf8)
+    
+    /// The kind of value stored in a column.
+    public enum ValueKind : UInt8 {
+        
+        /// A 64-bit floating point number.
+        case double = 1
+        
+        /// A 64-bit signed integer.
+        case integer = 2
+        
+        /// A string that is interned in the string table. Dates and string enums are stored as strings
+        /// using the same encoding as the JSON file.
+        case string = 3
+        
+        /// The number of bytes used to store each value.
+        var byteWidth: Int {
+            return (self == .string) ? 4 : 8
+        }
+    }
+    
+    /// A column in the table.
+    public struct Column : Equatable {
+        
+        /// The name of the column. This is the coding key used to encode the sample.
+        public let name: String
+        
+        /// The kind of value stored in the column.
+        public let kind: ValueKind
+        
+        public init(_ name: String, _ kind: ValueKind) {
+            self.name = name
+            self.kind = kind
+        }
+    }
+    
+    /// The ordered list of columns.
+    public let columns: [Column]
+    
+    /// The maximum number of rows to include in each block.
+    public var rowsPerBlock: Int = 1024
+    
+    /// Returns "application/octet-stream".
+    public var contentType: String {
+        return "application/octet-stream"
+    }
+    
+    /// Returns "rsdc".
+    public var fileExtension: String {
+        return "rsdc"
+    }
+    
+    /// Default initializer.
+    /// - parameter columns: The ordered list of columns.
+    public init(columns: [Column]) {
+        self.columns = columns
+    }
+    
+    /// The file header for this format.
+    func headerData() -> Data {
+        var data = Data(RSDColumnarSampleFormat.magic)
+        data.appendLittleEndian(RSDColumnarSampleFormat.currentVersion)
+        data.appendLittleEndian(UInt16(columns.count))
+        for column in columns {
+            let name = Data(column.name.utf8)
+            data.append(column.kind.rawValue)
+            data.appendLittleEndian(UInt16(name.count))
+            data.append(name)
+        }
+        return data
+    }
+}
+
+extension Data {
+    
+    /// Append the little-endian bytes of the given integer.
+    mutating func appendLittleEndian<T : FixedWidthInteger>(_ value: T) {
+        var littleEndian = value.littleEndian
+        Swift.withUnsafeBytes(of: &littleEndian) { self.append(contentsOf: $0) }
+    }
+}
@@ -0,0 +1,414 @@
+//
+//  RSDColumnarSampleReader.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDColumnarSampleReader` reads a file that was written using a `RSDColumnarSampleFormat` and can
+/// export the samples to the same JSON or delimiter-separated files that would have been written by a
+/// `RSDRecordSampleLogger` so that tools that process those files are not affected by the binary format.
+///
+/// The reader only depends upon Foundation and can be used on any platform.
+///
+/// - example:
+///
+/// ```
+///     // Convert a binary file into a comma-separated file.
+///     let reader = try RSDColumnarSampleReader(contentsOf: binaryURL)
+///     try reader.export(to: csvURL, stringEncodingFormat: reader.delimitedEncodingFormat())
+/// ```
+public final class RSDColumnarSampleReader {
+    
+    /// Errors that can be thrown by the reader.
+    public enum ReaderError : Error {
+        
+        /// The file does not start with a valid header.
+        case invalidHeader
+        
+        /// The file was written using a newer version of the format.
+        case unsupportedVersion(UInt16)
+        
+        /// The header includes a column with an unknown value kind.
+        case unknownValueKind(UInt8)
+        
+        /// A string value references a string that is not in the string table.
+        case invalidStringIndex(UInt32)
+    }
+    
+    /// A value stored in a column.
+    public enum Value : Equatable {
+        case double(Double)
+        case integer(Int64)
+        case string(String)
+    }
+    
+    /// The version of the format used to write the file.
+    public let version: UInt16
+    
+    /// The format of the file.
+    public let format: RSDColumnarSampleFormat
+    
+    /// The samples read from the file.
+    public let rows: [Row]
+    
+    /// Whether or not the file ends with an incomplete block. This can happen if the app was terminated
+    /// before the logger was closed. The rows from the complete blocks are still included.
+    public let isTruncated: Bool
+    
+    /// Read the file at the given URL.
+    /// - parameter url: The file URL.
+    public convenience init(contentsOf url: URL) throws {
+        try self.init(data: Data(contentsOf: url, options: .mappedIfSafe))
+    }
+    
+    /// Read the given data.
+    /// - parameter data: The data for the file.
+    public init(data: Data) throws {
+        // Read the bytes in place so that a memory-mapped file is not copied.
+        let (version, format, rows, isTruncated) = try data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+            try RSDColumnarSampleReader.read(bytes)
+        }
+        self.version = version
+        self.format = format
+        self.rows = rows
+        self.isTruncated = isTruncated
+    }
+    
+    /// Read the file from the given bytes.
+    private static func read(_ bytes: UnsafeRawBufferPointer) throws -> (version: UInt16, format: RSDColumnarSampleFormat, rows: [Row], isTruncated: Bool) {
+        var scanner = _ByteScanner(bytes: bytes)
+        
+        // Read the header.
+        guard let magic = scanner.readBytes(RSDColumnarSampleFormat.magic.count),
+            Array(magic) == RSDColumnarSampleFormat.magic,
+            let version = scanner.readUInt16(),
+            let columnCount = scanner.readUInt16()
+            else {
+                throw ReaderError.invalidHeader
+        }
+        guard version <= RSDColumnarSampleFormat.currentVersion else {
+            throw ReaderError.unsupportedVersion(version)
+        }
+        var columns: [RSDColumnarSampleFormat.Column] = []
+        for _ in 0..<Int(columnCount) {
+            guard let rawKind = scanner.readUInt8(),
+                let nameLength = scanner.readUInt16(),
+                let nameBytes = scanner.readBytes(Int(nameLength)),
+                let name = String(bytes: nameBytes, encoding: .utf8)
+                else {
+                    throw ReaderError.invalidHeader
+            }
+            guard let kind = RSDColumnarSampleFormat.ValueKind(rawValue: rawKind) else {
+                throw ReaderError.unknownValueKind(rawKind)
+            }
+            columns.append(RSDColumnarSampleFormat.Column(name, kind))
+        }
+        let format = RSDColumnarSampleFormat(columns: columns)
+        
+        // Read the blocks.
+        var strings: [String] = []
+        var rows: [Row] = []
+        var isTruncated = false
+        while !scanner.isAtEnd {
+            guard let blockRows = try RSDColumnarSampleReader.readBlock(&scanner, format: format, strings: &strings) else {
+                isTruncated = true
+                break
+            }
+            rows.append(contentsOf: blockRows)
+        }
+        
+        return (version, format, rows, isTruncated)
+    }
+    
+    /// Read a block. Returns `nil` if the block is incomplete.
+    private static func readBlock(_ scanner: inout _ByteScanner, format: RSDColumnarSampleFormat, strings: inout [String]) throws -> [Row]? {
+        guard let rowCount = scanner.readUInt32().map({ Int($0) }),
+            let stringCount = scanner.readUInt32()
+            else {
+                return nil
+        }
+        var newStrings: [String] = []
+        for _ in 0..<Int(stringCount) {
+            guard let length = scanner.readUInt32(),
+                let bytes = scanner.readBytes(Int(length))
+                else {
+                    return nil
+            }
+            newStrings.append(String(decoding: bytes, as: UTF8.self))
+        }
+        
+        var values = Array(repeating: [Value?](repeating: nil, count: format.columns.count), count: rowCount)
+        let bitmapLength = (rowCount + 7) / 8
+        for (col, column) in format.columns.enumerated() {
+            guard let bitmap = scanner.readBytes(bitmapLength) else { return nil }
+            for row in 0..<rowCount {
+                let isPresent = (bitmap[row / 8] & (UInt8(1) << UInt8(row % 8))) != 0
+                switch column.kind {
+                case .double:
+                    guard let bits = scanner.readUInt64() else { return nil }
+                    if isPresent {
+                        values[row][col] = .double(Double(bitPattern: bits))
+                    }
+                case .integer:
+                    guard let bits = scanner.readUInt64() else { return nil }
+                    if isPresent {
+                        values[row][col] = .integer(Int64(bitPattern: bits))
+                    }
+                case .string:
+                    guard let index = scanner.readUInt32() else { return nil }
+                    if isPresent {
+                        let idx = Int(index)
+                        if idx < strings.count {
+                            values[row][col] = .string(strings[idx])
+                        }
+                        else if idx - strings.count < newStrings.count {
+                            values[row][col] = .string(newStrings[idx - strings.count])
+                        }
+                        else {
+                            throw ReaderError.invalidStringIndex(index)
+                        }
+                    }
+                }
+            }
+        }
+        
+        strings.append(contentsOf: newStrings)
+        return values.map { Row(format: format, values: $0) }
+    }
+    
+    // MARK: Export
+    
+    /// Returns a delimiter-separated encoding format with the columns from this file. This format can be
+    /// used to export the samples as a comma-separated file.
+    /// - parameter includesHeader: Should the file include a header?
+    public func delimitedEncodingFormat(includesHeader: Bool = true) -> RSDStringSeparatedEncodingFormat {
+        return DelimitedEncodingFormat(columns: format.columns.map { $0.name }, includesHeader: includesHeader)
+    }
+    
+    /// Write the samples to a file. The file is written using a `RSDRecordSampleLogger` so that it is
+    /// formatted in the same way as a file that was written by a recorder using the same settings.
+    ///
+    /// - parameters:
+    ///     - url: The file URL to write the samples to.
+    ///     - stringEncodingFormat: The string encoding format to use, or `nil` to use JSON.
+    ///     - jsonOutputFormat: The output format to use if the samples are encoded as JSON.
+    ///     - usesRootDictionary: Is the root element in the json file a dictionary?
+    public func export(to url: URL, stringEncodingFormat: RSDStringSeparatedEncodingFormat? = nil, jsonOutputFormat: RSDJSONOutputFormat = .prettyPrinted, usesRootDictionary: Bool = false) throws {
+        let identifier = url.deletingPathExtension().lastPathComponent
+        let logger = try RSDRecordSampleLogger(identifier: identifier, url: url, usesRootDictionary: usesRootDictionary, stringEncodingFormat: stringEncodingFormat, jsonOutputFormat: jsonOutputFormat)
+        var writeError: Error?
+        do {
+            try logger.writeSamples(rows)
+        } catch let err {
+            writeError = err
+        }
+        try logger.close()
+        if let error = writeError {
+            throw error
+        }
+    }
+    
+    /// Convert a binary file into a JSON or delimiter-separated file.
+    ///
+    /// - parameters:
+    ///     - sourceURL: The file URL for the binary file.
+    ///     - destinationURL: The file URL to write the samples to. If the path extension is "csv", then the
+    ///                       samples are written as a comma-separated file. Otherwise, they are written as
+    ///                       JSON.
+    ///     - jsonOutputFormat: The output format to use if the samples are encoded as JSON.
+    public static func export(contentsOf sourceURL: URL, to destinationURL: URL, jsonOutputFormat: RSDJSONOutputFormat = .prettyPrinted) throws {
+        let reader = try RSDColumnarSampleReader(contentsOf: sourceURL)
+        let stringEncodingFormat = (destinationURL.pathExtension == "csv") ? reader.delimitedEncodingFormat() : nil
+        try reader.export(to: destinationURL, stringEncodingFormat: stringEncodingFormat, jsonOutputFormat: jsonOutputFormat)
+    }
+    
+    // MARK: Row
+    
+    /// A single sample read from a binary file. The sample is encoded with the values that are present in
+    /// the order of the columns.
+    public struct Row : RSDSampleRecord {
+        
+        /// The format of the file that included this row.
+        public let format: RSDColumnarSampleFormat
+        
+        /// The value for each column.
+        public let values: [Value?]
+        
+        init(format: RSDColumnarSampleFormat, values: [Value?]) {
+            self.format = format
+            self.values = values
+        }
+        
+        /// Returns the value for the column with the given name.
+        public subscript(name: String) -> Value? {
+            guard let idx = format.columns.firstIndex(where: { $0.name == name }) else { return nil }
+            return values[idx]
+        }
+        
+        /// The "stepPath" column.
+        public var stepPath: String {
+            guard case .string(let stepPath)? = self["stepPath"] else { return "" }
+            return stepPath
+        }
+        
+        /// The "timestampDate" column.
+        public var timestampDate: Date? {
+            guard case .string(let string)? = self["timestampDate"] else { return nil }
+            return RSDFactory.shared.decodeDate(from: string)
+        }
+        
+        /// The "timestamp" column.
+        public var timestamp: TimeInterval? {
+            switch self["timestamp"] {
+            case .double(let num)?:
+                return num
+            case .integer(let num)?:
+                return TimeInterval(num)
+            default:
+                return nil
+            }
+        }
+        
+        /// Decode a row from a dictionary. The columns are ordered by key.
+        public init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: AnyCodingKey.self)
+            var columns: [RSDColumnarSampleFormat.Column] = []
+            var values: [Value?] = []
+            for key in container.allKeys.sorted(by: { $0.stringValue < $1.stringValue }) {
+                if let string = try? container.decode(String.self, forKey: key) {
+                    columns.append(RSDColumnarSampleFormat.Column(key.stringValue, .string))
+                    values.append(.string(string))
+                }
+                else if let num = try? container.decode(Int64.self, forKey: key) {
+                    columns.append(RSDColumnarSampleFormat.Column(key.stringValue, .integer))
+                    values.append(.integer(num))
+                }
+                else if let num = try? container.decode(Double.self, forKey: key) {
+                    columns.append(RSDColumnarSampleFormat.Column(key.stringValue, .double))
+                    values.append(.double(num))
+                }
+            }
+            self.format = RSDColumnarSampleFormat(columns: columns)
+            self.values = values
+        }
+        
+        public func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: AnyCodingKey.self)
+            for (column, value) in zip(format.columns, values) {
+                guard let value = value, let key = AnyCodingKey(stringValue: column.name) else { continue }
+                switch value {
+                case .double(let num):
+                    try container.encode(num, forKey: key)
+                case .integer(let num):
+                    try container.encode(num, forKey: key)
+                case .string(let string):
+                    try container.encode(string, forKey: key)
+                }
+            }
+        }
+    }
+    
+    /// The delimiter-separated encoding format used to export the samples.
+    fileprivate struct DelimitedEncodingFormat : RSDStringSeparatedEncodingFormat {
+        let columns: [String]
+        let includesHeader: Bool
+        
+        var encodingSeparator: String {
+            return ","
+        }
+        
+        var contentType: String {
+            return "text/csv"
+        }
+        
+        var fileExtension: String {
+            return "csv"
+        }
+        
+        func fileTableHeader() -> String {
+            return includesHeader ? columns.joined(separator: encodingSeparator) : ""
+        }
+        
+        func codingKeys() -> [CodingKey] {
+            return columns.compactMap { AnyCodingKey(stringValue: $0) }
+        }
+    }
+}
+
+/// A scanner used to read little-endian values from a byte buffer. The buffer is only valid for the life
+/// of the scanner.
+fileprivate struct _ByteScanner {
+    let bytes: UnsafeRawBufferPointer
+    var offset: Int = 0
+    
+    init(bytes: UnsafeRawBufferPointer) {
+        self.bytes = bytes
+    }
+    
+    var isAtEnd: Bool {
+        return offset >= bytes.count
+    }
+    
+    /// Returns the next `count` bytes. The returned buffer is indexed from zero.
+    mutating func readBytes(_ count: Int) -> UnsafeRawBufferPointer? {
+        guard count >= 0, offset + count <= bytes.count else { return nil }
+        defer { offset += count }
+        return UnsafeRawBufferPointer(rebasing: bytes[offset..<(offset + count)])
+    }
+    
+    mutating func readUInt8() -> UInt8? {
+        return readInteger(UInt8.self)
+    }
+    
+    mutating func readUInt16() -> UInt16? {
+        return readInteger(UInt16.self)
+    }
+    
+    mutating func readUInt32() -> UInt32? {
+        return readInteger(UInt32.self)
+    }
+    
+    mutating func readUInt64() -> UInt64? {
+        return readInteger(UInt64.self)
+    }
+    
+    private mutating func readInteger<T : FixedWidthInteger & UnsignedInteger>(_ type: T.Type) -> T? {
+        let size = MemoryLayout<T>.size
+        guard offset + size <= bytes.count else { return nil }
+        var value: T = 0
+        for ii in 0..<size {
+            value |= T(bytes[offset + ii]) << (8 * ii)
+        }
+        offset += size
+        return value
+    }
+}
@@ -76,16 +76,34 @@ extension RSDComparable {
             return false
         }
         
-        guard let predicate = rulePredicate(with: answerResult.answerType, op: op),
-            let cValue = convertValue(for: value, with: answerResult.answerType)
-            else {
-                return false
-        }
-        
-        if predicate.evaluate(with: cValue) {
-            return true
+        return compiledRule(with: answerResult.answerType, op: op).evaluate(value)
+    }
+    
+    /// Returns the compiled rule for the given answer type and operator. If this comparable caches the
+    /// compiled rule, then the rule is only compiled on first use.
+    func compiledRule(with answerType: RSDAnswerResultType, op: RSDSurveyRuleOperator) -> RSDCompiledComparableRule {
+        if let cache = (self as? RSDComparableRuleCaching)?.compiledRuleCache {
+            return cache.rule(for: answerType, op: op) {
+                compileRule(with: answerType, op: op)
+            }
         } else {
-            return false
+            return compileRule(with: answerType, op: op)
+        }
+    }
+    
+    /// Compile the rule for the given answer type and operator. A typed comparison is used if the answer
+    /// type is supported, otherwise this falls back to evaluating an `NSPredicate`.
+    func compileRule(with answerType: RSDAnswerResultType, op: RSDSurveyRuleOperator) -> RSDCompiledComparableRule {
+        let accuracy = (self as? RSDDecimalComparable)?.accuracy
+        if let rule = RSDCompiledComparableRule.compile(matchingAnswer: matchingAnswer, answerType: answerType, op: op, accuracy: accuracy) {
+            return rule
+        }
+        guard let predicate = rulePredicate(with: answerType, op: op) else {
+            return RSDCompiledComparableRule(constant: false)
+        }
+        return RSDCompiledComparableRule(usesPredicate: true) { (value) -> Bool in
+            guard let cValue = self.convertValue(for: value, with: answerType) else { return false }
+            return predicate.evaluate(with: cValue)
         }
     }
     
@@ -0,0 +1,268 @@
+//
+//  RSDComparableRule.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDCompiledComparableRule` is a survey rule comparison that has been compiled for a given answer type
+/// and operator.
+///
+/// Compiling the rule converts the `matchingAnswer` once and selects a typed comparison for the answer
+/// type. Evaluating the rule then only requires converting the answer value. This replaces building and
+/// parsing an `NSPredicate` format string for each evaluation. An `NSPredicate` is still used as a fallback
+/// for answer types that are not supported by the typed comparisons.
+///
+/// - seealso: `RSDComparable.isMatching(to:op:)`
+struct RSDCompiledComparableRule {
+    
+    /// Evaluate the rule for the given (non-nil) answer value.
+    let evaluate: (Any) -> Bool
+    
+    /// Is the rule evaluated using an `NSPredicate`?
+    let usesPredicate: Bool
+    
+    /// A rule that always evaluates to the given value.
+    init(constant: Bool) {
+        self.evaluate = { _ in constant }
+        self.usesPredicate = false
+    }
+    
+    init(usesPredicate: Bool, evaluate: @escaping (Any) -> Bool) {
+        self.evaluate = evaluate
+        self.usesPredicate = usesPredicate
+    }
+    
+    /// Compile a typed comparison. Returns `nil` if the answer type or operator is not supported.
+    static func compile(matchingAnswer: Any?, answerType: RSDAnswerResultType, op: RSDSurveyRuleOperator, accuracy: Decimal?) -> RSDCompiledComparableRule? {
+        
+        switch op {
+        case .always:
+            return RSDCompiledComparableRule(constant: true)
+        case .skip:
+            // The answer value is non-nil so `SELF = NULL` evaluates to false.
+            return RSDCompiledComparableRule(constant: false)
+        default:
+            break
+        }
+        
+        let baseType = answerType.baseType
+        guard baseType != .codable, baseType != .data else { return nil }
+        
+        if let sequenceType = answerType.sequenceType {
+            guard sequenceType == .array else { return nil }
+            return compileArray(matchingAnswer: matchingAnswer, baseType: baseType, op: op)
+        }
+        
+        // If the matching answer cannot be converted then the rule does not match.
+        guard let expected = RSDComparableValue(matchingAnswer, baseType: baseType) else {
+            return RSDCompiledComparableRule(constant: false)
+        }
+        
+        // Decimal equality is a range check using the accuracy.
+        if op == .equal, baseType == .decimal, case .number(let num) = expected {
+            let epsilon = accuracy ?? Decimal(0.00001)
+            let decimal = num.decimalValue
+            let min = (decimal - epsilon) as NSDecimalNumber
+            let max = (decimal + epsilon) as NSDecimalNumber
+            return RSDCompiledComparableRule(usesPredicate: false) { (value) -> Bool in
+                guard let answer = RSDComparableValue.number(from: value) else { return false }
+                return answer.compare(min) != .orderedAscending && answer.compare(max) != .orderedDescending
+            }
+        }
+        
+        let test: (ComparisonResult) -> Bool
+        switch op {
+        case .equal:
+            test = { $0 == .orderedSame }
+        case .notEqual, .otherThan:
+            test = { $0 != .orderedSame }
+        case .greaterThan:
+            test = { $0 == .orderedDescending }
+        case .greaterThanEqual:
+            test = { $0 != .orderedAscending }
+        case .lessThan:
+            test = { $0 == .orderedAscending }
+        case .lessThanEqual:
+            test = { $0 != .orderedDescending }
+        default:
+            return nil
+        }
+        
+        return RSDCompiledComparableRule(usesPredicate: false) { (value) -> Bool in
+            guard let answer = RSDComparableValue(value, baseType: baseType),
+                let result = answer.compare(to: expected)
+                else {
+                    return false
+            }
+            return test(result)
+        }
+    }
+    
+    private static func compileArray(matchingAnswer: Any?, baseType: RSDAnswerResultType.BaseType, op: RSDSurveyRuleOperator) -> RSDCompiledComparableRule? {
+        
+        guard let expected = RSDComparableValue.array(from: matchingAnswer, baseType: baseType) else {
+            return RSDCompiledComparableRule(constant: false)
+        }
+        
+        switch op {
+        case .equal, .otherThan:
+            // `ANY expected IN SELF`
+            let isEqual = (op == .equal)
+            return RSDCompiledComparableRule(usesPredicate: false) { (value) -> Bool in
+                guard let answer = RSDComparableValue.array(from: value, baseType: baseType) else { return false }
+                let containsAny = expected.contains { (expectedValue) in
+                    answer.contains { $0.isEqual(to: expectedValue) }
+                }
+                return containsAny == isEqual
+            }
+            
+        case .notEqual:
+            // `SELF <> expected` where the arrays are compared element-wise.
+            return RSDCompiledComparableRule(usesPredicate: false) { (value) -> Bool in
+                guard let answer = RSDComparableValue.array(from: value, baseType: baseType) else { return false }
+                guard answer.count == expected.count else { return true }
+                return zip(answer, expected).contains { !$0.isEqual(to: $1) }
+            }
+            
+        default:
+            // Ordering an array is not supported by the typed comparisons.
+            return nil
+        }
+    }
+}
+
+/// A value that is normalized for comparison by a compiled survey rule. The conversion matches the
+/// conversion used to build the arguments for the `NSPredicate` fallback.
+enum RSDComparableValue {
+    case string(NSString)
+    case number(NSNumber)
+    case date(Date)
+    
+    init?(_ value: Any?, baseType: RSDAnswerResultType.BaseType) {
+        guard let value = value else { return nil }
+        switch baseType {
+        case .string:
+            if let comparableValue = value as? CustomStringConvertible {
+                self = .string(comparableValue.description as NSString)
+            } else {
+                self = .string("\(value)" as NSString)
+            }
+        case .date:
+            if let date = value as? Date {
+                self = .date(date)
+            } else if let dateString = value as? String,
+                let date = RSDFactory.shared.decodeDate(from: dateString) {
+                self = .date(date)
+            } else {
+                return nil
+            }
+        case .data:
+            return nil
+        default:
+            guard let num = RSDComparableValue.number(from: value) else { return nil }
+            self = .number(num)
+        }
+    }
+    
+    static func number(from value: Any?) -> NSNumber? {
+        return (value as? NSNumber) ?? (value as? RSDJSONNumber)?.jsonNumber()
+    }
+    
+    static func array(from value: Any?, baseType: RSDAnswerResultType.BaseType) -> [RSDComparableValue]? {
+        guard let value = value else { return nil }
+        let array = value as? [Any] ?? [value]
+        var ret = [RSDComparableValue]()
+        ret.reserveCapacity(array.count)
+        for element in array {
+            guard let converted = RSDComparableValue(element, baseType: baseType) else { return nil }
+            ret.append(converted)
+        }
+        return ret
+    }
+    
+    /// Compare to another value of the same type. Returns `nil` if the values are different types.
+    func compare(to other: RSDComparableValue) -> ComparisonResult? {
+        switch (self, other) {
+        case (.string(let lhs), .string(let rhs)):
+            return lhs.compare(rhs as String)
+        case (.number(let lhs), .number(let rhs)):
+            return lhs.compare(rhs)
+        case (.date(let lhs), .date(let rhs)):
+            return lhs.compare(rhs)
+        default:
+            return nil
+        }
+    }
+    
+    /// Equality using `isEqual()` to match `NSPredicate` "IN" evaluation.
+    func isEqual(to other: RSDComparableValue) -> Bool {
+        switch (self, other) {
+        case (.string(let lhs), .string(let rhs)):
+            return lhs.isEqual(to: rhs as String)
+        case (.number(let lhs), .number(let rhs)):
+            return lhs.isEqual(to: rhs)
+        case (.date(let lhs), .date(let rhs)):
+            return lhs == rhs
+        default:
+            return false
+        }
+    }
+}
+
+/// `RSDComparableRuleCache` is used by a comparable to store the rule compiled for the most recent
+/// answer type and operator.
+final class RSDComparableRuleCache {
+    
+    private let lock = NSLock()
+    private var answerType: RSDAnswerResultType?
+    private var op: RSDSurveyRuleOperator?
+    private var rule: RSDCompiledComparableRule?
+    
+    /// Returns the cached rule for the given answer type and operator, compiling the rule if needed.
+    func rule(for answerType: RSDAnswerResultType, op: RSDSurveyRuleOperator, compile: () -> RSDCompiledComparableRule) -> RSDCompiledComparableRule {
+        lock.lock()
+        defer { lock.unlock() }
+        if let rule = self.rule, self.op == op, self.answerType == answerType {
+            return rule
+        }
+        let rule = compile()
+        self.answerType = answerType
+        self.op = op
+        self.rule = rule
+        return rule
+    }
+}
+
+/// A comparable that caches the compiled rule.
+protocol RSDComparableRuleCaching : RSDComparable {
+    var compiledRuleCache: RSDComparableRuleCache { get }
+}
@@ -62,6 +62,9 @@ public struct RSDComparableSurveyRuleObject<T : Codable> : RSDComparableSurveyRu
     // Value-typed matching answer.
     public let matchingValue: Value?
     
+    /// The rule compiled on first use.
+    let compiledRuleCache = RSDComparableRuleCache()
+    
     /// Default initializer.
     ///
     /// - parameters:
@@ -102,6 +105,9 @@ public struct RSDComparableSurveyRuleObject<T : Codable> : RSDComparableSurveyRu
     }
 }
 
+extension RSDComparableSurveyRuleObject : RSDComparableRuleCaching {
+}
+
 extension RSDComparableSurveyRuleObject : RSDDocumentableDecodableObject {
     
     static func codingKeys() -> [CodingKey] {
@@ -43,7 +43,17 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
     public let steps : [RSDStep]
     
     /// A list of step markers to use for calculating progress.
-    public var progressMarkers : [String]?
+    public var progressMarkers : [String]? {
+        didSet {
+            _stepNavigatorIndex.setProgressMarkers(progressMarkers)
+        }
+    }
+    
+    /// The index of the steps. This is built once when the navigator is initialized.
+    public var stepNavigatorIndex: RSDStepNavigatorIndex? {
+        return _stepNavigatorIndex
+    }
+    private var _stepNavigatorIndex: RSDStepNavigatorIndex
     
     /// The identifier of the step **after** which any sections or subtasks should be inserted.
     public var insertAfterIdentifier: String?
@@ -52,6 +62,12 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
     /// - parameter steps: An ordered list of steps to run for this task.
     public init(with steps: [RSDStep]) {
         self.steps = steps
+        self._stepNavigatorIndex = RSDStepNavigatorIndex(steps: steps)
+    }
+    
+    private init(with steps: [RSDStep], stepNavigatorIndex: RSDStepNavigatorIndex) {
+        self.steps = steps
+        self._stepNavigatorIndex = stepNavigatorIndex
     }
     
     /// Return a copy of the step navigator that includes the desired section inserted in a position that
@@ -74,7 +90,8 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
         steps.insert(step, at: idx)
     
         // Create the navigator.
-        var navigator = RSDConditionalStepNavigatorObject(with: steps)
+        var navigator = RSDConditionalStepNavigatorObject(with: steps,
+                                                          stepNavigatorIndex: _stepNavigatorIndex.inserting(step, at: idx, progressMarkers: nil))
         navigator.insertAfterIdentifier = step.identifier
         
         // Mutate the progress markers.
@@ -96,8 +113,10 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
     }
     
     public func copyAndRemove(_ stepIdentifiers: [String]) -> RSDConditionalStepNavigatorObject {
-        let steps = self.steps.filter { !stepIdentifiers.contains($0.identifier) }
-        var navigator = RSDConditionalStepNavigatorObject(with: steps)
+        let identifiers = Set(stepIdentifiers)
+        let steps = self.steps.filter { !identifiers.contains($0.identifier) }
+        let stepNavigatorIndex = _stepNavigatorIndex.removing(identifiers, progressMarkers: nil)
+        var navigator = RSDConditionalStepNavigatorObject(with: steps, stepNavigatorIndex: stepNavigatorIndex)
         navigator.progressMarkers = self.progressMarkers?.filter { !stepIdentifiers.contains($0) }
         navigator.insertAfterIdentifier = self.insertAfterIdentifier
         return navigator
@@ -106,7 +125,7 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
     /// Find the index of the step with the given identifier.
     public func index(of identifier: String?) -> Int? {
         guard let identifier = identifier else { return nil }
-        return self.steps.firstIndex(where: { $0.identifier == identifier })
+        return _stepNavigatorIndex.index(of: identifier)
     }
     
     /// Initialize from a `Decoder`. This decoding method will use the `RSDFactory` instance associated
@@ -145,10 +164,13 @@ public struct RSDConditionalStepNavigatorObject : RSDConditionalStepNavigator, R
         
         // Decode the steps
         let stepsContainer = try container.nestedUnkeyedContainer(forKey: .steps)
-        self.steps = try factory.decodeSteps(from: stepsContainer)
+        let steps = try factory.decodeSteps(from: stepsContainer)
+        self.steps = steps
         
         // Decode the markers
-        self.progressMarkers = try container.decodeIfPresent([String].self, forKey: .progressMarkers)
+        let progressMarkers = try container.decodeIfPresent([String].self, forKey: .progressMarkers)
+        self.progressMarkers = progressMarkers
+        self._stepNavigatorIndex = RSDStepNavigatorIndex(steps: steps, progressMarkers: progressMarkers)
     }
 }
 
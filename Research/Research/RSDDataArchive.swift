@@ -53,6 +53,10 @@ public protocol RSDDataArchive : class, NSObjectProtocol {
     func shouldInsertData(for filename: RSDReservedFilename) -> Bool
     
     /// Method for adding data to an archive.
+    ///
+    /// If the `manifest` includes a `contentEncoding`, then the data is already compressed and should be
+    /// stored in the archive without compressing it again.
+    ///
     /// - parameters:
     ///     - data: The data to insert.
     ///     - manifest: The file manifest for this data.
@@ -80,6 +84,20 @@ public protocol RSDArchivable {
     func buildArchiveData(at stepPath: String?) throws -> (manifest: RSDFileManifest, data: Data)?
 }
 
+/// A data archive that can remove data that was inserted into it. If the archive that is vended by the
+/// `RSDDataArchiveManager` conforms to this protocol and the task results are archived incrementally, then the
+/// data for each step result is inserted into the archive when the step is completed, and it is removed if the
+/// step result is replaced.
+///
+/// - note: The staged data is inserted in the order that the steps are completed, which may differ from the
+///         order of the step history if the participant navigates back to a previous step.
+public protocol RSDIncrementalDataArchive : RSDDataArchive {
+    
+    /// Remove the data that was inserted into the archive with the given manifest.
+    /// - parameter manifest: The file manifest used to insert the data.
+    func removeDataFromArchive(with manifest: RSDFileManifest) throws
+}
+
 extension RSDArchivable {
     
     /// Convenience method for calling `buildArchiveData()` without a step path.
@@ -91,13 +109,40 @@ extension RSDArchivable {
 internal class TaskArchiver : NSObject {
     
     let manager: RSDDataArchiveManager
-    let taskResult: RSDTaskResult
     let archive: RSDDataArchive?
     
+    /// The task result to archive. When results are staged as the task runs, this is replaced with the final
+    /// task result before the archives are built.
+    var taskResult: RSDTaskResult
+    
     fileprivate var childArchives: [RSDDataArchive] = []
     fileprivate var files: Set<RSDFileManifest> = []
     fileprivate var answerMap: [String : AnswerResultWrapper] = [:]
     
+    /// The step results that were added to the archive before the task finished, keyed by the step
+    /// identifier.
+    fileprivate var stagedSteps: [String : StagedStepResult] = [:]
+    
+    /// The maximum number of child archives and archivable results to build at the same time. If `1`, then
+    /// the archives are built serially.
+    var maxConcurrentOperationCount: Int = 1
+    
+    /// The work planned for the worker pool, in the order that the results are visited when they are added
+    /// to the archive.
+    fileprivate var plannedWork: [PlannedWork]?
+    fileprivate var plannedWorkIndex: Int = 0
+    
+    /// The worker pool and the index of the next planned work to start on it.
+    fileprivate var workQueue: OperationQueue?
+    fileprivate var startedWorkIndex: Int = 0
+    
+    /// The number of operations that have been started but whose results have not been added to the
+    /// archive.
+    fileprivate var pendingOperationCount: Int = 0
+    
+    /// The encoding session used to encode the answers and task result for this archive.
+    fileprivate lazy var encodingSession = RSDFactory.shared.createEncodingSession()
+    
     init(manager: RSDDataArchiveManager, taskResult: RSDTaskResult, scheduleIdentifier: String?) {
         self.archive = manager.dataArchiver(for: taskResult, scheduleIdentifier: scheduleIdentifier, currentArchive: nil)
         self.taskResult = taskResult
@@ -119,8 +164,37 @@ internal class TaskArchiver : NSObject {
     
     func buildArchives() throws -> [RSDDataArchive] {
         
+        // Match the step results to the staged results that have not changed since they were staged, and
+        // discard the staged data for any results that are not included in the final task result.
+        let stepResults = taskResult.stepHistory.map { (result) -> (RSDResult, StagedStepResult?) in
+            guard let staged = stagedSteps.removeValue(forKey: result.identifier) else { return (result, nil) }
+            guard staged.changeToken == stepHistoryChangeToken(for: result.identifier) else {
+                discardStagedStep(staged)
+                return (result, nil)
+            }
+            return (result, staged)
+        }
+        discardAllStagedData()
+        
+        // If building concurrently, then start building the child archives and archivable data.
+        if maxConcurrentOperationCount > 1 {
+            buildConcurrently(stepResults.compactMap { $0.1 == nil ? $0.0 : nil })
+        }
+        defer {
+            workQueue?.cancelAllOperations()
+            workQueue = nil
+            plannedWork = nil
+        }
+        
         // recursively add all the archives to this archiver.
-        try recursiveAddFunc(nil, nil, nil, taskResult.stepHistory)
+        for (result, staged) in stepResults {
+            if let staged = staged {
+                try addStagedStep(staged)
+            }
+            else {
+                try recursiveAddFunc(nil, nil, nil, [result])
+            }
+        }
         if self.archive != nil, let asyncResults = taskResult.asyncResults {
             try recursiveAddFunc(nil, nil, nil, asyncResults)
         }
@@ -132,7 +206,7 @@ internal class TaskArchiver : NSObject {
             do {
                 // Check if there are any answers to add.
                 if answerMap.count > 0, archive.shouldInsertData(for: .answers) {
-                    let data = try answerMap.rsd_jsonEncodedData()
+                    let data = try encodingSession.encodeObject(answerMap)
                     let manifest = RSDFileResultUtility.fileManifest(for: .answers)
                     try archive.insertDataIntoArchive(data, manifest: manifest)
                     self.files.insert(manifest)
@@ -140,7 +214,7 @@ internal class TaskArchiver : NSObject {
                 
                 // Check if there is a task result to add.
                 if archive.shouldInsertData(for: .taskResult) {
-                    let data = try taskResult.rsd_jsonEncodedData()
+                    let data = try encodingSession.encodeObject(taskResult)
                     let manifest = RSDFileResultUtility.fileManifest(for: .taskResult)
                     try archive.insertDataIntoArchive(data, manifest: manifest)
                     self.files.insert(manifest)
@@ -150,7 +224,7 @@ internal class TaskArchiver : NSObject {
                 let metadata = RSDTaskMetadata(taskResult: self.taskResult, files: Array(self.files))
                 try archive.completeArchive(with: metadata)
                 archives.insert(archive, at: 0)
-                
+            
             } catch let err {
                 // If this is not swallowed, then rethrow the error.
                 // Otherwise, ignore the failure to add the archive and continue.
@@ -166,9 +240,11 @@ internal class TaskArchiver : NSObject {
     func recursiveAddFunc(_ sectionIdentifier: String?, _ collectionIdentifier: String?, _ stepPath: String?, _ results: [RSDResult]) throws {
         for result in results {
             if let taskResult = result as? RSDTaskResult {
-                if let subArchiver = TaskArchiver(manager: manager, taskResult: taskResult, inputArchive: archive) {
+                let work = nextPlannedWork()
+                let subArchiver = (work != nil) ? work!.subArchiver : TaskArchiver(manager: manager, taskResult: taskResult, inputArchive: archive)
+                if let subArchiver = subArchiver {
                     // If there is an archiver for this subtask, then append the archives with that result.
-                    let archives = try subArchiver.buildArchives()
+                    let archives = try work?.builtArchives() ?? subArchiver.buildArchives()
                     self.childArchives.append(contentsOf: archives)
                 }
                 else {
@@ -193,9 +269,12 @@ internal class TaskArchiver : NSObject {
         // Look to see if the result conforms to the archivable protocol or the collection
         // protocol. If it conforms to both, then *only* archive it at this level and do not
         // recurse into the result.
-        if let archivable = archive.archivableData(for: result, sectionIdentifier: sectionIdentifier, stepPath: stepPath) {
+        let work = nextPlannedWork()
+        let archivable = (work != nil) ? work!.archivable : archive.archivableData(for: result, sectionIdentifier: sectionIdentifier, stepPath: stepPath)
+        if let archivable = archivable {
             do {
-                if let (manifest, data) = try archivable.buildArchiveData(at: stepPath) {
+                let archiveData = try (work != nil) ? work!.builtArchiveData() : archivable.buildArchiveData(at: stepPath)
+                if let (manifest, data) = archiveData {
                     try self.archive?.insertDataIntoArchive(data, manifest: manifest)
                     self.files.insert(manifest)
                 }
@@ -212,19 +291,298 @@ internal class TaskArchiver : NSObject {
         }
         
         // If this result conforms to the answer result protocol then add it to the answer map
-        if let answerResult = result as? RSDAnswerResult {
-            if let answer = answerResult.value, !(answer is NSNull) {
-                let answerIdentifier: String = {
-                    if let key = self.manager.answerKey?(for: answerResult.identifier, with: sectionIdentifier) {
-                        return key
+        addAnswer(sectionIdentifier, collectionIdentifier, result, to: &answerMap)
+    }
+    
+    fileprivate func addAnswer(_ sectionIdentifier: String?, _ collectionIdentifier: String?, _ result: RSDResult, to answerMap: inout [String : AnswerResultWrapper]) {
+        guard let answerResult = result as? RSDAnswerResult,
+            let answer = answerResult.value, !(answer is NSNull)
+            else {
+                return
+        }
+        let answerIdentifier: String = {
+            if let key = self.manager.answerKey?(for: answerResult.identifier, with: sectionIdentifier) {
+                return key
+            }
+            let sectionPrefix = (sectionIdentifier != nil) ? "\(sectionIdentifier!)_" : ""
+            let collectionPrefix = (collectionIdentifier != nil && collectionIdentifier != result.identifier) ? "\(collectionIdentifier!)_" : ""
+            return "\(sectionPrefix)\(collectionPrefix)\(result.identifier)"
+        }()
+        answerMap[answerIdentifier] = AnswerResultWrapper(answerResult: answerResult)
+    }
+    
+    // MARK: Concurrent archiving
+    
+    /// Visit the results in the same order as `recursiveAddFunc()` and plan the work to build each child
+    /// archive and each archivable result on a bounded worker pool. The archive data is then inserted into
+    /// the archive in the original order, and errors are handled by the manager in that order.
+    ///
+    /// At most `maxConcurrentOperationCount` operations are started ahead of the result that is being
+    /// added to the archive, and the next operation is started as each result is added. This way, the data
+    /// that is held in memory waiting to be inserted is bounded by the size of the worker pool.
+    ///
+    /// Each child archive is built serially on a worker, so its data is inserted in the original order
+    /// as well. The manager and the archivable results must be thread-safe.
+    ///
+    /// - parameter stepResults: The step results that were not staged before the task finished.
+    func buildConcurrently(_ stepResults: [RSDResult]) {
+        let queue = OperationQueue()
+        queue.name = "org.sagebase.Research.TaskArchiver.\(taskResult.identifier)"
+        queue.maxConcurrentOperationCount = maxConcurrentOperationCount
+        workQueue = queue
+        plannedWork = []
+        plannedWorkIndex = 0
+        startedWorkIndex = 0
+        pendingOperationCount = 0
+        recursivePlanFunc(nil, nil, stepResults)
+        if self.archive != nil, let asyncResults = taskResult.asyncResults {
+            recursivePlanFunc(nil, nil, asyncResults)
+        }
+        startPlannedWork()
+    }
+    
+    func recursivePlanFunc(_ sectionIdentifier: String?, _ stepPath: String?, _ results: [RSDResult]) {
+        for result in results {
+            if let taskResult = result as? RSDTaskResult {
+                let subArchiver = TaskArchiver(manager: manager, taskResult: taskResult, inputArchive: archive)
+                let work = PlannedWork(subArchiver: subArchiver)
+                plannedWork!.append(work)
+                if let subArchiver = subArchiver {
+                    work.operation = BlockOperation { [weak work] in
+                        work?.buildArchives(with: subArchiver)
+                    }
+                }
+                else {
+                    let path = (stepPath != nil) ? "\(stepPath!)/\(taskResult.identifier)" : taskResult.identifier
+                    recursivePlanFunc(taskResult.identifier, path, taskResult.stepHistory)
+                    if let asyncResults = taskResult.asyncResults {
+                        recursivePlanFunc(taskResult.identifier, path, asyncResults)
+                    }
+                }
+            }
+            else if let archive = self.archive {
+                let archivable = archive.archivableData(for: result, sectionIdentifier: sectionIdentifier, stepPath: stepPath)
+                let work = PlannedWork(archivable: archivable)
+                plannedWork!.append(work)
+                if let archivable = archivable {
+                    work.operation = BlockOperation { [weak work] in
+                        work?.buildArchiveData(with: archivable, at: stepPath)
                     }
-                    let sectionPrefix = (sectionIdentifier != nil) ? "\(sectionIdentifier!)_" : ""
-                    let collectionPrefix = (collectionIdentifier != nil && collectionIdentifier != result.identifier) ? "\(collectionIdentifier!)_" : ""
-                    return "\(sectionPrefix)\(collectionPrefix)\(result.identifier)"
-                }()
-                answerMap[answerIdentifier] = AnswerResultWrapper(answerResult: answerResult)
+                }
+                else if let collection = result as? RSDCollectionResult {
+                    let path = (stepPath != nil) ? "\(stepPath!)/\(collection.identifier)" : collection.identifier
+                    recursivePlanFunc(sectionIdentifier, path, collection.inputResults)
+                }
+            }
+        }
+    }
+    
+    /// Start the planned operations in order until `maxConcurrentOperationCount` operations are pending.
+    fileprivate func startPlannedWork() {
+        guard let work = plannedWork, let queue = workQueue else { return }
+        while startedWorkIndex < work.count {
+            if let operation = work[startedWorkIndex].operation {
+                guard pendingOperationCount < maxConcurrentOperationCount else { return }
+                queue.addOperation(operation)
+                pendingOperationCount += 1
             }
+            startedWorkIndex += 1
+        }
+    }
+    
+    /// Returns the next planned work after waiting for its operation to finish, and starts the next
+    /// operation on the worker pool.
+    fileprivate func nextPlannedWork() -> PlannedWork? {
+        guard let work = plannedWork, plannedWorkIndex < work.count else { return nil }
+        let next = work[plannedWorkIndex]
+        plannedWorkIndex += 1
+        if let operation = next.operation {
+            startPlannedWork()
+            operation.waitUntilFinished()
+            pendingOperationCount -= 1
+            startPlannedWork()
         }
+        return next
+    }
+    
+    // MARK: Incremental archiving
+    
+    /// Stage a step result by adding it to the archive as soon as the step is completed. The archive data
+    /// for the archivable results that it contains (including file results) is inserted into the archive,
+    /// the answers are collected, and a child archiver is created and staged for each subtask result that
+    /// the manager vends a separate archive for.
+    ///
+    /// Staging requires an `RSDIncrementalDataArchive` so that the data can be removed if the step result is
+    /// replaced. The staged step is only used by `buildArchives()` if the final task result has the same
+    /// change token for the step. If the change token is `nil` or building the staged data fails, then the
+    /// step result is not staged and it is added to the archive when the task finishes.
+    ///
+    /// - parameters:
+    ///     - result: The top-level step result.
+    ///     - changeToken: The change token for the result in the step history of the task result.
+    func stageResult(_ result: RSDResult, changeToken: UInt64?) {
+        if let staged = stagedSteps[result.identifier] {
+            guard staged.changeToken != changeToken else { return }
+            stagedSteps[result.identifier] = nil
+            discardStagedStep(staged)
+        }
+        guard let changeToken = changeToken, self.archive is RSDIncrementalDataArchive else { return }
+        let staged = StagedStepResult(changeToken: changeToken)
+        do {
+            try recursiveStageFunc(nil, nil, nil, [result], staged)
+            stagedSteps[result.identifier] = staged
+        } catch {
+            discardStagedStep(staged)
+        }
+    }
+    
+    /// Discard the staged data for the step results with the given identifiers.
+    func discardStagedResults(with identifiers: [String]) {
+        for identifier in identifiers {
+            if let staged = stagedSteps.removeValue(forKey: identifier) {
+                discardStagedStep(staged)
+            }
+        }
+    }
+    
+    /// Discard all the staged data.
+    func discardAllStagedData() {
+        let staged = stagedSteps.values
+        stagedSteps.removeAll()
+        staged.forEach { discardStagedStep($0) }
+    }
+    
+    /// Visit the results in the same order as `recursiveAddFunc()` and insert the archive data into the
+    /// incremental archive.
+    fileprivate func recursiveStageFunc(_ sectionIdentifier: String?, _ collectionIdentifier: String?, _ stepPath: String?, _ results: [RSDResult], _ staged: StagedStepResult) throws {
+        guard let archive = self.archive as? RSDIncrementalDataArchive else { return }
+        for result in results {
+            if let taskResult = result as? RSDTaskResult {
+                if let subArchiver = TaskArchiver(manager: manager, taskResult: taskResult, inputArchive: archive) {
+                    staged.subArchivers.append(subArchiver)
+                    for stepResult in taskResult.stepHistory {
+                        let changeToken = (taskResult as? RSDTaskResultObject)?.stepHistoryChangeToken(for: stepResult.identifier)
+                        subArchiver.stageResult(stepResult, changeToken: changeToken)
+                    }
+                }
+                else {
+                    let path = (stepPath != nil) ? "\(stepPath!)/\(taskResult.identifier)" : taskResult.identifier
+                    try recursiveStageFunc(taskResult.identifier, nil, path, taskResult.stepHistory, staged)
+                    if let asyncResults = taskResult.asyncResults {
+                        try recursiveStageFunc(taskResult.identifier, nil, path, asyncResults, staged)
+                    }
+                }
+                continue
+            }
+            if let archivable = archive.archivableData(for: result, sectionIdentifier: sectionIdentifier, stepPath: stepPath) {
+                if let (manifest, data) = try archivable.buildArchiveData(at: stepPath) {
+                    try archive.insertDataIntoArchive(data, manifest: manifest)
+                    staged.manifests.append(manifest)
+                }
+            }
+            else if let collection = result as? RSDCollectionResult {
+                let path = (stepPath != nil) ? "\(stepPath!)/\(collection.identifier)" : collection.identifier
+                try recursiveStageFunc(sectionIdentifier, collection.identifier, path, collection.inputResults, staged)
+            }
+            addAnswer(sectionIdentifier, collectionIdentifier, result, to: &staged.answers)
+        }
+    }
+    
+    /// Add the staged data for a step result that has not changed since it was staged.
+    fileprivate func addStagedStep(_ staged: StagedStepResult) throws {
+        self.files.formUnion(staged.manifests)
+        self.answerMap.merge(staged.answers) { $1 }
+        for subArchiver in staged.subArchivers {
+            let archives = try subArchiver.buildArchives()
+            self.childArchives.append(contentsOf: archives)
+        }
+    }
+    
+    fileprivate func discardStagedStep(_ staged: StagedStepResult) {
+        if let archive = self.archive as? RSDIncrementalDataArchive {
+            for manifest in staged.manifests {
+                try? archive.removeDataFromArchive(with: manifest)
+            }
+        }
+        staged.subArchivers.forEach { $0.discardAllStagedData() }
+    }
+    
+    /// The change token for the step result in the task result, or `nil` if the task result does not track
+    /// change tokens.
+    fileprivate func stepHistoryChangeToken(for identifier: String) -> UInt64? {
+        return (taskResult as? RSDTaskResultObject)?.stepHistoryChangeToken(for: identifier)
+    }
+}
+
+/// The work for a visited result that is built on the worker pool when the archives are built concurrently.
+fileprivate final class PlannedWork {
+    
+    let subArchiver: TaskArchiver?
+    let archivable: RSDArchivable?
+    
+    var archives: [RSDDataArchive] = []
+    var archiveData: (manifest: RSDFileManifest, data: Data)?
+    var error: Error?
+    
+    /// The operation that builds the archives or archive data, or `nil` if there is nothing to build.
+    var operation: Operation?
+    
+    init(subArchiver: TaskArchiver?) {
+        self.subArchiver = subArchiver
+        self.archivable = nil
+    }
+    
+    init(archivable: RSDArchivable?) {
+        self.subArchiver = nil
+        self.archivable = archivable
+    }
+    
+    func buildArchives(with subArchiver: TaskArchiver) {
+        do {
+            archives = try subArchiver.buildArchives()
+        } catch let err {
+            error = err
+        }
+    }
+    
+    func buildArchiveData(with archivable: RSDArchivable, at stepPath: String?) {
+        do {
+            archiveData = try archivable.buildArchiveData(at: stepPath)
+        } catch let err {
+            error = err
+        }
+    }
+    
+    func builtArchives() throws -> [RSDDataArchive]? {
+        if let err = error { throw err }
+        return archives
+    }
+    
+    /// Returns the archive data and releases it so that it is not held in memory after it is inserted.
+    func builtArchiveData() throws -> (manifest: RSDFileManifest, data: Data)? {
+        if let err = error { throw err }
+        defer { archiveData = nil }
+        return archiveData
+    }
+}
+
+/// The data for a step result that was added to the archive before the task finished.
+fileprivate final class StagedStepResult {
+    
+    /// The change token of the step result when it was staged.
+    let changeToken: UInt64
+    
+    /// The manifests for the data that was inserted into the archive.
+    var manifests: [RSDFileManifest] = []
+    
+    /// The answers to add to the answer map.
+    var answers: [String : AnswerResultWrapper] = [:]
+    
+    /// The archivers for the subtask results that are archived separately.
+    var subArchivers: [TaskArchiver] = []
+    
+    init(changeToken: UInt64) {
+        self.changeToken = changeToken
     }
 }
 
@@ -34,22 +34,166 @@
 import Foundation
 
 /// `RSDDataLogger` is used to write data samples using a custom encoding to a logging file.
+///
+/// If the logger has a `rotationPolicy`, then the samples are written to a series of files (segments).
+/// When the current segment reaches the size or duration limit of the policy, the segment is closed and
+/// a new segment is opened that starts with the same initial data. Closed segments are reported to the
+/// `segmentHandler` so that they can be processed while the recording continues.
+///
 /// - note: This class does **not** use a serial queue to process the samples. It is assumed that the
 /// recorder that is using this file will handle that implementation.
 open class RSDDataLogger {
     
+    /// The policy used to determine when data appended to the logger should be flushed to the file.
+    /// The logger will always flush the buffer when the file is closed.
+    public struct FlushPolicy : Equatable {
+        
+        /// The number of bytes to hold in memory before flushing to the file. If `0` then every write
+        /// will be written directly to the file.
+        public var maxBufferSize: Int
+        
+        /// The maximum amount of time (in seconds) to hold data in memory before flushing to the file.
+        /// This is checked when `flushIfNeeded()` is called rather than when data is written so that
+        /// the data is flushed even if no more data is written. `RSDSampleRecorder` calls that method
+        /// from a timer on its `loggerQueue`. If `nil` then the buffer is only flushed when it reaches
+        /// the `maxBufferSize` or the file is closed.
+        public var flushInterval: TimeInterval?
+        
+        public init(maxBufferSize: Int, flushInterval: TimeInterval? = nil) {
+            self.maxBufferSize = maxBufferSize
+            self.flushInterval = flushInterval
+        }
+        
+        /// Write every chunk directly to the file.
+        public static let writeThrough = FlushPolicy(maxBufferSize: 0)
+        
+        /// Buffer up to 64 KB or 1 second of data before writing to the file.
+        public static let buffered = FlushPolicy(maxBufferSize: 64 * 1024, flushInterval: 1.0)
+    }
+    
+    /// The policy used to determine when the logger should close the current file and start writing to
+    /// a new segment. The policy is checked when data is written to the logger, but never on the first
+    /// write to a segment so that each segment includes at least one write after the initial data.
+    public struct RotationPolicy : Equatable {
+        
+        /// The number of bytes (before compression) to write to a segment before starting a new segment.
+        /// If `nil`, then the segments are not limited by size.
+        public var maxSegmentSize: UInt64?
+        
+        /// The amount of time (in seconds) to write to a segment before starting a new segment. If `nil`,
+        /// then the segments are not limited by duration.
+        public var maxSegmentDuration: TimeInterval?
+        
+        public init(maxSegmentSize: UInt64? = nil, maxSegmentDuration: TimeInterval? = nil) {
+            self.maxSegmentSize = maxSegmentSize
+            self.maxSegmentDuration = maxSegmentDuration
+        }
+    }
+    
+    /// A segment is a file that has been closed by the logger.
+    public struct Segment : Equatable {
+        
+        /// The url to the file.
+        public let url: URL
+        
+        /// The index of the segment, starting at `0` for the first file.
+        public let index: Int
+        
+        /// The number of samples written to the file.
+        public let sampleCount: Int
+        
+        /// The date when the segment was opened.
+        public let startDate: Date
+        
+        /// The date when the segment was closed.
+        public let endDate: Date
+    }
+    
     /// A unique identifier for the logger.
     public let identifier: String
     
-    /// The url to the file.
-    public let url: URL
+    /// The url to the current file. If the logger uses a rotation policy, then this will change each
+    /// time that a new segment is started.
+    public private(set) var url: URL
     
     /// Open file handle for writing to the logger.
-    private let fileHandle: FileHandle
+    private var fileHandle: FileHandle
     
-    /// Number of samples written to the file.
+    /// Number of samples written to the file. If the logger uses a rotation policy, then this is the
+    /// total for all the segments.
     public private(set) var sampleCount: Int = 0
     
+    /// The policy used to determine when to flush the buffer to the file.
+    public var flushPolicy: FlushPolicy
+    
+    /// The policy used to determine when to start a new segment. If `nil`, then all the samples are
+    /// written to a single file.
+    public var rotationPolicy: RotationPolicy?
+    
+    /// A closure that is called after a segment is closed and the next segment is opened. This is
+    /// called on the queue that wrote the data that triggered the rotation, after the rotation is
+    /// complete, so the closure can write the first data to the new segment.
+    public var segmentHandler: ((RSDDataLogger, Segment) -> Void)?
+    
+    /// The segments that have been closed. This does not include the current file.
+    public private(set) var closedSegments: [Segment] = []
+    
+    /// The index of the current segment.
+    public var segmentIndex: Int {
+        return closedSegments.count
+    }
+    
+    /// Number of samples written to the current segment.
+    public private(set) var segmentSampleCount: Int = 0
+    
+    /// The date when the current segment was opened.
+    public private(set) var segmentStartDate: Date
+    
+    /// The number of bytes written to the file, including the initial data. Data that is still buffered
+    /// in memory is not included. If the logger uses a rotation policy, then this is the total for all the
+    /// segments.
+    ///
+    /// If the logger uses a content encoding, then this is the number of *compressed* bytes that have
+    /// been written to the file.
+    public private(set) var bytesWritten: UInt64 = 0
+    
+    /// The content encoding used to compress the data as it is written to the file. If `nil`, then the
+    /// data is written to the file without compression.
+    public let contentEncoding: RSDContentEncoding?
+    
+    /// The number of bytes that have been written to the file before compression, including the initial
+    /// data. If the logger does not use a content encoding, then this is the same as `bytesWritten`.
+    public private(set) var uncompressedBytesWritten: UInt64 = 0
+    
+    /// The encoder used to compress the data if the content encoding is gzip.
+    private var gzipEncoder: RSDGzipEncoder?
+    
+    /// The initial data that is written at the start of each segment.
+    private let initialData: Data
+    
+    /// The number of bytes (before compression) that have been appended to the current segment.
+    private var segmentByteCount: UInt64
+    
+    /// The system uptime when the current segment was opened.
+    private var segmentStartUptime: TimeInterval
+    
+    /// The number of times that data has been written to the current segment.
+    private var segmentWriteCount: Int = 0
+    
+    /// The number of bytes that have been appended to the logger but not yet written to the file.
+    public var bufferedByteCount: Int {
+        return buffer.count
+    }
+    
+    /// The number of times that the buffer has been flushed to the file.
+    public private(set) var flushCount: Int = 0
+    
+    /// The in-memory append buffer.
+    private var buffer = Data()
+    
+    /// The system uptime when the buffer was last flushed.
+    private var lastFlushUptime: TimeInterval
+    
     /// The content type of the data file (if known).
     open var contentType: String? {
         return nil
@@ -62,25 +206,102 @@ open class RSDDataLogger {
     ///     - identifier: A unique identifier for the logger.
     ///     - url: The url to the file.
     ///     - initialData: The initial data to write to the file on opening.
-    public init(identifier: String, url: URL, initialData: Data?) throws {
+    ///     - contentEncoding: The content encoding to use to compress the file, or `nil` to write the
+    ///                        data without compression.
+    ///     - flushPolicy: The policy used to determine when to flush appended data to the file.
+    public init(identifier: String, url: URL, initialData: Data?, contentEncoding: RSDContentEncoding? = nil, flushPolicy: FlushPolicy = .writeThrough) throws {
         self.identifier = identifier
         self.url = url
+        self.flushPolicy = flushPolicy
+        self.contentEncoding = contentEncoding
+        self.initialData = initialData ?? Data()
         
-        let data = initialData ?? Data()
-        try data.write(to: url)
-        
-        self.fileHandle = try FileHandle(forWritingTo: url)
+        let file = try RSDDataLogger.openFile(at: url, initialData: self.initialData, contentEncoding: contentEncoding)
+        self.fileHandle = file.fileHandle
+        self.gzipEncoder = file.gzipEncoder
+        self.bytesWritten = file.bytesWritten
+        self.uncompressedBytesWritten = UInt64(self.initialData.count)
+        self.segmentByteCount = UInt64(self.initialData.count)
+        self.segmentStartDate = Date()
+        self.segmentStartUptime = ProcessInfo.processInfo.systemUptime
+        self.lastFlushUptime = ProcessInfo.processInfo.systemUptime
+        self.buffer.reserveCapacity(flushPolicy.maxBufferSize)
     }
     
     /// Write data to the logger.
     /// - parameter data: The data to add to the logging file.
     /// - throws: Error if writing the data fails because the wasn't enough memory on the device.
     open func write(_ data: Data) throws {
-        try RSDExceptionHandler.try {
-            self.fileHandle.seekToEndOfFile()
-            self.fileHandle.write(data)
+        try write(data, sampleCount: 1)
+    }
+    
+    /// Write data that includes more than one sample to the logger.
+    /// - parameters:
+    ///     - data: The data to add to the logging file.
+    ///     - count: The number of samples included in the data.
+    /// - throws: Error if writing the data fails because the wasn't enough memory on the device.
+    func write(_ data: Data, sampleCount count: Int) throws {
+        buffer.append(data)
+        sampleCount += count
+        segmentSampleCount += count
+        segmentByteCount += UInt64(data.count)
+        segmentWriteCount += 1
+        if shouldRotate() {
+            let segment = try rotate()
+            segmentHandler?(self, segment)
+        }
+        else if buffer.count >= flushPolicy.maxBufferSize {
+            try flush()
+        }
+    }
+    
+    /// Flush the buffered data if it has been held in memory for longer than the `flushInterval` of the
+    /// `flushPolicy`. This method should be called periodically on the same queue that is used to write
+    /// to the logger.
+    ///
+    /// - throws: Error if writing the data fails because the wasn't enough memory on the device.
+    open func flushIfNeeded() throws {
+        guard let interval = flushPolicy.flushInterval,
+            ProcessInfo.processInfo.systemUptime - lastFlushUptime >= interval
+            else {
+                return
+        }
+        try flush()
+    }
+    
+    /// Write any buffered data to the file.
+    /// - throws: Error if writing the data fails because the wasn't enough memory on the device.
+    open func flush() throws {
+        lastFlushUptime = ProcessInfo.processInfo.systemUptime
+        guard buffer.count > 0 else { return }
+        let count = UInt64(buffer.count)
+        if let encoder = gzipEncoder {
+            // Once the buffer is added to the compression stream, it cannot be written again.
+            let data = try encoder.encode(buffer)
+            buffer.removeAll(keepingCapacity: true)
+            try writeToFile(data)
+        }
+        else {
+            try writeToFile(buffer)
+            buffer.removeAll(keepingCapacity: true)
         }
-        sampleCount += 1
+        uncompressedBytesWritten += count
+        flushCount += 1
+    }
+    
+    /// Add samples to the sample count without writing any data. This is used by a subclass to count
+    /// the samples that are included in the `segmentTrailerData()`.
+    func addToSampleCount(_ count: Int) {
+        sampleCount += count
+        segmentSampleCount += count
+    }
+    
+    /// The data to write at the end of each file before it is closed. The default implementation
+    /// returns `nil`. Subclasses can override this method to close the root element of the file.
+    ///
+    /// - returns: The data to write at the end of the file.
+    open func segmentTrailerData() throws -> Data? {
+        return nil
     }
     
     /// Close the file. This will write the end tag for the root element and then close the file handle.
@@ -89,6 +310,103 @@ open class RSDDataLogger {
     ///
     /// - throws: Error thrown when attempting to write the closing tag.
     open func close() throws {
+        try closeSegment()
+    }
+    
+    /// Close the current segment and open the next one.
+    /// - returns: The segment that was closed.
+    private func rotate() throws -> Segment {
+        let startDate = self.segmentStartDate
+        try closeSegment()
+        let segment = Segment(url: url, index: segmentIndex, sampleCount: segmentSampleCount, startDate: startDate, endDate: Date())
+        closedSegments.append(segment)
+        
+        let nextURL = RSDDataLogger.segmentURL(for: closedSegments[0].url, index: segmentIndex)
+        let file = try RSDDataLogger.openFile(at: nextURL, initialData: initialData, contentEncoding: contentEncoding)
+        self.url = nextURL
+        self.fileHandle = file.fileHandle
+        self.gzipEncoder = file.gzipEncoder
+        self.bytesWritten += file.bytesWritten
+        self.uncompressedBytesWritten += UInt64(initialData.count)
+        self.segmentByteCount = UInt64(initialData.count)
+        self.segmentSampleCount = 0
+        self.segmentWriteCount = 0
+        self.segmentStartDate = Date()
+        self.segmentStartUptime = ProcessInfo.processInfo.systemUptime
+        
+        return segment
+    }
+    
+    /// Write the trailer, flush the buffer, finish the compression stream, and close the file handle.
+    private func closeSegment() throws {
+        var flushError: Error?
+        do {
+            if let trailer = try segmentTrailerData() {
+                buffer.append(trailer)
+                segmentByteCount += UInt64(trailer.count)
+            }
+            try flush()
+            // If the data is compressed, then finish the compression stream.
+            if let encoder = gzipEncoder {
+                try writeToFile(try encoder.finish())
+            }
+        } catch let err {
+            flushError = err
+        }
         self.fileHandle.closeFile()
+        if let error = flushError {
+            throw error
+        }
+    }
+    
+    private func writeToFile(_ data: Data) throws {
+        guard data.count > 0 else { return }
+        try RSDExceptionHandler.try {
+            self.fileHandle.write(data)
+        }
+        bytesWritten += UInt64(data.count)
+    }
+    
+    private func shouldRotate() -> Bool {
+        guard let policy = rotationPolicy, segmentWriteCount > 1 else { return false }
+        if let maxSize = policy.maxSegmentSize, segmentByteCount >= maxSize {
+            return true
+        }
+        else if let duration = policy.maxSegmentDuration {
+            return ProcessInfo.processInfo.systemUptime - segmentStartUptime >= duration
+        }
+        else {
+            return false
+        }
+    }
+    
+    /// Open a file and write the initial data.
+    private static func openFile(at url: URL, initialData: Data, contentEncoding: RSDContentEncoding?) throws -> (fileHandle: FileHandle, gzipEncoder: RSDGzipEncoder?, bytesWritten: UInt64) {
+        var data = initialData
+        var gzipEncoder: RSDGzipEncoder?
+        if contentEncoding == .gzip {
+            let encoder = try RSDGzipEncoder()
+            data = try encoder.encode(data)
+            gzipEncoder = encoder
+        }
+        try data.write(to: url)
+        
+        let fileHandle = try FileHandle(forWritingTo: url)
+        let bytesWritten = fileHandle.seekToEndOfFile()
+        return (fileHandle, gzipEncoder, bytesWritten)
+    }
+    
+    /// The url for the segment at the given index. The first segment uses the url that the logger was
+    /// initialized with and the following segments insert the index before the path extension.
+    ///
+    /// - example: "motion.json", "motion-1.json", "motion-2.json"
+    static func segmentURL(for url: URL, index: Int) -> URL {
+        guard index > 0 else { return url }
+        let filename = url.lastPathComponent
+        let parts = filename.split(separator: ".", maxSplits: 1, omittingEmptySubsequences: false)
+        let name = parts.count > 1 ? "\(parts[0])-\(index).\(parts[1])" : "\(filename)-\(index)"
+        // Keep the url relative to the same base url so that the relative path is preserved.
+        let path = (url.relativePath as NSString).deletingLastPathComponent
+        return URL(fileURLWithPath: (path as NSString).appendingPathComponent(name), relativeTo: url.baseURL)
     }
 }
@@ -0,0 +1,153 @@
+//
+//  RSDDecimationFilter.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDDecimationFilter` reduces the sampling rate of a stream of three-axis samples by an integer
+/// factor. Before the samples are dropped, a linear-phase low-pass FIR filter removes the frequencies
+/// above the Nyquist frequency of the output rate so that they are not aliased into the output.
+///
+/// The filter is a Hamming-windowed sinc with a cutoff at `0.5 / factor` cycles per sample. It is only
+/// evaluated for the samples that are kept. The output is delayed by `delay` input samples. Each output
+/// is paired with the element that was passed in with the sample at the center of the filter, so the
+/// timestamps and other values of the element stay aligned with the filtered vector.
+///
+/// Before the buffer is full, the missing samples are treated as copies of the first sample. The last
+/// `delay` samples of the stream are never output.
+///
+/// The buffers are allocated when the filter is initialized so that processing a sample does not
+/// allocate memory. An instance of this class is **not** thread-safe.
+public final class RSDDecimationFilter<Element> {
+    
+    /// The number of input samples for each output sample.
+    public let factor: Int
+    
+    /// The filter coefficients. The coefficients are symmetric and sum to `1`.
+    public let coefficients: [Double]
+    
+    /// The number of input samples by which the output is delayed.
+    public var delay: Int {
+        return (coefficients.count - 1) / 2
+    }
+    
+    /// The number of samples that have been processed.
+    public private(set) var sampleCount: Int = 0
+    
+    /// The ring buffer of input vectors.
+    private var vectors: [SIMD3<Double>]
+    
+    /// The ring buffer of input elements.
+    private var elements: [Element?]
+    
+    /// The index in the ring buffer of the most recent sample.
+    private var head: Int = -1
+    
+    /// Initialize the filter.
+    /// - parameters:
+    ///     - factor: The number of input samples for each output sample. Must be at least `1`.
+    ///     - tapCount: The number of filter coefficients. This is rounded up to an odd number. If `nil`,
+    ///                 then `20 * factor + 1` coefficients are used. If `1`, then the samples are not
+    ///                 filtered and every `factor` sample is kept.
+    public init(factor: Int, tapCount: Int? = nil) {
+        precondition(factor >= 1, "The decimation factor must be at least 1.")
+        self.factor = factor
+        let count = (factor == 1) ? 1 : (tapCount ?? (20 * factor + 1))
+        self.coefficients = RSDDecimationFilter.lowPassCoefficients(tapCount: count | 1, cutoff: 0.5 / Double(factor))
+        self.vectors = Array(repeating: SIMD3<Double>(repeating: 0), count: coefficients.count)
+        self.elements = Array(repeating: nil, count: coefficients.count)
+    }
+    
+    /// Add a sample to the filter.
+    /// - parameters:
+    ///     - element: The element associated with the sample.
+    ///     - x: The x-axis value.
+    ///     - y: The y-axis value.
+    ///     - z: The z-axis value.
+    /// - returns: The filtered vector and the element associated with it or `nil` if this sample does not
+    ///            result in an output.
+    public func process(_ element: Element, x: Double, y: Double, z: Double) -> (element: Element, vector: SIMD3<Double>)? {
+        let length = coefficients.count
+        let vector = SIMD3<Double>(x, y, z)
+        if sampleCount == 0 {
+            // Fill the buffer with the first sample.
+            for idx in 0..<length {
+                vectors[idx] = vector
+            }
+        }
+        head = (head + 1 == length) ? 0 : head + 1
+        vectors[head] = vector
+        elements[head] = element
+        sampleCount += 1
+        
+        // The sample at the center of the filter is kept if it is the first of each group of `factor`.
+        let center = sampleCount - 1 - delay
+        guard center >= 0, center % factor == 0 else { return nil }
+        
+        var output = SIMD3<Double>(repeating: 0)
+        var index = head
+        for coefficient in coefficients {
+            output += coefficient * vectors[index]
+            index = (index == 0) ? length - 1 : index - 1
+        }
+        let centerIndex = (head - delay + length) % length
+        guard let centerElement = elements[centerIndex] else { return nil }
+        return (centerElement, output)
+    }
+    
+    /// Reset the filter to its initial state.
+    public func reset() {
+        for idx in 0..<elements.count {
+            elements[idx] = nil
+        }
+        head = -1
+        sampleCount = 0
+    }
+    
+    /// Calculate the coefficients for a Hamming-windowed sinc low-pass filter.
+    /// - parameters:
+    ///     - tapCount: The number of coefficients. This should be an odd number.
+    ///     - cutoff: The cutoff frequency in cycles per sample in the range `(0, 0.5]`.
+    /// - returns: The filter coefficients normalized so that the gain at zero frequency is `1`.
+    public static func lowPassCoefficients(tapCount: Int, cutoff: Double) -> [Double] {
+        guard tapCount > 1 else { return [1] }
+        let center = Double(tapCount - 1) / 2
+        let taps = (0..<tapCount).map { (idx: Int) -> Double in
+            let n = Double(idx) - center
+            let sinc = (n == 0) ? 2 * cutoff : sin(2 * Double.pi * cutoff * n) / (Double.pi * n)
+            let window = 0.54 - 0.46 * cos(2 * Double.pi * Double(idx) / Double(tapCount - 1))
+            return sinc * window
+        }
+        let sum = taps.reduce(0, +)
+        return taps.map { $0 / sum }
+    }
+}
@@ -60,30 +60,24 @@ extension RSDDelimiterSeparatedEncodable {
 extension Encodable {
     
     /// Returns the comma-separated string representing this object.
+    ///
+    /// - note: This method creates a new `RSDDelimiterSeparatedEncoder` for each call. If encoding
+    ///         multiple objects, then it is more efficient to create and reuse a single encoder.
+    ///
     /// - parameter codingKeys: The codingKeys to use as mask for the comma-delimited list.
     public func rsd_delimiterEncodedString(with codingKeys: [CodingKey], delimiter: String) throws -> String {
-        let dictionary = try self.rsd_jsonEncodedDictionary()
-        let values: [String] = try codingKeys.map { (key) -> String in
-            guard let value = dictionary[key.stringValue] else { return "" }
-            if ((value is [Any]) || (value is [String : Any])) {
-                let context = EncodingError.Context(codingPath: [], debugDescription: "A comma-delimited string encoding cannot encode a nested array or dictionary.")
-                throw EncodingError.invalidValue(value, context)
-            }
-            let string = "\(value)"
-            if string.contains(delimiter) {
-                let context = EncodingError.Context(codingPath: [], debugDescription: "A delimited string encoding cannot encode a string that contains the delimiter: '\(delimiter)'.")
-                throw EncodingError.invalidValue(string, context)
-            }
-            return string
-        }
-        return values.joined(separator: delimiter)
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: codingKeys, delimiter: delimiter)
+        return try encoder.encodeString(self)
     }
     
-    /// Returns JSON-encoded data created by encoding this object using a JSON encoder created
-    /// by the shared `RSDFactory` singleton.
+    /// Returns JSON-encoded data created by encoding this object using a cached JSON encoder from
+    /// the shared `RSDFactory` singleton.
+    ///
+    /// - seealso: `RSDFactory.createEncodingSession(outputFormat:)` for encoding multiple objects.
     public func rsd_jsonEncodedData() throws -> Data {
-        let jsonEncoder = RSDFactory.shared.createJSONEncoder()
-        return try self.rsd_encodeObject(to: jsonEncoder)
+        return try RSDFactory.shared.withJSONEncoder { jsonEncoder in
+            try self.rsd_encodeObject(to: jsonEncoder)
+        }
     }
     
     /// Returns a JSON-encoded dictionary created by encoding this object using a JSON encoder
@@ -0,0 +1,618 @@
+//
+//  RSDDelimiterSeparatedEncoder.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDDelimiterSeparatedEncoder` encodes an `Encodable` object directly into a single row of a
+/// delimiter-separated (for example, comma-separated) table.
+///
+/// The encoder is a streaming alternative to encoding each object to JSON, deserializing that JSON into
+/// a dictionary, and then formatting the dictionary values. Instead, the object is encoded using a
+/// lightweight `Encoder` that appends the UTF-8 bytes for each top-level value directly into a
+/// reusable byte buffer. Keys that are not included in the `codingKeys` are ignored.
+///
+/// The values are formatted to match the strings that are created by encoding the object using the
+/// shared `RSDFactory` JSON encoder. Dates and data are encoded using the factory, non-conforming
+/// floating point values are encoded using the factory `nonConformingCodingStrategy`, and numbers are
+/// formatted using the shortest representation with up to 16 significant digits.
+///
+/// An instance of this class is **not** thread-safe. It is intended to be owned by a single logger
+/// and reused for each row written to the file.
+///
+/// - seealso: `RSDDelimiterSeparatedEncodable`, `RSDRecordSampleLogger`
+public final class RSDDelimiterSeparatedEncoder {
+    
+    /// The ordered list of coding keys that define the columns in the table.
+    public let codingKeys: [CodingKey]
+    
+    /// The string used to separate the columns in a row.
+    public let delimiter: String
+    
+    /// The factory to use when encoding dates, data, and non-conforming floats.
+    public let factory: RSDFactory
+    
+    /// The column index for each coding key.
+    private let columnIndex: [String : Int]
+    
+    /// Reusable buffer holding the UTF-8 bytes for the column values of the row that is currently
+    /// being encoded. The values are appended in the order they are encoded.
+    private var valueBytes: [UInt8] = []
+    
+    /// The range of `valueBytes` holding the value for each column, or `nil` if the column is empty.
+    private var columnRanges: [Range<Int>?]
+    
+    /// Reusable buffer used to join the columns when encoding a row as a string.
+    private var rowBytes: [UInt8] = []
+    
+    /// The UTF-8 delimiter bytes.
+    private let delimiterData: Data
+    
+    /// The delimiter byte if the delimiter is a single UTF-8 code unit.
+    private let delimiterByte: UInt8?
+    
+    /// The error to throw once encoding has finished. The `Encoder` protocol does not allow throwing
+    /// when a container is requested, so errors are stored and thrown at the end of encoding the row.
+    fileprivate var pendingError: Error?
+    
+    /// Reusable buffer used to format floating point numbers.
+    private let numberBuffer: UnsafeMutablePointer<CChar>
+    private let numberBufferSize: Int = 32
+    
+    /// Default initializer.
+    /// - parameters:
+    ///     - codingKeys: The ordered list of coding keys to use as the columns in the table.
+    ///     - delimiter: The string to use to separate the columns.
+    ///     - factory: The factory to use when encoding values. Default = `RSDFactory.shared`.
+    public init(codingKeys: [CodingKey], delimiter: String, factory: RSDFactory = RSDFactory.shared) {
+        self.codingKeys = codingKeys
+        self.delimiter = delimiter
+        self.factory = factory
+        var columnIndex = [String : Int](minimumCapacity: codingKeys.count)
+        for (idx, key) in codingKeys.enumerated() where columnIndex[key.stringValue] == nil {
+            columnIndex[key.stringValue] = idx
+        }
+        self.columnIndex = columnIndex
+        self.columnRanges = Array(repeating: nil, count: codingKeys.count)
+        self.delimiterData = Data(delimiter.utf8)
+        self.delimiterByte = (delimiterData.count == 1) ? delimiterData.first : nil
+        self.numberBuffer = UnsafeMutablePointer<CChar>.allocate(capacity: numberBufferSize)
+    }
+    
+    deinit {
+        numberBuffer.deallocate()
+    }
+    
+    /// Returns the delimiter-separated string representing the given object.
+    /// - parameter value: The object to encode.
+    /// - returns: The delimiter-separated row.
+    /// - throws: `EncodingError` if the object cannot be represented as a single row.
+    public func encodeString(_ value: Encodable) throws -> String {
+        try encodeColumns(value)
+        rowBytes.removeAll(keepingCapacity: true)
+        valueBytes.withUnsafeBufferPointer { values in
+            for (idx, range) in columnRanges.enumerated() {
+                if idx > 0 {
+                    rowBytes.append(contentsOf: delimiterData)
+                }
+                if let range = range {
+                    rowBytes.append(contentsOf: UnsafeBufferPointer(rebasing: values[range]))
+                }
+            }
+        }
+        return String(decoding: rowBytes, as: UTF8.self)
+    }
+    
+    /// Encode the given object and append the UTF-8 encoded row to the given data buffer. This does not
+    /// append a line separator.
+    ///
+    /// - parameters:
+    ///     - value: The object to encode.
+    ///     - data: The data buffer to append the row to.
+    /// - throws: `EncodingError` if the object cannot be represented as a single row.
+    public func encode(_ value: Encodable, appendingTo data: inout Data) throws {
+        try encodeColumns(value)
+        valueBytes.withUnsafeBufferPointer { values in
+            for (idx, range) in columnRanges.enumerated() {
+                if idx > 0 {
+                    data.append(delimiterData)
+                }
+                if let range = range {
+                    data.append(UnsafeBufferPointer(rebasing: values[range]))
+                }
+            }
+        }
+    }
+    
+    private func encodeColumns(_ value: Encodable) throws {
+        for idx in columnRanges.indices {
+            columnRanges[idx] = nil
+        }
+        valueBytes.removeAll(keepingCapacity: true)
+        pendingError = nil
+        let encoder = _RowEncoder(owner: self)
+        try value.encode(to: encoder)
+        if !encoder.didCreateKeyedContainer {
+            let context = EncodingError.Context(codingPath: [], debugDescription: "Failed to encode the object into a dictionary.")
+            throw EncodingError.invalidValue(value, context)
+        }
+        if let error = pendingError {
+            throw error
+        }
+    }
+    
+    // MARK: Column values
+    
+    /// Returns the column index for the given key or `nil` if the key is not included in the table.
+    fileprivate func column(for key: CodingKey) -> Int? {
+        return columnIndex[key.stringValue]
+    }
+    
+    /// Append the bytes written by the given closure to the value buffer and use them as the value for
+    /// the given column.
+    private func setValue(at column: Int, codingPath: [CodingKey], _ write: (inout [UInt8]) -> Void) {
+        let start = valueBytes.count
+        write(&valueBytes)
+        let range = start..<valueBytes.count
+        if containsDelimiter(in: range) {
+            let string = String(decoding: valueBytes[range], as: UTF8.self)
+            let context = EncodingError.Context(codingPath: codingPath, debugDescription: "A delimited string encoding cannot encode a string that contains the delimiter: '\(delimiter)'.")
+            setError(EncodingError.invalidValue(string, context))
+        }
+        columnRanges[column] = range
+    }
+    
+    fileprivate func setValue(_ string: String, at column: Int, codingPath: [CodingKey]) {
+        setValue(at: column, codingPath: codingPath) { $0.append(contentsOf: string.utf8) }
+    }
+    
+    fileprivate func setValue(_ value: Bool, at column: Int, codingPath: [CodingKey]) {
+        setValue(at: column, codingPath: codingPath) { $0.append(value ? UInt8(ascii: "1") : UInt8(ascii: "0")) }
+    }
+    
+    /// Write the decimal digits of the integer directly into the value buffer.
+    fileprivate func setValue<T : FixedWidthInteger>(_ value: T, at column: Int, codingPath: [CodingKey]) {
+        setValue(at: column, codingPath: codingPath) { bytes in
+            if value < 0 {
+                bytes.append(UInt8(ascii: "-"))
+            }
+            var magnitude = UInt64(value.magnitude)
+            let start = bytes.count
+            repeat {
+                bytes.append(UInt8(ascii: "0") + UInt8(magnitude % 10))
+                magnitude /= 10
+            } while magnitude > 0
+            bytes[start...].reverse()
+        }
+    }
+    
+    fileprivate func setValue(_ value: Double, at column: Int, codingPath: [CodingKey]) {
+        if value.isNaN {
+            setValue(factory.nonConformingCodingStrategy.nan, at: column, codingPath: codingPath)
+        } else if value == .infinity {
+            setValue(factory.nonConformingCodingStrategy.positiveInfinity, at: column, codingPath: codingPath)
+        } else if value == -.infinity {
+            setValue(factory.nonConformingCodingStrategy.negativeInfinity, at: column, codingPath: codingPath)
+        } else if value == value.rounded(), abs(value) < 1e15 {
+            // Whole numbers are written without a decimal point.
+            setValue(Int64(value), at: column, codingPath: codingPath)
+        } else {
+            let count = withVaList([value]) { vsnprintf(numberBuffer, numberBufferSize, "%.16g", $0) }
+            let length = min(max(Int(count), 0), numberBufferSize - 1)
+            setValue(at: column, codingPath: codingPath) { bytes in
+                numberBuffer.withMemoryRebound(to: UInt8.self, capacity: length) {
+                    bytes.append(contentsOf: UnsafeBufferPointer(start: $0, count: length))
+                }
+            }
+        }
+    }
+    
+    fileprivate func setValue(_ value: Float, at column: Int, codingPath: [CodingKey]) {
+        if value.isNaN || value.isInfinite {
+            setValue(Double(value), at: column, codingPath: codingPath)
+        } else {
+            // Float values are written by the JSON encoder using the shortest representation of the
+            // `Float` rather than the `Double`.
+            setValue(Double(value.description) ?? Double(value), at: column, codingPath: codingPath)
+        }
+    }
+    
+    fileprivate func setNestedContainerError(codingPath: [CodingKey]) {
+        let context = EncodingError.Context(codingPath: codingPath, debugDescription: "A comma-delimited string encoding cannot encode a nested array or dictionary.")
+        setError(EncodingError.invalidValue(codingPath.map { $0.stringValue }, context))
+    }
+    
+    private func setError(_ error: Error) {
+        if pendingError == nil {
+            pendingError = error
+        }
+    }
+    
+    private func containsDelimiter(in range: Range<Int>) -> Bool {
+        if let byte = delimiterByte {
+            return valueBytes[range].contains(byte)
+        }
+        let count = delimiterData.count
+        guard count > 0, range.count >= count else { return false }
+        var idx = range.lowerBound
+        while idx + count <= range.upperBound {
+            if valueBytes[idx..<(idx + count)].elementsEqual(delimiterData) {
+                return true
+            }
+            idx += 1
+        }
+        return false
+    }
+    
+    fileprivate func string(from value: Encodable, codingPath: [CodingKey]) -> String? {
+        switch value {
+        case let date as Date:
+            return factory.encodeString(from: date, codingPath: codingPath)
+        case let data as Data:
+            return factory.encodeString(from: data, codingPath: codingPath)
+        case let url as URL:
+            return url.absoluteString
+        case let decimal as Decimal:
+            return decimal.description
+        default:
+            return nil
+        }
+    }
+}
+
+// MARK: Encoder
+
+/// The top-level encoder for a single row.
+fileprivate final class _RowEncoder : Encoder {
+    let owner: RSDDelimiterSeparatedEncoder
+    var didCreateKeyedContainer = false
+    
+    init(owner: RSDDelimiterSeparatedEncoder) {
+        self.owner = owner
+    }
+    
+    var codingPath: [CodingKey] {
+        return []
+    }
+    
+    var userInfo: [CodingUserInfoKey : Any] {
+        return [.factory : owner.factory]
+    }
+    
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key : CodingKey {
+        didCreateKeyedContainer = true
+        return KeyedEncodingContainer(_RowKeyedContainer<Key>(owner: owner))
+    }
+    
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        return _DiscardingUnkeyedContainer(codingPath: [])
+    }
+    
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        return _DiscardingSingleValueContainer(codingPath: [])
+    }
+}
+
+/// The keyed container for a single row. Values for keys that are included in the table are written
+/// to the matching column. All other values are ignored.
+fileprivate struct _RowKeyedContainer<Key : CodingKey> : KeyedEncodingContainerProtocol {
+    let owner: RSDDelimiterSeparatedEncoder
+    
+    var codingPath: [CodingKey] {
+        return []
+    }
+    
+    private func set<T : FixedWidthInteger>(_ value: T, forKey key: Key) {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue(value, at: column, codingPath: [key])
+    }
+    
+    mutating func encodeNil(forKey key: Key) throws {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue("<null>", at: column, codingPath: [key])
+    }
+    
+    mutating func encode(_ value: Bool, forKey key: Key) throws {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue(value, at: column, codingPath: [key])
+    }
+    
+    mutating func encode(_ value: String, forKey key: Key) throws {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue(value, at: column, codingPath: [key])
+    }
+    
+    mutating func encode(_ value: Double, forKey key: Key) throws {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue(value, at: column, codingPath: [key])
+    }
+    
+    mutating func encode(_ value: Float, forKey key: Key) throws {
+        guard let column = owner.column(for: key) else { return }
+        owner.setValue(value, at: column, codingPath: [key])
+    }
+    
+    mutating func encode(_ value: Int, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: Int8, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: Int16, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: Int32, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: Int64, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: UInt, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: UInt8, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: UInt16, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: UInt32, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode(_ value: UInt64, forKey key: Key) throws {
+        set(value, forKey: key)
+    }
+    
+    mutating func encode<T>(_ value: T, forKey key: Key) throws where T : Encodable {
+        guard let column = owner.column(for: key) else { return }
+        let codingPath: [CodingKey] = [key]
+        if let string = owner.string(from: value, codingPath: codingPath) {
+            owner.setValue(string, at: column, codingPath: codingPath)
+        } else {
+            try value.encode(to: _ColumnEncoder(owner: owner, column: column, codingPath: codingPath))
+        }
+    }
+    
+    mutating func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> where NestedKey : CodingKey {
+        if owner.column(for: key) != nil {
+            owner.setNestedContainerError(codingPath: [key])
+        }
+        return KeyedEncodingContainer(_DiscardingKeyedContainer<NestedKey>(codingPath: [key]))
+    }
+    
+    mutating func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        if owner.column(for: key) != nil {
+            owner.setNestedContainerError(codingPath: [key])
+        }
+        return _DiscardingUnkeyedContainer(codingPath: [key])
+    }
+    
+    mutating func superEncoder() -> Encoder {
+        return _DiscardingEncoder(codingPath: [])
+    }
+    
+    mutating func superEncoder(forKey key: Key) -> Encoder {
+        guard let column = owner.column(for: key) else {
+            return _DiscardingEncoder(codingPath: [key])
+        }
+        return _ColumnEncoder(owner: owner, column: column, codingPath: [key])
+    }
+}
+
+/// An encoder used to encode a custom `Encodable` value into a single column.
+fileprivate struct _ColumnEncoder : Encoder, SingleValueEncodingContainer {
+    let owner: RSDDelimiterSeparatedEncoder
+    let column: Int
+    let codingPath: [CodingKey]
+    
+    var userInfo: [CodingUserInfoKey : Any] {
+        return [.factory : owner.factory]
+    }
+    
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key : CodingKey {
+        owner.setNestedContainerError(codingPath: codingPath)
+        return KeyedEncodingContainer(_DiscardingKeyedContainer<Key>(codingPath: codingPath))
+    }
+    
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        owner.setNestedContainerError(codingPath: codingPath)
+        return _DiscardingUnkeyedContainer(codingPath: codingPath)
+    }
+    
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        return self
+    }
+    
+    private func set(_ string: String) {
+        owner.setValue(string, at: column, codingPath: codingPath)
+    }
+    
+    private func set<T : FixedWidthInteger>(_ value: T) {
+        owner.setValue(value, at: column, codingPath: codingPath)
+    }
+    
+    mutating func encodeNil() throws { set("<null>") }
+    mutating func encode(_ value: Bool) throws { owner.setValue(value, at: column, codingPath: codingPath) }
+    mutating func encode(_ value: String) throws { set(value) }
+    mutating func encode(_ value: Double) throws { owner.setValue(value, at: column, codingPath: codingPath) }
+    mutating func encode(_ value: Float) throws { owner.setValue(value, at: column, codingPath: codingPath) }
+    mutating func encode(_ value: Int) throws { set(value) }
+    mutating func encode(_ value: Int8) throws { set(value) }
+    mutating func encode(_ value: Int16) throws { set(value) }
+    mutating func encode(_ value: Int32) throws { set(value) }
+    mutating func encode(_ value: Int64) throws { set(value) }
+    mutating func encode(_ value: UInt) throws { set(value) }
+    mutating func encode(_ value: UInt8) throws { set(value) }
+    mutating func encode(_ value: UInt16) throws { set(value) }
+    mutating func encode(_ value: UInt32) throws { set(value) }
+    mutating func encode(_ value: UInt64) throws { set(value) }
+    
+    mutating func encode<T>(_ value: T) throws where T : Encodable {
+        if let string = owner.string(from: value, codingPath: codingPath) {
+            set(string)
+        } else {
+            try value.encode(to: self)
+        }
+    }
+}
+
+// MARK: Discarding containers
+//
+// These containers are shared with `RSDColumnarSampleEncoder`.
+
+/// An encoder that ignores all values. This is used for keys that are not included in the table.
+internal struct _DiscardingEncoder : Encoder {
+    let codingPath: [CodingKey]
+    
+    var userInfo: [CodingUserInfoKey : Any] {
+        return [:]
+    }
+    
+    func container<Key>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> where Key : CodingKey {
+        return KeyedEncodingContainer(_DiscardingKeyedContainer<Key>(codingPath: codingPath))
+    }
+    
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        return _DiscardingUnkeyedContainer(codingPath: codingPath)
+    }
+    
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        return _DiscardingSingleValueContainer(codingPath: codingPath)
+    }
+}
+
+internal struct _DiscardingKeyedContainer<Key : CodingKey> : KeyedEncodingContainerProtocol {
+    let codingPath: [CodingKey]
+    
+    mutating func encodeNil(forKey key: Key) throws {}
+    mutating func encode(_ value: Bool, forKey key: Key) throws {}
+    mutating func encode(_ value: String, forKey key: Key) throws {}
+    mutating func encode(_ value: Double, forKey key: Key) throws {}
+    mutating func encode(_ value: Float, forKey key: Key) throws {}
+    mutating func encode(_ value: Int, forKey key: Key) throws {}
+    mutating func encode(_ value: Int8, forKey key: Key) throws {}
+    mutating func encode(_ value: Int16, forKey key: Key) throws {}
+    mutating func encode(_ value: Int32, forKey key: Key) throws {}
+    mutating func encode(_ value: Int64, forKey key: Key) throws {}
+    mutating func encode(_ value: UInt, forKey key: Key) throws {}
+    mutating func encode(_ value: UInt8, forKey key: Key) throws {}
+    mutating func encode(_ value: UInt16, forKey key: Key) throws {}
+    mutating func encode(_ value: UInt32, forKey key: Key) throws {}
+    mutating func encode(_ value: UInt64, forKey key: Key) throws {}
+    mutating func encode<T>(_ value: T, forKey key: Key) throws where T : Encodable {}
+    
+    mutating func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> where NestedKey : CodingKey {
+        return KeyedEncodingContainer(_DiscardingKeyedContainer<NestedKey>(codingPath: codingPath + [key]))
+    }
+    
+    mutating func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+        return _DiscardingUnkeyedContainer(codingPath: codingPath + [key])
+    }
+    
+    mutating func superEncoder() -> Encoder {
+        return _DiscardingEncoder(codingPath: codingPath)
+    }
+    
+    mutating func superEncoder(forKey key: Key) -> Encoder {
+        return _DiscardingEncoder(codingPath: codingPath + [key])
+    }
+}
+
+internal struct _DiscardingUnkeyedContainer : UnkeyedEncodingContainer {
+    let codingPath: [CodingKey]
+    var count: Int = 0
+    
+    init(codingPath: [CodingKey]) {
+        self.codingPath = codingPath
+    }
+    
+    mutating func encodeNil() throws { count += 1 }
+    mutating func encode(_ value: Bool) throws { count += 1 }
+    mutating func encode(_ value: String) throws { count += 1 }
+    mutating func encode(_ value: Double) throws { count += 1 }
+    mutating func encode(_ value: Float) throws { count += 1 }
+    mutating func encode(_ value: Int) throws { count += 1 }
+    mutating func encode(_ value: Int8) throws { count += 1 }
+    mutating func encode(_ value: Int16) throws { count += 1 }
+    mutating func encode(_ value: Int32) throws { count += 1 }
+    mutating func encode(_ value: Int64) throws { count += 1 }
+    mutating func encode(_ value: UInt) throws { count += 1 }
+    mutating func encode(_ value: UInt8) throws { count += 1 }
+    mutating func encode(_ value: UInt16) throws { count += 1 }
+    mutating func encode(_ value: UInt32) throws { count += 1 }
+    mutating func encode(_ value: UInt64) throws { count += 1 }
+    mutating func encode<T>(_ value: T) throws where T : Encodable { count += 1 }
+    
+    mutating func nestedContainer<NestedKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> where NestedKey : CodingKey {
+        count += 1
+        return KeyedEncodingContainer(_DiscardingKeyedContainer<NestedKey>(codingPath: codingPath))
+    }
+    
+    mutating func nestedUnkeyedContainer() -> UnkeyedEncodingContainer {
+        count += 1
+        return _DiscardingUnkeyedContainer(codingPath: codingPath)
+    }
+    
+    mutating func superEncoder() -> Encoder {
+        return _DiscardingEncoder(codingPath: codingPath)
+    }
+}
+
+internal struct _DiscardingSingleValueContainer : SingleValueEncodingContainer {
+    let codingPath: [CodingKey]
+    
+    mutating func encodeNil() throws {}
+    mutating func encode(_ value: Bool) throws {}
+    mutating func encode(_ value: String) throws {}
+    mutating func encode(_ value: Double) throws {}
+    mutating func encode(_ value: Float) throws {}
+    mutating func encode(_ value: Int) throws {}
+    mutating func encode(_ value: Int8) throws {}
+    mutating func encode(_ value: Int16) throws {}
+    mutating func encode(_ value: Int32) throws {}
+    mutating func encode(_ value: Int64) throws {}
+    mutating func encode(_ value: UInt) throws {}
+    mutating func encode(_ value: UInt8) throws {}
+    mutating func encode(_ value: UInt16) throws {}
+    mutating func encode(_ value: UInt32) throws {}
+    mutating func encode(_ value: UInt64) throws {}
+    mutating func encode<T>(_ value: T) throws where T : Encodable {}
+}
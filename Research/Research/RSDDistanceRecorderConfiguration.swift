@@ -54,7 +54,7 @@ import Foundation
 public struct RSDDistanceRecorderConfiguration : RSDRecorderConfiguration, Codable {
     
     private enum CodingKeys : String, CodingKey, CaseIterable {
-        case identifier, type, motionStepIdentifier, startStepIdentifier, stopStepIdentifier, usesCSVEncoding
+        case identifier, type, motionStepIdentifier, startStepIdentifier, stopStepIdentifier, usesCSVEncoding, contentEncoding
     }
     
     /// A short string that uniquely identifies the asynchronous action within the task. If started
@@ -79,6 +79,10 @@ public struct RSDDistanceRecorderConfiguration : RSDRecorderConfiguration, Codab
     /// Set the flag to `true` to encode the samples as a CSV file.
     public var usesCSVEncoding : Bool?
     
+    /// The content encoding to use to compress the file as it is written. If `nil`, then the file is
+    /// not compressed.
+    public var contentEncoding : RSDContentEncoding?
+    
     /// Default initializer.
     /// - parameters:
     ///     - identifier: The configuration identifier.
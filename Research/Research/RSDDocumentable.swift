@@ -115,6 +115,7 @@ public struct RSDDocumentCreator {
             RSDWebViewUIActionObject.self,
             RSDVideoViewUIActionObject.self,
             RSDWeeklyScheduleObject.self,
+            RSDWindowedFeaturesResultObject.self,
             ]
         
         return allCodableObjects
@@ -122,17 +122,15 @@
         return stringValue;
     }
     
-    // Check if the string needs to be zero padded.
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:@"^[1-3]:" options:0 error:nil];
-    NSUInteger matches = [regex numberOfMatchesInString:stringValue
-                                                options:(NSMatchingOptions)0
-                                                  range:NSMakeRange(0, [stringValue length])];
-    if (matches > 0) {
-        return [NSString stringWithFormat:@"0%@", stringValue];
-    }
-    else {
-        return stringValue;
+    // Check if the string needs to be zero padded. This is equivalent to matching "^[1-3]:" but
+    // without allocating a regular expression for every call.
+    if ((stringValue.length >= 2) && ([stringValue characterAtIndex:1] == ':')) {
+        unichar firstChar = [stringValue characterAtIndex:0];
+        if ((firstChar >= '1') && (firstChar <= '3')) {
+            return [@"0" stringByAppendingString:stringValue];
+        }
     }
+    return stringValue;
 }
 
 - (BOOL)getObjectValue:(out id  _Nullable __autoreleasing *)obj forString:(NSString *)string errorDescription:(out NSString *__autoreleasing  _Nullable *)error {
@@ -156,50 +154,117 @@
         }
     }
     
-    __block NSMeasurement *measurement = nil;
-    
     // Check to see if the string can be separated into components using positional formatting.
     // Note: This is only tested for US English. syoung 02/01/2018
-    NSArray *components = [string componentsSeparatedByString:@":"];
-    if (components.count > 1) {
-        NSMutableArray <NSUnitDuration *> * allowedUnits = [NSMutableArray new];
-        if ((self.allowedUnits & NSCalendarUnitHour) != 0) {
-            [allowedUnits addObject: NSUnitDuration.hours];
-        }
-        if ((self.allowedUnits & NSCalendarUnitMinute) != 0) {
-            [allowedUnits addObject: NSUnitDuration.minutes];
-        }
-        if ((self.allowedUnits & NSCalendarUnitSecond) != 0) {
-            [allowedUnits addObject: NSUnitDuration.seconds];
+    if ([string rangeOfString:@":"].location != NSNotFound) {
+        NSMeasurement *measurement = [self positionalMeasurementFromString:string];
+        if (measurement) {
+            *obj = measurement;
         }
-        measurement = [[NSMeasurement alloc] initWithDoubleValue:0 unit:self.fromStringUnit];
-        [allowedUnits enumerateObjectsUsingBlock:^(NSUnitDuration * _Nonnull unit, NSUInteger idx, BOOL * _Nonnull stop) {
-            if (idx < components.count) {
-                NSString *numberString = components[idx];
-                NSNumber *number = [self.numberFormatter numberFromString:numberString];
-                if (number != nil) {
-                    NSMeasurement *part = [[NSMeasurement alloc] initWithDoubleValue:[number doubleValue] unit:unit];
-                    measurement = [measurement measurementByAddingMeasurement:part] ? : part;
-                }
-            }
-        }];
-    } else {
-        // If not a positional string separated by components then use the measurement wrapper.
-        measurement = [RSDMeasurementWrapper measurementFromString:string withFormatter:self];
+        return (measurement != nil);
     }
     
+    // If not a positional string separated by components then use the measurement wrapper.
+    NSMeasurement *measurement = [RSDMeasurementWrapper measurementFromString:string withFormatter:self];
     if (measurement) {
         *obj = measurement;
     }
     return (measurement != nil);
 }
 
+/// Scan a positional string (for example, "1:02:30") by assigning each component to the allowed hour,
+/// minute, and second units in order, and accumulating the total as seconds.
+- (NSMeasurement * _Nullable)positionalMeasurementFromString:(NSString *)string {
+    
+    NSUnitDuration *units[3];
+    double secondsPerUnit[3];
+    NSUInteger unitCount = 0;
+    if ((self.allowedUnits & NSCalendarUnitHour) != 0) {
+        units[unitCount] = NSUnitDuration.hours;
+        secondsPerUnit[unitCount++] = 3600;
+    }
+    if ((self.allowedUnits & NSCalendarUnitMinute) != 0) {
+        units[unitCount] = NSUnitDuration.minutes;
+        secondsPerUnit[unitCount++] = 60;
+    }
+    if ((self.allowedUnits & NSCalendarUnitSecond) != 0) {
+        units[unitCount] = NSUnitDuration.seconds;
+        secondsPerUnit[unitCount++] = 1;
+    }
+    
+    NSString *decimalSeparator = self.numberFormatter.decimalSeparator;
+    unichar decimalChar = (decimalSeparator.length == 1) ? [decimalSeparator characterAtIndex:0] : '.';
+    
+    NSUnitDuration *fromStringUnit = self.fromStringUnit;
+    BOOL allFromStringUnit = YES;
+    double seconds = 0;
+    
+    CFIndex length = (CFIndex)string.length;
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer((__bridge CFStringRef)string, &buffer, CFRangeMake(0, length));
+    
+    CFIndex start = 0;
+    for (NSUInteger idx = 0; (idx < unitCount) && (start <= length); idx++) {
+        
+        // Scan the component as a decimal number.
+        double mantissa = 0;
+        double divisor = 1;
+        BOOL hasDigits = NO;
+        BOOL hasDecimal = NO;
+        BOOL isSimple = YES;
+        CFIndex end = start;
+        for (; end < length; end++) {
+            UniChar ch = CFStringGetCharacterFromInlineBuffer(&buffer, end);
+            if (ch == ':') {
+                break;
+            } else if ((ch >= '0') && (ch <= '9')) {
+                mantissa = mantissa * 10 + (ch - '0');
+                if (hasDecimal) { divisor *= 10; }
+                hasDigits = YES;
+            } else if ((ch == decimalChar) && !hasDecimal) {
+                hasDecimal = YES;
+            } else {
+                isSimple = NO;
+            }
+        }
+        
+        double value = mantissa / divisor;
+        BOOL hasValue = hasDigits;
+        if (!isSimple) {
+            // Fall back to the number formatter for anything other than digits and a decimal.
+            NSString *numberString = [string substringWithRange:NSMakeRange(start, end - start)];
+            NSNumber *number = [self.numberFormatter numberFromString:numberString];
+            hasValue = (number != nil);
+            value = [number doubleValue];
+        }
+        
+        if (hasValue) {
+            seconds += value * secondsPerUnit[idx];
+            allFromStringUnit = allFromStringUnit && [units[idx] isEqual:fromStringUnit];
+        }
+        start = end + 1;
+    }
+    
+    // Return the value in the `fromStringUnit` if that is the only unit used. Otherwise, return the value
+    // in seconds. This matches the units returned by `-measurementByAddingMeasurement:`.
+    if (allFromStringUnit) {
+        double value = [fromStringUnit.converter valueFromBaseUnitValue:seconds];
+        return [[NSMeasurement alloc] initWithDoubleValue:value unit:fromStringUnit];
+    } else {
+        return [[NSMeasurement alloc] initWithDoubleValue:seconds unit:NSUnitDuration.seconds];
+    }
+}
+
 - (NSMeasurement *)measurementForNumber:(NSNumber *)number unit:(NSString *)unitString {
-    NSUnitDuration *unit = [self unitForString:unitString] ? : self.fromStringUnit;
+    NSUnitDuration *unit = [self dimensionForUnitString:unitString];
     double measurementValue = [number doubleValue];
     return [[NSMeasurement alloc] initWithDoubleValue:measurementValue unit:unit];
 }
 
+- (NSUnitDuration *)dimensionForUnitString:(NSString *)unitString {
+    return [self unitForString:unitString] ? : self.fromStringUnit;
+}
+
 - (NSUnitDuration *)unitForString:(NSString *)string {
     NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
     if (trimmedString.length == 0) {
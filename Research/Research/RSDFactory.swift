@@ -59,6 +59,10 @@ open class RSDFactory {
         #endif
     }()
     
+    /// The cached JSON coders used by `withJSONEncoder(outputFormat:_:)`, `withJSONDecoder(bundle:taskIdentifier:schemaInfo:_:)`
+    /// and `createEncodingSession(outputFormat:)`.
+    internal let coderCache = RSDJSONCoderCache()
+    
     // Initializer
     public init() {
     }
@@ -120,6 +124,12 @@ open class RSDFactory {
     /// - throws: `DecodingError` if the object cannot be decoded.
     /// - seealso: `RSDTaskResourceTransformer`
     open func decodeTask(with data: Data, resourceType: RSDResourceType, typeName: String? = nil, taskIdentifier: String? = nil, schemaInfo: RSDSchemaInfo? = nil, bundle: Bundle? = nil) throws -> RSDTask {
+        // JSON is decoded using a decoder from the coder cache rather than creating a new decoder.
+        if resourceType == .json {
+            return try withJSONDecoder(bundle: bundle, taskIdentifier: taskIdentifier, schemaInfo: schemaInfo) {
+                try decodeTask(with: data, from: $0)
+            }
+        }
         let decoder = try createDecoder(for: resourceType, taskIdentifier: taskIdentifier, schemaInfo: schemaInfo, bundle: bundle)
         return try decodeTask(with: data, from: decoder)
     }
@@ -766,6 +776,8 @@ open class RSDFactory {
             return try RSDTaskResultObject(from: decoder)
         case .file:
             return try RSDFileResultObject(from: decoder)
+        case .windowedFeatures:
+            return try RSDWindowedFeaturesResultObject(from: decoder)
         default:
             throw RSDValidationError.undefinedClassType("\(self) does not support `\(resultType)` as a decodable class type for a result.")
         }
@@ -822,10 +834,12 @@ open class RSDFactory {
     /// to use when decoding this object.
     open func createJSONDecoder(bundle: Bundle? = nil) -> JSONDecoder {
         let decoder = JSONDecoder()
+        // The strategy uses the factory from the user info rather than capturing `self` so that a
+        // decoder held by the factory's coder cache does not retain the factory.
         decoder.dateDecodingStrategy = .custom({ (decoder) -> Date in
             let container = try decoder.singleValueContainer()
             let string = try container.decode(String.self)
-            return try self.decodeDate(from: string, formatter: nil, codingPath: decoder.codingPath)
+            return try decoder.factory.decodeDate(from: string, formatter: nil, codingPath: decoder.codingPath)
         })
         decoder.userInfo[.factory] = self
         decoder.userInfo[.bundle] = bundle
@@ -894,7 +908,32 @@ open class RSDFactory {
     open func decodeDate(from string: String, formatter: DateFormatter? = nil) -> Date? {
         if let dateFormatter = formatter, let date = dateFormatter.date(from: string) {
             return date
-        } else if let date = timestampFormatter.date(from: string) {
+        }
+        
+        // If the factory uses the default timestamp formatter then look at the shape of the string to
+        // parse timestamps directly and to select the formatter for date-only and time-only strings.
+        if timestampFormatter === rsd_ISO8601TimestampFormatter {
+            switch RSDISO8601Shape(string) {
+            case .timestamp(let date):
+                return date
+            case .dateOnly:
+                if let date = dateOnlyFormatter.date(from: string) {
+                    return date
+                }
+            case .timeOnly:
+                if let date = timeOnlyFormatter.date(from: string) {
+                    return date
+                }
+            case .timeOnlyWithoutFraction:
+                if let date = _oldTimeOnlyFormatter.date(from: string) {
+                    return date
+                }
+            case .unknown:
+                break
+            }
+        }
+        
+        if let date = timestampFormatter.date(from: string) {
             return date
         } else if let date = dateOnlyFormatter.date(from: string) {
             return date
@@ -905,25 +944,31 @@ open class RSDFactory {
         } else if let date = _androidTimestampFormatter.date(from: string) {
             return date
         } else {
-            return ISO8601DateFormatter().date(from: string)
+            return _iso8601Formatter.date(from: string)
         }
     }
     
     /// syoung 11/06/2019 Discovered that this format does not match the format being used on Bridge.
     private lazy var _oldTimeOnlyFormatter: DateFormatter = {
-        var formatter = rsd_ISO8601TimeOnlyFormatter
+        let formatter = DateFormatter()
         formatter.dateFormat = "HH:mm:ss"
+        formatter.locale = Locale(identifier: "en_US_POSIX")
         return formatter
     }()
     
     /// syoung 11/06/2019 Older Android devices do not support the timestamp formatter that we are
     /// using on iOS. Therefore, check the formatter for dates decoded from Android.
     private lazy var _androidTimestampFormatter: DateFormatter = {
-        var formatter = rsd_ISO8601TimeOnlyFormatter
+        let formatter = DateFormatter()
         formatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSSZ"
+        formatter.locale = Locale(identifier: "en_US_POSIX")
         return formatter
     }()
     
+    /// The last formatter checked when decoding a date. This is a constant so that it is created once
+    /// rather than lazily, which is not thread-safe.
+    private let _iso8601Formatter = ISO8601DateFormatter()
+    
     internal func decodeDate(from string: String, formatter: DateFormatter?, codingPath: [CodingKey]) throws -> Date {
         guard let date = decodeDate(from: string, formatter: formatter) else {
             let context = DecodingError.Context(codingPath: codingPath, debugDescription: "Could not decode \(string) into a date.")
@@ -938,8 +983,10 @@ open class RSDFactory {
     /// to use when encoding objects.
     open func createJSONEncoder() -> JSONEncoder {
         let encoder = JSONEncoder()
+        // The strategies use the factory from the user info rather than capturing `self` so that an
+        // encoder held by the factory's coder cache does not retain the factory.
         encoder.dateEncodingStrategy = .custom({ (date, encoder) in
-            let string = self.encodeString(from: date, codingPath: encoder.codingPath)
+            let string = encoder.factory.encodeString(from: date, codingPath: encoder.codingPath)
             var container = encoder.singleValueContainer()
             try container.encode(string)
         })
@@ -950,7 +997,7 @@ open class RSDFactory {
                                                                         negativeInfinity: nonConformingCodingStrategy.negativeInfinity,
                                                                         nan: nonConformingCodingStrategy.nan)
         encoder.dataEncodingStrategy = .custom({ (data, encoder) in
-            let string = self.encodeString(from: data, codingPath: encoder.codingPath)
+            let string = encoder.factory.encodeString(from: data, codingPath: encoder.codingPath)
             var container = encoder.singleValueContainer()
             try container.encode(string)
         })
@@ -969,7 +1016,12 @@ open class RSDFactory {
     /// Overridable method for encoding a date to a string. By default, this method uses the `timestampFormatter`
     /// as the date formatter.
     open func encodeString(from date: Date, codingPath: [CodingKey]) -> String {
-        return timestampFormatter.string(from: date)
+        let formatter = timestampFormatter
+        if formatter === rsd_ISO8601TimestampFormatter,
+            let string = rsd_ISO8601TimestampString(from: date, timeZone: formatter.timeZone ?? TimeZone.current) {
+            return string
+        }
+        return formatter.string(from: date)
     }
     
     /// Overridable method for encoding data to a string. By default, this method uses base64 encoding.
@@ -1019,7 +1071,7 @@ extension Decoder {
     
     /// The factory to use when decoding.
     public var factory: RSDFactory {
-        return self.userInfo[.factory] as? RSDFactory ?? RSDFactory.shared
+        return RSDFactory.factory(from: self.userInfo) ?? RSDFactory.shared
     }
     
     /// The task info to use when decoding if there isn't a local task info defined on the object.
@@ -1062,7 +1114,7 @@ extension Encoder {
     
     /// The factory to use when encoding.
     public var factory: RSDFactory {
-        return self.userInfo[.factory] as? RSDFactory ?? RSDFactory.shared
+        return RSDFactory.factory(from: self.userInfo) ?? RSDFactory.shared
     }
     
     /// The task info to use when encoding.
@@ -62,6 +62,10 @@ public struct RSDFileManifest : Codable, Hashable, Equatable {
     /// The content type of the file.
     public let contentType: String?
     
+    /// The content encoding of the file. If this is not `nil`, then the file is already compressed and
+    /// should be stored in an archive without being compressed again.
+    public let contentEncoding: String?
+    
     /// The identifier for the result. This value may *not* be unique if a step is run more than once
     /// during a task at different stages.
     public let identifier: String?
@@ -70,10 +74,11 @@ public struct RSDFileManifest : Codable, Hashable, Equatable {
     public let stepPath: String?
     
     /// Default initializer.
-    public init(filename: String, timestamp: Date, contentType: String?, identifier: String? = nil, stepPath: String? = nil) {
+    public init(filename: String, timestamp: Date, contentType: String?, contentEncoding: String? = nil, identifier: String? = nil, stepPath: String? = nil) {
         self.filename = filename
         self.timestamp = timestamp
         self.contentType = contentType
+        self.contentEncoding = contentEncoding
         self.identifier = identifier
         self.stepPath = stepPath
     }
@@ -54,16 +54,25 @@ public protocol RSDFileResult : RSDResult, RSDArchivable {
     /// - example: `"application/json"`
     var contentType: String? { get }
     
+    /// The content encoding of the file if the file was compressed when it was written.
+    /// - example: `"gzip"`
+    var contentEncoding: String? { get }
+    
     /// The system clock uptime when the recorder was started (if applicable).
     var startUptime: TimeInterval? { get }
 }
 
 extension RSDFileResult {
     
+    /// By default, the file is not compressed.
+    public var contentEncoding: String? {
+        return nil
+    }
+    
     /// Build the archiveable or uploadable data for this result.
     public func buildArchiveData(at stepPath: String?) throws -> (manifest: RSDFileManifest, data: Data)? {
         guard let filename = self.relativePath, let url = self.url else { return nil }
-        let manifest = RSDFileManifest(filename: filename, timestamp: self.startDate, contentType: self.contentType, identifier: self.identifier, stepPath: stepPath)
+        let manifest = RSDFileManifest(filename: filename, timestamp: self.startDate, contentType: self.contentType, contentEncoding: self.contentEncoding, identifier: self.identifier, stepPath: stepPath)
         let data = try Data(contentsOf: url)
         return (manifest, data)
     }
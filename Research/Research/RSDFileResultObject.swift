@@ -68,8 +68,11 @@ public struct RSDFileResultObject : RSDFileResult, Codable {
     /// The MIME content type of the result.
     public var contentType: String?
     
+    /// The content encoding of the file (if the file is compressed).
+    public var contentEncoding: String?
+    
     private enum CodingKeys : String, CodingKey, CaseIterable {
-        case identifier, type, startDate, endDate, startUptime, relativePath, contentType
+        case identifier, type, startDate, endDate, startUptime, relativePath, contentType, contentEncoding
     }
     
     /// Default initializer for this object.
@@ -41,11 +41,43 @@ typedef struct {
     NSInteger denominator;
 } RSDFraction;
 
+/// The default tolerance used when approximating a number as a fraction.
+FOUNDATION_EXPORT const double RSDFractionDefaultTolerance;
+
+/// The default maximum denominator used when approximating a number as a fraction.
+FOUNDATION_EXPORT const NSInteger RSDFractionDefaultMaximumDenominator;
+
+/// Returns the simplest fraction that is within the given tolerance of the value, using a continued
+/// fraction expansion. If no fraction with a denominator less than or equal to the maximum is within the
+/// tolerance, then the closest fraction with a denominator less than or equal to the maximum is returned.
+///
+/// NaN is returned as `0/0` and infinity is returned as `1/0` or `-1/0`.
+///
+/// @param  value           The value to approximate.
+/// @param  maxDenominator  The maximum denominator.
+/// @param  tolerance       The tolerance.
+/// @return                 The fraction that represents this value.
+FOUNDATION_EXPORT RSDFraction RSDFractionFromDouble(double value, NSInteger maxDenominator, double tolerance);
+
+/// Convert an array of values to fractions in a single pass.
+///
+/// @param  values          A contiguous buffer of values to approximate.
+/// @param  fractions       The output buffer. Must have room for `count` fractions.
+/// @param  count           The number of values.
+/// @param  maxDenominator  The maximum denominator.
+/// @param  tolerance       The tolerance.
+FOUNDATION_EXPORT void RSDFractionsFromDoubles(const double *values, RSDFraction *fractions, NSUInteger count, NSInteger maxDenominator, double tolerance);
+
 @interface NSNumber (RSDFraction)
 
 /// @return  The fraction that represents this number.
 - (RSDFraction)fractionalValue;
 
+/// @param  maxDenominator  The maximum denominator.
+/// @param  tolerance       The tolerance.
+/// @return                 The fraction that represents this number.
+- (RSDFraction)fractionalValueWithMaximumDenominator:(NSInteger)maxDenominator tolerance:(double)tolerance;
+
 @end
 
 /// `RSDFractionFormatter` is a custom subclass of the `NSFormatter` that can convert a number to a string
@@ -62,6 +94,12 @@ typedef struct {
 
 @property (null_resettable, copy, nonatomic) NSString *fractionSeparator;
 
+/// The maximum denominator to use when converting a number to a fraction. Default = 1,000,000.
+@property (nonatomic) NSInteger maximumDenominator;
+
+/// The tolerance to use when converting a number to a fraction. Default = 0.00001.
+@property (nonatomic) double tolerance;
+
 - (NSNumber * _Nullable)numberFromString:(NSString *)string;
 
 - (NSString * _Nullable)stringFromNumber:(NSNumber *)number;
@@ -34,68 +34,202 @@
 #import "RSDFractionFormatter.h"
 #import <objc/runtime.h>
 
-@implementation NSNumber (RSDFraction)
+const double RSDFractionDefaultTolerance = 0.00001;
+const NSInteger RSDFractionDefaultMaximumDenominator = 1000000;
 
-- (RSDFraction)fractionalValue {
+/// The largest denominator included in the table of common fractions.
+#define RSD_COMMON_FRACTION_MAX_DENOMINATOR 16
+
+typedef struct {
+    double value;
+    RSDFraction fraction;
+} RSDCommonFraction;
+
+static NSInteger RSDGreatestCommonDivisor(NSInteger a, NSInteger b) {
+    while (b != 0) {
+        NSInteger t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/// Build a sorted table of the reduced fractions between 0 and 1 with denominators from halves through
+/// sixteenths.
+static const RSDCommonFraction * RSDCommonFractions(NSUInteger *count) {
+    static RSDCommonFraction table[RSD_COMMON_FRACTION_MAX_DENOMINATOR * RSD_COMMON_FRACTION_MAX_DENOMINATOR];
+    static NSUInteger tableCount = 0;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        for (NSInteger dd = 2; dd <= RSD_COMMON_FRACTION_MAX_DENOMINATOR; dd++) {
+            for (NSInteger nn = 1; nn < dd; nn++) {
+                if (RSDGreatestCommonDivisor(nn, dd) != 1) { continue; }
+                // Insertion sort since the table is small and only built once.
+                double value = (double)nn / (double)dd;
+                NSUInteger idx = tableCount;
+                while ((idx > 0) && (table[idx - 1].value > value)) {
+                    table[idx] = table[idx - 1];
+                    idx--;
+                }
+                table[idx].value = value;
+                table[idx].fraction.numerator = nn;
+                table[idx].fraction.denominator = dd;
+                tableCount++;
+            }
+        }
+    });
+    *count = tableCount;
+    return table;
+}
+
+/// Look up the fractional part of a number in the table of common fractions. This is only valid if the
+/// tolerance is small enough that there is at most one common fraction within the tolerance.
+static BOOL RSDLookupCommonFraction(double x, NSInteger maxDenominator, double tolerance, RSDFraction *fraction) {
+    if ((maxDenominator < RSD_COMMON_FRACTION_MAX_DENOMINATOR) ||
+        (tolerance * 2 * RSD_COMMON_FRACTION_MAX_DENOMINATOR * RSD_COMMON_FRACTION_MAX_DENOMINATOR >= 1)) {
+        return NO;
+    }
+    NSUInteger count;
+    const RSDCommonFraction *table = RSDCommonFractions(&count);
+    NSUInteger lower = 0;
+    NSUInteger upper = count;
+    while (lower < upper) {
+        NSUInteger middle = (lower + upper) / 2;
+        if (table[middle].value < x) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+    if ((lower < count) && (fabs(table[lower].value - x) <= tolerance)) {
+        *fraction = table[lower].fraction;
+        return YES;
+    } else if ((lower > 0) && (fabs(table[lower - 1].value - x) <= tolerance)) {
+        *fraction = table[lower - 1].fraction;
+        return YES;
+    }
+    return NO;
+}
+
+RSDFraction RSDFractionFromDouble(double value, NSInteger maxDenominator, double tolerance) {
     
     RSDFraction fraction;
     
-    if ([self isEqual: [NSDecimalNumber notANumber]]) {
+    if (isnan(value)) {
         fraction.numerator = 0;
         fraction.denominator = 0;
         return fraction;
-    } else if (self.doubleValue == INFINITY) {
-        fraction.numerator = 1;
-        fraction.denominator = 0;
-        return fraction;
-    } else if (self.doubleValue == -1 * INFINITY) {
-        fraction.numerator = -1;
+    } else if (isinf(value)) {
+        fraction.numerator = (value > 0) ? 1 : -1;
         fraction.denominator = 0;
         return fraction;
     }
     
-    double accuracy = 0.00001;
-    double x = self.doubleValue;
-    double n = floor(x);
-    x -= n;
-
-    if (x < accuracy) {
+    maxDenominator = MAX(maxDenominator, 1);
+    double n = floor(value);
+    double x = value - n;
+    
+    if (x <= tolerance) {
         fraction.numerator = (NSInteger)n;
         fraction.denominator = 1;
         return fraction;
-    } else if ((1 - accuracy) < x) {
+    } else if ((1 - tolerance) <= x) {
         fraction.numerator = (NSInteger)(n + 1);
         fraction.denominator = 1;
         return fraction;
     }
     
-    double lower_n = 0;
-    double lower_d = 1;
-    double upper_n = 1;
-    double upper_d = 1;
-    int loopCount = 0;
+    RSDFraction common;
+    if (RSDLookupCommonFraction(x, maxDenominator, tolerance, &common)) {
+        fraction.numerator = (NSInteger)n * common.denominator + common.numerator;
+        fraction.denominator = common.denominator;
+        return fraction;
+    }
+    
+    // Walk the convergents p(k)/q(k) of the continued fraction for x. When a convergent is within the
+    // tolerance, back up to the smallest semiconvergent that is also within the tolerance. This is the
+    // same fraction that a Stern-Brocot search would find, but in O(log q) steps.
+    double p0 = 0, q0 = 1;      // p(k-2)/q(k-2)
+    double p1 = 1, q1 = 0;      // p(k-1)/q(k-1)
+    double remainder = x;
+    double bestP = 0, bestQ = 1;
     
-    while (loopCount++ < 1000) {
-        double middle_n = lower_n + upper_n;
-        double middle_d = lower_d + upper_d;
-        if (middle_d * (x + accuracy) < middle_n) {
-            upper_n = middle_n;
-            upper_d = middle_d;
-        } else if (middle_n < (x - accuracy) * middle_d) {
-            lower_n = middle_n;
-            lower_d = middle_d;
-        } else {
-            fraction.numerator = (NSInteger)(n * middle_d + middle_n);
-            fraction.denominator = (NSInteger)middle_d;
-            return fraction;
+    while (true) {
+        double a = floor(remainder);
+        double p2 = a * p1 + p0;
+        double q2 = a * q1 + q0;
+        
+        if ((q2 > maxDenominator) || (fabs(x - p2 / q2) <= tolerance)) {
+            // Find the smallest multiplier for the semiconvergent that is within the tolerance and the
+            // maximum denominator. The semiconvergents approach x monotonically as the multiplier increases.
+            double lower = 1;
+            double upper = MIN(a, floor((maxDenominator - q0) / q1));
+            if (upper < lower) {
+                // Only the previous convergent is within the maximum denominator.
+                bestP = p1;
+                bestQ = q1;
+                break;
+            }
+            if (fabs(x - (upper * p1 + p0) / (upper * q1 + q0)) > tolerance) {
+                // No semiconvergent is within the tolerance so use the closest of the previous convergent
+                // and the largest allowed semiconvergent.
+                double sp = upper * p1 + p0;
+                double sq = upper * q1 + q0;
+                if (fabs(x - sp / sq) < fabs(x - p1 / q1)) {
+                    bestP = sp;
+                    bestQ = sq;
+                } else {
+                    bestP = p1;
+                    bestQ = q1;
+                }
+                break;
+            }
+            while (lower < upper) {
+                double middle = floor((lower + upper) / 2);
+                if (fabs(x - (middle * p1 + p0) / (middle * q1 + q0)) <= tolerance) {
+                    upper = middle;
+                } else {
+                    lower = middle + 1;
+                }
+            }
+            bestP = upper * p1 + p0;
+            bestQ = upper * q1 + q0;
+            break;
         }
+        
+        p0 = p1; q0 = q1;
+        p1 = p2; q1 = q2;
+        
+        double fractionalPart = remainder - a;
+        if (fractionalPart <= 0) {
+            bestP = p1;
+            bestQ = q1;
+            break;
+        }
+        remainder = 1 / fractionalPart;
     }
     
-    fraction.numerator = 1;
-    fraction.denominator = 0;
+    fraction.numerator = (NSInteger)(n * bestQ + bestP);
+    fraction.denominator = (NSInteger)bestQ;
     return fraction;
 }
 
+void RSDFractionsFromDoubles(const double *values, RSDFraction *fractions, NSUInteger count, NSInteger maxDenominator, double tolerance) {
+    for (NSUInteger ii = 0; ii < count; ii++) {
+        fractions[ii] = RSDFractionFromDouble(values[ii], maxDenominator, tolerance);
+    }
+}
+
+@implementation NSNumber (RSDFraction)
+
+- (RSDFraction)fractionalValue {
+    return RSDFractionFromDouble(self.doubleValue, RSDFractionDefaultMaximumDenominator, RSDFractionDefaultTolerance);
+}
+
+- (RSDFraction)fractionalValueWithMaximumDenominator:(NSInteger)maxDenominator tolerance:(double)tolerance {
+    return RSDFractionFromDouble(self.doubleValue, maxDenominator, tolerance);
+}
+
 @end
 
 @implementation RSDFractionFormatter
@@ -127,8 +261,17 @@
     }
 }
 
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        _maximumDenominator = RSDFractionDefaultMaximumDenominator;
+        _tolerance = RSDFractionDefaultTolerance;
+    }
+    return self;
+}
+
 - (NSString *)stringFromNumber:(NSNumber *)number {
-    RSDFraction fraction = [number fractionalValue];
+    RSDFraction fraction = RSDFractionFromDouble(number.doubleValue, self.maximumDenominator, self.tolerance);
     if (fraction.denominator == 0) {
         return nil;
     } else if (fraction.denominator == 1) {
@@ -136,7 +279,12 @@
     } else {
         NSString *nn = [self.numberFormatter stringFromNumber:@(fraction.numerator)];
         NSString *dd = [self.numberFormatter stringFromNumber:@(fraction.denominator)];
-        return [NSString stringWithFormat:@"%@%@%@", nn, self.fractionSeparator, dd];
+        NSString *separator = self.fractionSeparator;
+        NSMutableString *result = [NSMutableString stringWithCapacity:nn.length + separator.length + dd.length];
+        [result appendString:nn];
+        [result appendString:separator];
+        [result appendString:dd];
+        return result;
     }
 }
 
@@ -186,12 +334,33 @@
     return _numberFormatter;
 }
 
+#pragma mark - coding
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder {
+    self = [super initWithCoder:aDecoder];
+    if (self) {
+        NSString *maxDenominatorKey = NSStringFromSelector(@selector(maximumDenominator));
+        NSString *toleranceKey = NSStringFromSelector(@selector(tolerance));
+        _maximumDenominator = [aDecoder containsValueForKey:maxDenominatorKey] ? [aDecoder decodeIntegerForKey:maxDenominatorKey] : RSDFractionDefaultMaximumDenominator;
+        _tolerance = [aDecoder containsValueForKey:toleranceKey] ? [aDecoder decodeDoubleForKey:toleranceKey] : RSDFractionDefaultTolerance;
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder {
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeInteger:_maximumDenominator forKey:NSStringFromSelector(@selector(maximumDenominator))];
+    [aCoder encodeDouble:_tolerance forKey:NSStringFromSelector(@selector(tolerance))];
+}
+
 #pragma mark - copy
 
 - (id)copyWithZone:(NSZone *)zone {
     RSDFractionFormatter *copy = [[RSDFractionFormatter alloc] init];
     copy->_numberFormatter = _numberFormatter;
     copy->_fractionSeparator = _fractionSeparator;
+    copy->_maximumDenominator = _maximumDenominator;
+    copy->_tolerance = _tolerance;
     return copy;
 }
 
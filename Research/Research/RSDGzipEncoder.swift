@@ -0,0 +1,79 @@
+//
+//  RSDGzipEncoder.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDGzipEncoder` is a streaming encoder that compresses data into the gzip file format (RFC 1952).
+///
+/// The data is compressed using a libz deflate stream that writes the gzip header and trailer so that the
+/// file can be opened using standard tools. Call `encode(_:)` for each chunk of data, and then `finish()`
+/// to get the remaining compressed bytes and the trailer.
+///
+/// - note: The deflate stream holds data in memory until it has enough input to write a compressed
+///         block. The file is not a valid gzip file until `finish()` has been written.
+///
+/// An instance of this class is **not** thread-safe. It is intended to be owned by a single logger.
+internal final class RSDGzipEncoder {
+    
+    private let stream: RSDZlibStream
+    
+    /// The number of uncompressed bytes that have been encoded.
+    private(set) var uncompressedByteCount: UInt64 = 0
+    
+    /// Has the stream been finished?
+    var isFinished: Bool {
+        return stream.isFinished
+    }
+    
+    init() throws {
+        self.stream = try RSDZlibStream(direction: .gzipEncode)
+    }
+    
+    /// Compress a chunk of data.
+    /// - parameter data: The uncompressed data.
+    /// - returns: The compressed bytes that are ready to be written. This may be empty.
+    func encode(_ data: Data) throws -> Data {
+        let output = NSMutableData()
+        try stream.process(data, finish: false, output: output)
+        uncompressedByteCount += UInt64(data.count)
+        return output as Data
+    }
+    
+    /// Finish the stream.
+    /// - returns: The remaining compressed bytes followed by the gzip trailer.
+    func finish() throws -> Data {
+        let output = NSMutableData()
+        try stream.process(Data(), finish: true, output: output)
+        return output as Data
+    }
+}
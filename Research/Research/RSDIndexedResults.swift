@@ -0,0 +1,178 @@
+//
+//  RSDIndexedResults.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDIndexedResults` is an ordered list of results that also maintains a hash index of the result
+/// identifiers. The results keep their insertion order so that they encode in the same order as a plain
+/// array, but lookup by identifier does not need to scan the list. The index is updated incrementally
+/// when a result is appended, replaced, or when the list is truncated.
+///
+/// If more than one result in the list shares the same identifier, then the index points to the *first*
+/// instance to match the behavior of `Array.first(where:)`.
+///
+/// Each result in the list also has a change token that is assigned when the result is added to the list.
+/// The tokens are unique within the process, so a result that is replaced (or removed and added again)
+/// always has a different token. This allows checking whether a result has changed without comparing the
+/// values.
+public struct RSDIndexedResults {
+    
+    /// The ordered list of results.
+    public private(set) var results: [RSDResult]
+    
+    /// A mapping of the result identifier to the index of the first result with that identifier.
+    private var indexMap: [String : Int]
+    
+    /// The change token for each result in `results`.
+    private var changeTokens: [UInt64]
+    
+    /// Initialize with a list of results.
+    /// - parameter results: The ordered list of results. Default = `[]`.
+    public init(_ results: [RSDResult] = []) {
+        self.results = results
+        self.indexMap = Dictionary(minimumCapacity: results.count)
+        self.changeTokens = RSDIndexedResults.makeChangeTokens(count: results.count)
+        for (idx, result) in results.enumerated() where indexMap[result.identifier] == nil {
+            indexMap[result.identifier] = idx
+        }
+    }
+    
+    private static let changeTokenLock = NSLock()
+    private static var nextChangeToken: UInt64 = 1
+    
+    private static func makeChangeTokens(count: Int) -> [UInt64] {
+        guard count > 0 else { return [] }
+        changeTokenLock.lock()
+        defer { changeTokenLock.unlock() }
+        let first = nextChangeToken
+        nextChangeToken += UInt64(count)
+        return (0..<UInt64(count)).map { first + $0 }
+    }
+    
+    /// The number of results in the list.
+    public var count: Int {
+        return results.count
+    }
+    
+    /// Whether or not the list is empty.
+    public var isEmpty: Bool {
+        return results.isEmpty
+    }
+    
+    /// The index of the first result with the given identifier.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The index of the result or `nil` if not found.
+    public func index(of identifier: String) -> Int? {
+        return indexMap[identifier]
+    }
+    
+    /// The change token of the first result with the given identifier.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The change token or `nil` if not found.
+    func changeToken(for identifier: String) -> UInt64? {
+        guard let idx = indexMap[identifier] else { return nil }
+        return changeTokens[idx]
+    }
+    
+    /// Find the first result with the given identifier.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    public func result(with identifier: String) -> RSDResult? {
+        guard let idx = indexMap[identifier] else { return nil }
+        return results[idx]
+    }
+    
+    /// Append the result to the end of the list without removing previous results with the same identifier.
+    /// - parameter result: The result to add to the list.
+    public mutating func append(_ result: RSDResult) {
+        results.append(result)
+        changeTokens.append(contentsOf: RSDIndexedResults.makeChangeTokens(count: 1))
+        if indexMap[result.identifier] == nil {
+            indexMap[result.identifier] = results.count - 1
+        }
+    }
+    
+    /// Append the result to the end of the list, replacing the previous instance with the same identifier.
+    /// - parameter result: The result to add to the list.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    public mutating func appendReplacing(_ result: RSDResult) -> RSDResult? {
+        let previousResult = remove(with: result.identifier)
+        append(result)
+        return previousResult
+    }
+    
+    /// Remove the first result with the given identifier.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The removed result or `nil` if not found.
+    @discardableResult
+    public mutating func remove(with identifier: String) -> RSDResult? {
+        guard let idx = indexMap.removeValue(forKey: identifier) else { return nil }
+        let removed = results.remove(at: idx)
+        changeTokens.remove(at: idx)
+        // Only the results after the removed result need to be shifted. A result is moved down by one if
+        // the index pointed at its old position. If the removed identifier is duplicated later in the list,
+        // then the first of the duplicates becomes the indexed result.
+        var i = idx
+        while i < results.count {
+            let id = results[i].identifier
+            if let current = indexMap[id] {
+                if current == i + 1 {
+                    indexMap[id] = i
+                }
+            }
+            else {
+                indexMap[id] = i
+            }
+            i += 1
+        }
+        return removed
+    }
+    
+    /// Remove the results from the result with the given identifier to the end of the list.
+    /// - parameter identifier: The identifier associated with the first result to remove.
+    /// - returns: The removed results or `nil` if not found.
+    @discardableResult
+    public mutating func removeAll(from identifier: String) -> [RSDResult]? {
+        guard let idx = indexMap[identifier] else { return nil }
+        let removed = Array(results[idx...])
+        results.removeSubrange(idx...)
+        changeTokens.removeSubrange(idx...)
+        for result in removed {
+            if let current = indexMap[result.identifier], current >= idx {
+                indexMap[result.identifier] = nil
+            }
+        }
+        return removed
+    }
+}
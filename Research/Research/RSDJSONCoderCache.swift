@@ -0,0 +1,253 @@
+//
+//  RSDJSONCoderCache.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDJSONCoderCache` is a thread-safe pool of the JSON coders created by an `RSDFactory`. Creating a
+/// `JSONEncoder` or `JSONDecoder` using the factory allocates the coder, its strategy closures and a new
+/// `RSDCodingInfo`. The cache keeps a small number of idle coders so that they can be reused.
+///
+/// A coder is *checked out* of the cache for exclusive use and is *checked in* when it is no longer needed.
+/// Each time a coder is checked out, its user info is reset to the user info set by the factory when the
+/// coder was created with a new `RSDCodingInfo` and any per-use keys. This way, state that is stored in the
+/// coding info while coding one object does not leak into the next.
+///
+/// The factory owns the cache, so the cached coders hold the factory in their user info using a weak
+/// reference rather than retaining it.
+final class RSDJSONCoderCache {
+    
+    /// The maximum number of idle coders to keep for each coder type and output format.
+    static let maxIdleCount = 4
+    
+    struct Checkout<Coder> {
+        let coder: Coder
+        let baseUserInfo: [CodingUserInfoKey : Any]
+    }
+    
+    private let lock = NSLock()
+    private var idleEncoders: [RSDJSONOutputFormat : [Checkout<JSONEncoder>]] = [:]
+    private var idleDecoders: [Checkout<JSONDecoder>] = []
+    
+    /// The number of coders that were created by the cache. This is used to check how often the cache
+    /// misses.
+    private(set) var createdCount: Int = 0
+    
+    func checkoutEncoder(for outputFormat: RSDJSONOutputFormat, factory: RSDFactory) -> Checkout<JSONEncoder> {
+        lock.lock()
+        let idle = idleEncoders[outputFormat]?.popLast()
+        if idle == nil {
+            createdCount += 1
+        }
+        lock.unlock()
+        
+        let checkout = idle ?? { () -> Checkout<JSONEncoder> in
+            let encoder = factory.createJSONEncoder()
+            if outputFormat.isCompact {
+                encoder.outputFormatting = []
+            }
+            encoder.userInfo[.factory] = RSDWeakFactoryReference(factory)
+            return Checkout(coder: encoder, baseUserInfo: encoder.userInfo)
+        }()
+        checkout.coder.userInfo = checkout.baseUserInfo
+        checkout.coder.userInfo[.codingInfo] = RSDCodingInfo()
+        return checkout
+    }
+    
+    func checkin(_ checkout: Checkout<JSONEncoder>, for outputFormat: RSDJSONOutputFormat) {
+        lock.lock()
+        defer { lock.unlock() }
+        var idle = idleEncoders[outputFormat] ?? []
+        guard idle.count < RSDJSONCoderCache.maxIdleCount else { return }
+        idle.append(checkout)
+        idleEncoders[outputFormat] = idle
+    }
+    
+    func checkoutDecoder(bundle: Bundle?, taskIdentifier: String?, schemaInfo: RSDSchemaInfo?, factory: RSDFactory) -> Checkout<JSONDecoder> {
+        lock.lock()
+        let idle = idleDecoders.popLast()
+        if idle == nil {
+            createdCount += 1
+        }
+        lock.unlock()
+        
+        let checkout = idle ?? { () -> Checkout<JSONDecoder> in
+            let decoder = factory.createJSONDecoder()
+            decoder.userInfo[.factory] = RSDWeakFactoryReference(factory)
+            return Checkout(coder: decoder, baseUserInfo: decoder.userInfo)
+        }()
+        let decoder = checkout.coder
+        decoder.userInfo = checkout.baseUserInfo
+        decoder.userInfo[.codingInfo] = RSDCodingInfo()
+        if let bundle = bundle {
+            decoder.userInfo[.bundle] = bundle
+        }
+        if let taskIdentifier = taskIdentifier {
+            decoder.userInfo[.taskIdentifier] = taskIdentifier
+        }
+        if let schemaInfo = schemaInfo {
+            decoder.userInfo[.schemaInfo] = schemaInfo
+        }
+        return checkout
+    }
+    
+    func checkin(_ checkout: Checkout<JSONDecoder>) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard idleDecoders.count < RSDJSONCoderCache.maxIdleCount else { return }
+        idleDecoders.append(checkout)
+    }
+    
+    func purge() {
+        lock.lock()
+        defer { lock.unlock() }
+        idleEncoders.removeAll()
+        idleDecoders.removeAll()
+    }
+}
+
+/// `RSDWeakFactoryReference` is stored in the user info of a cached coder in place of the factory so that
+/// the coder does not retain the factory that owns the cache.
+final class RSDWeakFactoryReference {
+    
+    private(set) weak var factory: RSDFactory?
+    
+    init(_ factory: RSDFactory) {
+        self.factory = factory
+    }
+}
+
+/// `RSDEncodingSession` holds a JSON encoder that was checked out of the factory's coder cache so that it can
+/// be used to encode many objects. Callers such as archivers and loggers that encode more than one object
+/// should hold a session rather than creating a new encoder for each object.
+///
+/// The session is **not** thread-safe. The encoder is returned to the cache when the session is released.
+///
+/// - seealso: `RSDFactory.createEncodingSession(outputFormat:)`
+public final class RSDEncodingSession {
+    
+    /// The factory that created this session.
+    public let factory: RSDFactory
+    
+    /// The output format used by the encoder.
+    public let outputFormat: RSDJSONOutputFormat
+    
+    /// The number of objects encoded using this session.
+    public private(set) var encodeCount: Int = 0
+    
+    private let checkout: RSDJSONCoderCache.Checkout<JSONEncoder>
+    
+    init(factory: RSDFactory, outputFormat: RSDJSONOutputFormat) {
+        self.factory = factory
+        self.outputFormat = outputFormat
+        self.checkout = factory.coderCache.checkoutEncoder(for: outputFormat, factory: factory)
+    }
+    
+    deinit {
+        factory.coderCache.checkin(checkout, for: outputFormat)
+    }
+    
+    /// Encode the given value. Each value is encoded with a new `RSDCodingInfo`.
+    /// - parameter value: The value to encode.
+    /// - returns: The encoded data.
+    public func encode<T : Encodable>(_ value: T) throws -> Data {
+        _prepareEncoder()
+        return try checkout.coder.encode(value)
+    }
+    
+    /// Encode the given object. This method is used to encode an object where the type is not known at
+    /// compile time.
+    /// - parameter value: The object to encode.
+    /// - returns: The encoded data.
+    public func encodeObject(_ value: Encodable) throws -> Data {
+        _prepareEncoder()
+        return try value.rsd_encodeObject(to: checkout.coder)
+    }
+    
+    private func _prepareEncoder() {
+        encodeCount += 1
+        if encodeCount > 1 {
+            checkout.coder.userInfo[.codingInfo] = RSDCodingInfo()
+        }
+    }
+}
+
+extension RSDFactory {
+    
+    /// Perform the given closure using a JSON encoder from the factory's coder cache. The encoder should
+    /// not be retained outside the closure.
+    ///
+    /// - parameters:
+    ///     - outputFormat: The output format of the encoder. Default = `.prettyPrinted`.
+    ///     - body: The closure to perform with the encoder.
+    /// - returns: The result of the closure.
+    public func withJSONEncoder<T>(outputFormat: RSDJSONOutputFormat = .prettyPrinted, _ body: (JSONEncoder) throws -> T) rethrows -> T {
+        let checkout = coderCache.checkoutEncoder(for: outputFormat, factory: self)
+        defer { coderCache.checkin(checkout, for: outputFormat) }
+        return try body(checkout.coder)
+    }
+    
+    /// Perform the given closure using a JSON decoder from the factory's coder cache. The decoder should
+    /// not be retained outside the closure.
+    ///
+    /// - parameters:
+    ///     - bundle: The bundle to pass with the decoder.
+    ///     - taskIdentifier: The task identifier to pass with the decoder.
+    ///     - schemaInfo: The schema info to pass with the decoder.
+    ///     - body: The closure to perform with the decoder.
+    /// - returns: The result of the closure.
+    public func withJSONDecoder<T>(bundle: Bundle? = nil, taskIdentifier: String? = nil, schemaInfo: RSDSchemaInfo? = nil, _ body: (JSONDecoder) throws -> T) rethrows -> T {
+        let checkout = coderCache.checkoutDecoder(bundle: bundle, taskIdentifier: taskIdentifier, schemaInfo: schemaInfo, factory: self)
+        defer { coderCache.checkin(checkout) }
+        return try body(checkout.coder)
+    }
+    
+    /// Create an encoding session that can be used to encode many objects with the same encoder.
+    ///
+    /// - parameter outputFormat: The output format of the encoder. Default = `.prettyPrinted`.
+    /// - returns: A new encoding session.
+    public func createEncodingSession(outputFormat: RSDJSONOutputFormat = .prettyPrinted) -> RSDEncodingSession {
+        return RSDEncodingSession(factory: self, outputFormat: outputFormat)
+    }
+    
+    /// Returns the factory stored in the given coder user info. The factory may be stored directly or, for
+    /// the cached coders, using a weak reference.
+    static func factory(from userInfo: [CodingUserInfoKey : Any]) -> RSDFactory? {
+        let value = userInfo[.factory]
+        return (value as? RSDFactory) ?? (value as? RSDWeakFactoryReference)?.factory
+    }
+    
+    /// Release the idle coders held by the factory's coder cache.
+    public func purgeCachedCoders() {
+        coderCache.purge()
+    }
+}
@@ -80,33 +80,67 @@ static const NSString * RSDShortInchUnitString = @"″";
 - (NSString *)stringForObjectValue:(id)obj {
     if (obj == nil) { return nil; }
     
-    // convert the object to a measurement
-    NSMeasurement *measurement = nil;
+    // convert the object to a value and unit
+    double value;
+    NSUnitLength *unit;
     if ([obj isKindOfClass:[NSMeasurement class]]) {
-        measurement = (NSMeasurement *)obj;
+        NSMeasurement *measurement = (NSMeasurement *)obj;
+        if (![measurement.unit isKindOfClass:[NSUnitLength class]]) { return nil; }
+        value = measurement.doubleValue;
+        unit = (NSUnitLength *)measurement.unit;
     } else if ([obj isKindOfClass:[NSNumber class]]) {
-        double num = [(NSNumber *)obj doubleValue];
-        measurement = [[NSMeasurement alloc] initWithDoubleValue:num unit:self.toStringUnit];
+        value = [(NSNumber *)obj doubleValue];
+        unit = self.toStringUnit;
     } else if ([obj isKindOfClass:[NSString class]]) {
-        double num = [(NSString *)obj doubleValue];
-        measurement = [[NSMeasurement alloc] initWithDoubleValue:num unit:self.toStringUnit];
+        value = [(NSString *)obj doubleValue];
+        unit = self.toStringUnit;
     } else {
         return nil;
     }
+    
+    BOOL usesInches = [self usesInchesForChildHeight];
+    [NSDimension convertValues:&value count:1 fromUnit:unit toUnit:(usesInches ? NSUnitLength.inches : NSUnitLength.meters)];
+    return [self stringFromConvertedValue:value usingInchFormatter:(usesInches ? [self childHeightFormatter] : nil)];
+}
+
+- (NSArray<NSString *> *)stringsFromValues:(const double *)values count:(NSUInteger)count {
+    if (count == 0) { return @[]; }
+    
+    // Copy the values into a buffer and convert them in place.
+    double *buffer = malloc(count * sizeof(double));
+    memcpy(buffer, values, count * sizeof(double));
+    BOOL usesInches = [self usesInchesForChildHeight];
+    [NSDimension convertValues:buffer count:count fromUnit:self.toStringUnit toUnit:(usesInches ? NSUnitLength.inches : NSUnitLength.meters)];
+    
+    NSLengthFormatter *inchFormatter = usesInches ? [self childHeightFormatter] : nil;
+    NSMutableArray<NSString *> *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger ii = 0; ii < count; ii++) {
+        [strings addObject:[self stringFromConvertedValue:buffer[ii] usingInchFormatter:inchFormatter] ? : @""];
+    }
+    free(buffer);
+    
+    return [strings copy];
+}
+
+- (BOOL)usesInchesForChildHeight {
+    return self.isForChildHeightUse && !self.usesMetricSystem;
+}
 
-    if (self.isForChildHeightUse && !self.usesMetricSystem) {
-        // Create a temporary formatter with the same number formatter and unit style
-        // then return the string in inches.
-        NSLengthFormatter *formatter = [NSLengthFormatter new];
-        formatter.unitStyle = self.unitStyle;
-        formatter.numberFormatter = self.numberFormatter;
-        double inches = [measurement measurementByConvertingToUnit:NSUnitLength.inches].doubleValue;
-        return [formatter stringFromValue:inches unit: NSLengthFormatterUnitInch];
-        
+- (NSLengthFormatter *)childHeightFormatter {
+    // Create a temporary formatter with the same number formatter and unit style.
+    NSLengthFormatter *formatter = [NSLengthFormatter new];
+    formatter.unitStyle = self.unitStyle;
+    formatter.numberFormatter = self.numberFormatter;
+    return formatter;
+}
+
+- (NSString *)stringFromConvertedValue:(double)value usingInchFormatter:(NSLengthFormatter * _Nullable)inchFormatter {
+    if (inchFormatter != nil) {
+        // Return the string in inches.
+        return [inchFormatter stringFromValue:value unit:NSLengthFormatterUnitInch];
     } else {
-        // Convert the value to a number and use the default impplementation from the parent class
-        NSNumber *convertedValue = @([measurement measurementByConvertingToUnit:NSUnitLength.meters].doubleValue);
-        return [super stringForObjectValue:convertedValue];
+        // Use the default implementation from the parent class with the value in meters.
+        return [super stringForObjectValue:@(value)];
     }
 }
 
@@ -139,11 +173,15 @@ static const NSString * RSDShortInchUnitString = @"″";
 }
 
 - (NSMeasurement *)measurementForNumber:(NSNumber *)number unit:(NSString *)unitString {
-    NSUnitLength *unit = [self unitForString:unitString] ? : self.fromStringUnit;
+    NSUnitLength *unit = [self dimensionForUnitString:unitString];
     double measurementValue = [number doubleValue];
     return [[NSMeasurement alloc] initWithDoubleValue:measurementValue unit:unit];
 }
 
+- (NSUnitLength *)dimensionForUnitString:(NSString *)unitString {
+    return [self unitForString:unitString] ? : self.fromStringUnit;
+}
+
 - (NSUnitLength *)unitForString:(NSString *)string {
     NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
     if (trimmedString.length == 0) {
@@ -160,29 +198,7 @@ static const NSString * RSDShortInchUnitString = @"″";
 }
 
 - (NSUnitLength * _Nullable)unitForLocalizedString:(NSString*)string {
-    
-    NSDictionary * unitConvertions = @{
-                                       @(NSLengthFormatterUnitInch) : NSUnitLength.inches,
-                                       @(NSLengthFormatterUnitFoot) : NSUnitLength.feet,
-                                       @(NSLengthFormatterUnitYard) : NSUnitLength.yards,
-                                       @(NSLengthFormatterUnitMile) : NSUnitLength.miles,
-                                       @(NSLengthFormatterUnitMeter) : NSUnitLength.meters,
-                                       @(NSLengthFormatterUnitKilometer) : NSUnitLength.kilometers,
-                                       @(NSLengthFormatterUnitCentimeter) : NSUnitLength.centimeters,
-                                       @(NSLengthFormatterUnitMillimeter) : NSUnitLength.millimeters };
-    
-    RSDLengthFormatter *formatter = [self copy];
-    formatter.unitStyle = NSFormattingUnitStyleLong;
-    
-    for (NSNumber *key in unitConvertions.allKeys) {
-        NSLengthFormatterUnit formatterUnit = key.integerValue;
-        if ([string isEqualToString:[formatter unitStringFromValue:1 unit:formatterUnit]] ||
-            [string isEqualToString:[formatter unitStringFromValue:100 unit:formatterUnit]]) {
-            return unitConvertions[key];
-        }
-    }
-    
-    return nil;
+    return [NSUnitLength unitLengthFromLocalizedString:string locale:[self locale] unitStyle:NSFormattingUnitStyleLong];
 }
 
 #pragma mark - Coding, copying, and equality inheritance
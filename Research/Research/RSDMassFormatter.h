@@ -67,6 +67,15 @@ NS_ASSUME_NONNULL_BEGIN
 /// to a `NSMeasurement` if the units cannot be parsed from the input string.
 @property (nonatomic) NSUnitMass *fromStringUnit;
 
+/// Convert a buffer of values in the `toStringUnit` to localized strings. The values are converted in a
+/// single pass and the same number formatter is used for all the values, so this is more efficient than
+/// calling `-stringForObjectValue:` for each value.
+///
+/// @param  values  A contiguous buffer of values in the `toStringUnit`.
+/// @param  count   The number of values in the buffer.
+/// @return         The localized strings, in the same order as the values.
+- (NSArray<NSString *> *)stringsFromValues:(const double *)values count:(NSUInteger)count;
+
 @end
 
 
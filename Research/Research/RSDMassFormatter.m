@@ -70,24 +70,56 @@
 - (NSString *)stringForObjectValue:(id)obj {
     if (obj == nil) { return nil; }
     
-    // convert the object to a measurement.
-    NSMeasurement *measurement = nil;
+    // convert the object to a value and unit.
+    double value;
+    NSUnitMass *unit;
     if ([obj isKindOfClass:[NSMeasurement class]]) {
-        measurement = (NSMeasurement *)obj;
+        NSMeasurement *measurement = (NSMeasurement *)obj;
+        if (![measurement.unit isKindOfClass:[NSUnitMass class]]) { return nil; }
+        value = measurement.doubleValue;
+        unit = (NSUnitMass *)measurement.unit;
     } else if ([obj isKindOfClass:[NSNumber class]]) {
-        double num = [(NSNumber *)obj doubleValue];
-        measurement = [[NSMeasurement alloc] initWithDoubleValue:num unit:self.toStringUnit];
+        value = [(NSNumber *)obj doubleValue];
+        unit = self.toStringUnit;
     } else if ([obj isKindOfClass:[NSString class]]) {
-        double num = [(NSString *)obj doubleValue];
-        measurement = [[NSMeasurement alloc] initWithDoubleValue:num unit:self.toStringUnit];
+        value = [(NSString *)obj doubleValue];
+        unit = self.toStringUnit;
     } else {
         return nil;
     }
     
-    if (self.isForInfantMassUse && !self.usesMetricSystem) {
+    BOOL usesOunces = [self usesPoundsAndOuncesForInfantMass];
+    [NSDimension convertValues:&value count:1 fromUnit:unit toUnit:(usesOunces ? NSUnitMass.ounces : NSUnitMass.kilograms)];
+    return [self stringFromConvertedValue:value usesPoundsAndOunces:usesOunces];
+}
+
+- (NSArray<NSString *> *)stringsFromValues:(const double *)values count:(NSUInteger)count {
+    if (count == 0) { return @[]; }
+    
+    // Copy the values into a buffer and convert them in place.
+    double *buffer = malloc(count * sizeof(double));
+    memcpy(buffer, values, count * sizeof(double));
+    BOOL usesOunces = [self usesPoundsAndOuncesForInfantMass];
+    [NSDimension convertValues:buffer count:count fromUnit:self.toStringUnit toUnit:(usesOunces ? NSUnitMass.ounces : NSUnitMass.kilograms)];
+    
+    NSMutableArray<NSString *> *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger ii = 0; ii < count; ii++) {
+        [strings addObject:[self stringFromConvertedValue:buffer[ii] usesPoundsAndOunces:usesOunces] ? : @""];
+    }
+    free(buffer);
+    
+    return [strings copy];
+}
+
+- (BOOL)usesPoundsAndOuncesForInfantMass {
+    return self.isForInfantMassUse && !self.usesMetricSystem;
+}
+
+- (NSString *)stringFromConvertedValue:(double)value usesPoundsAndOunces:(BOOL)usesPoundsAndOunces {
+    if (usesPoundsAndOunces) {
         // For an infant, use a joined string that converts to lb and oz.
-        double pounds = floor([measurement measurementByConvertingToUnit:NSUnitMass.poundsMass].doubleValue);
-        double ounces = [measurement measurementByConvertingToUnit:NSUnitMass.ounces].doubleValue - (pounds * 16.0);
+        double pounds = floor(value / 16.0);
+        double ounces = value - (pounds * 16.0);
         ounces = round(1000 * ounces) / 1000;
         NSString * poundString = [self stringFromValue:pounds unit:NSMassFormatterUnitPound];
         NSString * ouncesString = [self stringFromValue:ounces unit:NSMassFormatterUnitOunce];
@@ -95,9 +127,8 @@
         return joinedString;
         
     } else {
-        // Convert the value to a number and use the default impplementation from the parent class.
-        NSNumber *convertedValue = @([measurement measurementByConvertingToUnit:NSUnitMass.kilograms].doubleValue);
-        return [super stringForObjectValue:convertedValue];
+        // Use the default implementation from the parent class with the value in kilograms.
+        return [super stringForObjectValue:@(value)];
     }
 }
 
@@ -130,37 +161,22 @@
 }
 
 - (NSMeasurement *)measurementForNumber:(NSNumber *)number unit:(NSString *)unitString {
-    NSUnitMass *unit = [self unitForString:unitString] ? : self.fromStringUnit;
+    NSUnitMass *unit = [self dimensionForUnitString:unitString];
     double measurementValue = [number doubleValue];
     return [[NSMeasurement alloc] initWithDoubleValue:measurementValue unit:unit];
 }
 
+- (NSUnitMass *)dimensionForUnitString:(NSString *)unitString {
+    return [self unitForString:unitString] ? : self.fromStringUnit;
+}
+
 - (NSUnitMass *)unitForString:(NSString *)string {
     NSString *trimmedString = [string stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
     return [NSUnitMass unitMassFromSymbol: trimmedString] ? : [self unitForLocalizedString: trimmedString];
 }
 
 - (NSUnitMass * _Nullable)unitForLocalizedString:(NSString*)string {
-    
-    NSDictionary * unitConvertions = @{
-                                       @(NSMassFormatterUnitGram) : NSUnitMass.grams,
-                                       @(NSMassFormatterUnitKilogram) : NSUnitMass.kilograms,
-                                       @(NSMassFormatterUnitOunce) : NSUnitMass.ounces,
-                                       @(NSMassFormatterUnitPound) : NSUnitMass.poundsMass,
-                                       @(NSMassFormatterUnitStone) : NSUnitMass.stones};
-    
-    RSDMassFormatter *formatter = [self copy];
-    formatter.unitStyle = NSFormattingUnitStyleLong;
-    
-    for (NSNumber *key in unitConvertions.allKeys) {
-        NSMassFormatterUnit formatterUnit = key.integerValue;
-        if ([string isEqualToString:[formatter unitStringFromValue:1 unit:formatterUnit]] ||
-            [string isEqualToString:[formatter unitStringFromValue:100 unit:formatterUnit]]) {
-            return unitConvertions[key];
-        }
-    }
-    
-    return nil;
+    return [NSUnitMass unitMassFromLocalizedString:string locale:[self locale] unitStyle:NSFormattingUnitStyleLong];
 }
 
 #pragma mark - Coding, copying, and equality inheritance
@@ -48,14 +48,77 @@ NS_ASSUME_NONNULL_BEGIN
 /// @returns            The measurement from this number and unit.
 - (NSMeasurement * _Nullable)measurementForNumber:(NSNumber *)number unit:(NSString * _Nullable)unitString;
 
+@optional
+
+/// Convert the unit string into a unit. If implemented, the parser will call this method rather than
+/// `-measurementForNumber:unit:` so that the parts of the string can be summed without allocating a
+/// measurement for each one.
+/// @param  unitString  A string representation of the unit. Optional.
+/// @returns            The unit to use for this string, or the default unit if it cannot be parsed.
+- (NSDimension *)dimensionForUnitString:(NSString * _Nullable)unitString;
+
+@end
+
+/// The result of scanning a string using a `RSDMeasurementParser`.
+typedef NS_ENUM(NSInteger, RSDMeasurementParserResult) {
+    /// The string was parsed into a measurement.
+    RSDMeasurementParserResultMeasurement = 0,
+    /// The string does not include a measurement. The regex parser would not find one either.
+    RSDMeasurementParserResultNotAMeasurement,
+    /// The string has more parts than the parser can scan in a single pass.
+    RSDMeasurementParserResultUnsupported,
+};
+
+/// `RSDMeasurementParser` is a single-pass scanner that is used to parse a string into numbers and unit
+/// strings. The parser is immutable once created and the parsers are cached by the decimal and grouping
+/// separators of the number formatter so that they can be shared across formatters and threads.
+@interface RSDMeasurementParser : NSObject
+
+/// The decimal separator used by this parser.
+@property (nonatomic, readonly) NSString *decimalSeparator;
+
+/// The grouping separator used by this parser.
+@property (nonatomic, readonly) NSString *groupingSeparator;
+
+/// Returns the shared parser for the separators used by the given number formatter.
+/// @param  numberFormatter The number formatter with the decimal and grouping separators to use.
+/// @return                 The cached parser, or `nil` if the separators cannot be scanned in a single pass.
++ (instancetype _Nullable)parserForNumberFormatter:(NSNumberFormatter *)numberFormatter NS_SWIFT_NAME(parser(for:));
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Initialize the parser with the decimal and grouping separators.
+/// @param  decimalSeparator    The decimal separator. Must be a single character.
+/// @param  groupingSeparator   The grouping separator. Must be empty or a single character.
+/// @return                     A parser, or `nil` if the separators are not supported.
+- (instancetype _Nullable)initWithDecimalSeparator:(NSString *)decimalSeparator
+                                 groupingSeparator:(NSString *)groupingSeparator NS_DESIGNATED_INITIALIZER;
+
+/// Scan the string for decimal numbers and assume that the other part of the string is a unit. The
+/// parts are then summed in the units returned by the formatter.
+///
+/// @param  string      The string to parse into a number and unit.
+/// @param  formatter   The formatter to use to convert the parsed number and unit into an `NSMeasurement`.
+/// @return             The measurement (if any) parsed from the string.
+- (NSMeasurement * _Nullable)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter;
+
+/// Scan the string for decimal numbers and assume that the other part of the string is a unit.
+///
+/// @param  string      The string to parse into a number and unit.
+/// @param  formatter   The formatter to use to convert the parsed number and unit into an `NSMeasurement`.
+/// @param  result      Set to the result of scanning the string. Optional.
+/// @return             The measurement (if any) parsed from the string.
+- (NSMeasurement * _Nullable)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter result:(RSDMeasurementParserResult * _Nullable)result;
+
 @end
 
 /// `RSDMeasurementWrapper` is a convenience wrapper for allowing shared parsing code for both
 /// a length and mass formatter.
 @interface RSDMeasurementWrapper : NSObject
 
-/// Use regex pattern matching to find decimal numbers in the string, and assume that the other part
-/// of the string is a unit.
+/// Find decimal numbers in the string, and assume that the other part of the string is a unit. This
+/// will use the cached `RSDMeasurementParser` for the formatter's separators if supported, and otherwise
+/// will fall back to using regex pattern matching.
 ///
 /// Note: This will only work for languages that define numbers using 0-9 digits. syoung 01/03/2018
 ///
@@ -65,6 +128,15 @@ NS_ASSUME_NONNULL_BEGIN
 ///
 + (NSMeasurement * _Nullable)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter;
 
+/// Use regex pattern matching to find decimal numbers in the string, and assume that the other part
+/// of the string is a unit.
+///
+/// @param  string      The string to parse into a number and unit.
+/// @param  formatter   The formatter to use to actually convert the parsed number into an `NSMeasurement`.
+/// @return             The measurement (if any) parsed from the string.
+///
++ (NSMeasurement * _Nullable)regexMeasurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -33,9 +33,230 @@
 
 #import "RSDMeasurementWrapper.h"
 
+/// The maximum number of numbers or units that will be scanned in a single pass. Strings with more parts
+/// than this fall back to the regex parser.
+#define RSD_MAX_MEASUREMENT_PARTS 16
+
+static inline BOOL RSDIsDigit(UniChar ch) {
+    return (ch >= '0') && (ch <= '9');
+}
+
+static inline BOOL RSDIsWhitespace(UniChar ch) {
+    if (ch < 0x80) {
+        return (ch == ' ') || ((ch >= '\t') && (ch <= '\r'));
+    }
+    return [[NSCharacterSet whitespaceAndNewlineCharacterSet] characterIsMember:ch];
+}
+
+@implementation RSDMeasurementParser {
+    UniChar _decimalChar;
+    UniChar _groupingChar;
+    BOOL _hasGrouping;
+    BOOL _groupingIsWhitespace;
+}
+
++ (NSCache<NSString *, RSDMeasurementParser *> *)sharedCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+    });
+    return cache;
+}
+
++ (instancetype)parserForNumberFormatter:(NSNumberFormatter *)numberFormatter {
+    NSString *decimalSeparator = numberFormatter.decimalSeparator ? : @".";
+    NSString *groupingSeparator = numberFormatter.groupingSeparator ? : @"";
+    NSString *key = [NSString stringWithFormat:@"%@|%@", decimalSeparator, groupingSeparator];
+    
+    NSCache *cache = [self sharedCache];
+    RSDMeasurementParser *parser = [cache objectForKey:key];
+    if (parser == nil) {
+        parser = [[RSDMeasurementParser alloc] initWithDecimalSeparator:decimalSeparator groupingSeparator:groupingSeparator];
+        if (parser != nil) {
+            [cache setObject:parser forKey:key];
+        }
+    }
+    return parser;
+}
+
+- (instancetype)initWithDecimalSeparator:(NSString *)decimalSeparator groupingSeparator:(NSString *)groupingSeparator {
+    if ((decimalSeparator.length != 1) || (groupingSeparator.length > 1)) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _decimalSeparator = [decimalSeparator copy];
+        _groupingSeparator = [groupingSeparator copy];
+        _decimalChar = [decimalSeparator characterAtIndex:0];
+        _hasGrouping = (groupingSeparator.length == 1);
+        _groupingChar = _hasGrouping ? [groupingSeparator characterAtIndex:0] : 0;
+        _groupingIsWhitespace = _hasGrouping && RSDIsWhitespace(_groupingChar);
+    }
+    return self;
+}
+
+- (BOOL)isGroupingCharacter:(UniChar)ch {
+    return _hasGrouping && ((ch == _groupingChar) || (_groupingIsWhitespace && RSDIsWhitespace(ch)));
+}
+
+- (BOOL)isUnitCharacter:(UniChar)ch {
+    return !RSDIsDigit(ch) && (ch != ',') && (ch != _decimalChar) && ![self isGroupingCharacter:ch] && !RSDIsWhitespace(ch);
+}
+
+- (NSMeasurement *)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter {
+    return [self measurementFromString:string withFormatter:formatter result:NULL];
+}
+
+- (NSMeasurement *)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter result:(RSDMeasurementParserResult *)result {
+    
+    // Assume that the string is not a measurement until the parts have been summed.
+    if (result != NULL) {
+        *result = RSDMeasurementParserResultNotAMeasurement;
+    }
+    
+    CFIndex length = (CFIndex)string.length;
+    CFStringInlineBuffer buffer;
+    CFStringInitInlineBuffer((__bridge CFStringRef)string, &buffer, CFRangeMake(0, length));
+    
+    double numbers[RSD_MAX_MEASUREMENT_PARTS];
+    CFRange unitRanges[RSD_MAX_MEASUREMENT_PARTS];
+    NSUInteger numberCount = 0;
+    NSUInteger unitCount = 0;
+    
+    CFIndex idx = 0;
+    while (idx < length) {
+        UniChar ch = CFStringGetCharacterFromInlineBuffer(&buffer, idx);
+        UniChar next = CFStringGetCharacterFromInlineBuffer(&buffer, idx + 1);
+        
+        if (RSDIsDigit(ch) || ((ch == _decimalChar) && RSDIsDigit(next))) {
+            if (numberCount == RSD_MAX_MEASUREMENT_PARTS) {
+                if (result != NULL) { *result = RSDMeasurementParserResultUnsupported; }
+                return nil;
+            }
+            
+            // Scan the integer digits.
+            double mantissa = 0;
+            while (idx < length && RSDIsDigit(ch = CFStringGetCharacterFromInlineBuffer(&buffer, idx))) {
+                mantissa = mantissa * 10 + (ch - '0');
+                idx++;
+            }
+            
+            // Only include a grouping separator if it is followed by exactly 3 digits.
+            while (idx < length && [self isGroupingCharacter:ch] &&
+                   RSDIsDigit(CFStringGetCharacterFromInlineBuffer(&buffer, idx + 1)) &&
+                   RSDIsDigit(CFStringGetCharacterFromInlineBuffer(&buffer, idx + 2)) &&
+                   RSDIsDigit(CFStringGetCharacterFromInlineBuffer(&buffer, idx + 3)) &&
+                   !RSDIsDigit(CFStringGetCharacterFromInlineBuffer(&buffer, idx + 4))) {
+                for (CFIndex ii = idx + 1; ii <= idx + 3; ii++) {
+                    mantissa = mantissa * 10 + (CFStringGetCharacterFromInlineBuffer(&buffer, ii) - '0');
+                }
+                idx += 4;
+                ch = CFStringGetCharacterFromInlineBuffer(&buffer, idx);
+            }
+            
+            // Scan the fractional digits.
+            double divisor = 1;
+            if ((idx < length) && (ch == _decimalChar) && RSDIsDigit(CFStringGetCharacterFromInlineBuffer(&buffer, idx + 1))) {
+                idx++;
+                while (idx < length && RSDIsDigit(ch = CFStringGetCharacterFromInlineBuffer(&buffer, idx))) {
+                    mantissa = mantissa * 10 + (ch - '0');
+                    divisor *= 10;
+                    idx++;
+                }
+            }
+            
+            numbers[numberCount++] = mantissa / divisor;
+            
+        } else if ([self isUnitCharacter:ch]) {
+            if (unitCount == RSD_MAX_MEASUREMENT_PARTS) {
+                if (result != NULL) { *result = RSDMeasurementParserResultUnsupported; }
+                return nil;
+            }
+            
+            CFIndex start = idx;
+            while (idx < length && [self isUnitCharacter:CFStringGetCharacterFromInlineBuffer(&buffer, idx)]) {
+                idx++;
+            }
+            unitRanges[unitCount++] = CFRangeMake(start, idx - start);
+            
+        } else {
+            idx++;
+        }
+    }
+    
+    if (numberCount == 0) {
+        return nil;
+    }
+    
+    // Sum the parts as doubles. If all the units are the same then the sum is returned in that unit,
+    // otherwise the sum is in the base unit. This matches `-measurementByAddingMeasurement:`.
+    BOOL usesDimension = [formatter respondsToSelector:@selector(dimensionForUnitString:)];
+    NSUnit *firstUnit = nil;
+    double unitSum = 0;
+    double baseSum = 0;
+    BOOL sameUnit = YES;
+    for (NSUInteger ii = 0; ii < numberCount; ii++) {
+        NSString *unitString = nil;
+        if (ii < unitCount) {
+            unitString = CFBridgingRelease(CFStringCreateWithSubstring(kCFAllocatorDefault, (__bridge CFStringRef)string, unitRanges[ii]));
+        }
+        
+        double value = numbers[ii];
+        NSUnit *unit = nil;
+        if (usesDimension) {
+            unit = [formatter dimensionForUnitString:unitString];
+        } else {
+            NSMeasurement *part = [formatter measurementForNumber:@(value) unit:unitString];
+            if (part == nil) { continue; }
+            unit = part.unit;
+            value = part.doubleValue;
+        }
+        
+        if (firstUnit == nil) {
+            firstUnit = unit;
+        } else if (![firstUnit isEqual:unit]) {
+            sameUnit = NO;
+        }
+        unitSum += value;
+        if ([unit isKindOfClass:[NSDimension class]]) {
+            baseSum += [((NSDimension *)unit).converter baseUnitValueFromValue:value];
+        }
+    }
+    
+    if (firstUnit == nil) {
+        return nil;
+    }
+    
+    if (result != NULL) {
+        *result = RSDMeasurementParserResultMeasurement;
+    }
+    if (sameUnit || ![firstUnit isKindOfClass:[NSDimension class]]) {
+        return [[NSMeasurement alloc] initWithDoubleValue:unitSum unit:firstUnit];
+    } else {
+        NSDimension *baseUnit = [[(NSDimension *)firstUnit class] baseUnit];
+        return [[NSMeasurement alloc] initWithDoubleValue:baseSum unit:baseUnit];
+    }
+}
+
+@end
+
 @implementation RSDMeasurementWrapper
 
 + (NSMeasurement * _Nullable)measurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter {
+    RSDMeasurementParser *parser = [RSDMeasurementParser parserForNumberFormatter:formatter.numberFormatter];
+    if (parser != nil) {
+        // Only fall back to the regex parser if the string could not be scanned in a single pass.
+        RSDMeasurementParserResult result = RSDMeasurementParserResultUnsupported;
+        NSMeasurement *measurement = [parser measurementFromString:string withFormatter:formatter result:&result];
+        if (result != RSDMeasurementParserResultUnsupported) {
+            return measurement;
+        }
+    }
+    return [self regexMeasurementFromString:string withFormatter:formatter];
+}
+
++ (NSMeasurement * _Nullable)regexMeasurementFromString:(NSString *)string withFormatter:(id <RSDMeasurementFormatter>)formatter {
     
     // Use regex pattern matching to find decimal numbers in the string
     // and assume that the other part of the string is a unit.
@@ -210,8 +210,45 @@ public struct RSDMotionRecorderConfiguration : RSDRestartableRecorderConfigurati
     /// Set the flag to `true` to encode the samples as a CSV file.
     public var usesCSVEncoding : Bool?
     
+    /// The output format to use when the samples are encoded as JSON. If `nil`, then the samples will
+    /// be pretty-printed. This value is ignored if `usesCSVEncoding` is `true`.
+    public var jsonOutputFormat : RSDJSONOutputFormat?
+    
+    /// Set the flag to `true` to encode the samples using the compact binary columnar format. The file
+    /// can be converted to JSON or CSV using `RSDColumnarSampleReader`. If `true`, then this takes
+    /// precedence over both `usesCSVEncoding` and `jsonOutputFormat`.
+    public var usesBinaryEncoding : Bool?
+    
+    /// The content encoding to use to compress the file as it is written. If `nil`, then the file is
+    /// not compressed.
+    public var contentEncoding : RSDContentEncoding?
+    
+    /// The maximum duration (in seconds) of each file segment. If set, then the recorder will close the
+    /// file and start a new one after this interval so that the earlier segments can be processed while
+    /// the recording continues. If `nil`, then all the samples are written to a single file.
+    public var segmentDuration : TimeInterval?
+    
+    /// The window to use to calculate summary features (mean, variance, RMS, min, max, zero-crossings,
+    /// and dominant frequency) for each sensor while the samples are recorded. If `nil`, then features
+    /// are not calculated.
+    ///
+    /// - seealso: `RSDWindowedFeatureExtractor`
+    public var featureWindow : RSDWindowedFeatureExtractor.Window?
+    
+    /// Set the flag to `false` to only write the step markers to the log file. This can be used if the
+    /// `featureWindow` is set and the raw samples are not needed. Default = `true`.
+    public var shouldLogSamples : Bool?
+    
+    /// The frequency of the samples written to the log file. If this is less than the `frequency`, then
+    /// the sensors are still sampled at the `frequency` and the samples are low-pass filtered and
+    /// decimated before they are written. The decimation factor is `frequency / outputFrequency`
+    /// rounded to the nearest integer. If `nil`, then every sample is written.
+    ///
+    /// - seealso: `RSDDecimationFilter`
+    public var outputFrequency : Double?
+    
     private enum CodingKeys : String, CodingKey, CaseIterable {
-        case identifier, type, recorderTypes, startStepIdentifier, stopStepIdentifier, frequency, _requiresBackgroundAudio = "requiresBackgroundAudio", usesCSVEncoding, _shouldDeletePrevious = "shouldDeletePrevious"
+        case identifier, type, recorderTypes, startStepIdentifier, stopStepIdentifier, frequency, _requiresBackgroundAudio = "requiresBackgroundAudio", usesCSVEncoding, jsonOutputFormat, usesBinaryEncoding, contentEncoding, segmentDuration, featureWindow, shouldLogSamples, outputFrequency, _shouldDeletePrevious = "shouldDeletePrevious"
     }
     
     /// Default initializer.
@@ -57,6 +57,10 @@ public protocol RSDOrderedStepNavigator : RSDStepNavigator, RSDStepValidator {
     
     /// The navigation back rule (if any) associated with this step.
     func navigationBackRule(for step: RSDStep) -> RSDNavigationBackRule?
+    
+    /// An index of the `steps` and `progressMarkers` used to look up steps by identifier without searching
+    /// the step array. If non-nil, the index **must** match the steps and progress markers of this navigator.
+    var stepNavigatorIndex: RSDStepNavigatorIndex? { get }
 }
 
 
@@ -64,13 +68,44 @@ public protocol RSDOrderedStepNavigator : RSDStepNavigator, RSDStepValidator {
 /// steps and the conditional rule.
 extension RSDOrderedStepNavigator {
     
+    /// By default, the navigator does not have an index.
+    public var stepNavigatorIndex: RSDStepNavigatorIndex? {
+        return nil
+    }
+    
     /// Returns the step associated with a given identifier.
     /// - parameter identifier:  The identifier for the step.
     /// - returns: The step with this identifier or nil if not found.
     public func step(with identifier: String) -> RSDStep? {
+        if let navigatorIndex = self.stepNavigatorIndex {
+            return navigatorIndex.index(of: identifier).map { self.steps[$0] }
+        }
         return self.steps.first(where: { $0.identifier == identifier })
     }
     
+    /// Look up the step with the given identifier. The index is only returned if the navigator has a
+    /// `stepNavigatorIndex` that can be used to look up the cached rules for that step.
+    private func _indexedStep(with identifier: String) -> (step: RSDStep?, index: Int?) {
+        guard let navigatorIndex = self.stepNavigatorIndex else {
+            return (self.step(with: identifier), nil)
+        }
+        guard let idx = navigatorIndex.index(of: identifier) else { return (nil, nil) }
+        return (self.steps[idx], idx)
+    }
+    
+    /// Look up the step after the step with the given identifier.
+    private func _indexedStep(after identifier: String?) -> (step: RSDStep?, index: Int?) {
+        guard let navigatorIndex = self.stepNavigatorIndex else {
+            return (steps.rsd_next(after: {$0.identifier == identifier}), nil)
+        }
+        guard let identifier = identifier,
+            let idx = navigatorIndex.index(of: identifier), idx + 1 < self.steps.count
+            else {
+                return (nil, nil)
+        }
+        return (self.steps[idx + 1], idx + 1)
+    }
+    
     private func _checkConditionalRules(after previousStep: RSDStep?, with result: RSDTaskResult, isPeeking: Bool) -> String? {
         for rule in self.trackingRules {
             if let nextStepId = rule.nextStepIdentifier(after: previousStep, with: result, isPeeking: isPeeking) {
@@ -93,23 +128,32 @@ extension RSDOrderedStepNavigator {
     private func _nextStepIdentifier(with parentResult: RSDTaskResult, isPeeking: Bool) -> String? {
         guard let sectionStep = self as? RSDStep,
             let taskResult = parentResult.findResult(for: sectionStep) as? RSDTaskResult,
-            let lastResult = taskResult.stepHistory.last,
-            let previousStep = self.step(with: lastResult.identifier)
+            let lastResult = taskResult.stepHistory.last
             else {
                 return nil
         }
-        return _nextStepIdentifier(after: previousStep, with: taskResult, isPeeking: isPeeking)
+        let previous = _indexedStep(with: lastResult.identifier)
+        guard let previousStep = previous.step else { return nil }
+        return _nextStepIdentifier(after: previousStep, at: previous.index, with: taskResult, isPeeking: isPeeking)
     }
     
-    private func _nextStepIdentifier(after previousStep: RSDStep?, with result: RSDTaskResult, isPeeking: Bool) -> String? {
+    private func _nextStepIdentifier(after previousStep: RSDStep?, at previousIndex: Int?, with result: RSDTaskResult, isPeeking: Bool) -> String? {
+        // Use the cached cast if the step was looked up using the navigator index.
+        let sectionNavigator: RSDConditionalStepNavigator? = {
+            if let idx = previousIndex, let navigatorIndex = self.stepNavigatorIndex {
+                return navigatorIndex.sectionNavigator(at: idx)
+            }
+            return previousStep as? RSDConditionalStepNavigator
+        }()
+        
         // If this is a step that conforms to RSDConditionalStepNavigator and the next step is non-nil,
         // then return this as the next step identifier
-        if let sectionStep = previousStep as? RSDConditionalStepNavigator,
+        if let sectionStep = sectionNavigator,
             let nextStepIdentifer = sectionStep._nextStepIdentifier(with: result, isPeeking: isPeeking) {
             return nextStepIdentifer
         }
         else if let navigableStep = previousStep,
-            let navigationRule = self.navigationRule(for: navigableStep),
+            let navigationRule = _navigationRule(for: navigableStep, at: previousIndex),
             let nextStepIdentifier = navigationRule.nextStepIdentifier(with: result, isPeeking: isPeeking) {
             // If this is a step that conforms to the RSDNavigationRule protocol and the next step is non-nil,
             // then return this as the next step identifier
@@ -128,7 +172,7 @@ extension RSDOrderedStepNavigator {
     ///     - result:  The current result set for this task.
     /// - returns: `true` if the task view controller should exit.
     public func shouldExit(after step: RSDStep?, with result: RSDTaskResult) -> Bool {
-        guard let nextIdentifier = _nextStepIdentifier(after: step, with: result, isPeeking: false)
+        guard let nextIdentifier = _nextStepIdentifier(after: step, at: nil, with: result, isPeeking: false)
             else {
                 return false
         }
@@ -181,14 +225,18 @@ extension RSDOrderedStepNavigator {
     
     private func _step(after step: RSDStep?, with result: inout RSDTaskResult, isPeeking: Bool) -> (step: RSDStep?, direction: RSDStepDirection)? {
         
+        // The index of a step is only tracked if it was looked up using the navigator index. The step
+        // passed into this method may be a copy so the cached rules are not used for that step.
         var returnStep: RSDStep?
+        var returnIndex: Int?
         var stepDirection: RSDStepDirection = .forward
         var previousStep: RSDStep? = step
+        var previousIndex: Int? = nil
         var shouldSkip = false
         
         repeat {
             
-            if let nextIdentifier = _nextStepIdentifier(after: previousStep, with: result, isPeeking: isPeeking) {
+            if let nextIdentifier = _nextStepIdentifier(after: previousStep, at: previousIndex, with: result, isPeeking: isPeeking) {
                 if nextIdentifier == RSDIdentifier.exit {
                     // If the next identifier equals "exit" then exit the task
                     return nil
@@ -201,31 +249,36 @@ extension RSDOrderedStepNavigator {
                     if result.findResult(with: nextIdentifier) != nil {
                         stepDirection = .reverse
                     }
-                    returnStep = self.step(with: nextIdentifier)
+                    (returnStep, returnIndex) = _indexedStep(with: nextIdentifier)
                 }
             }
             else if let previousIdentifier = previousStep?.identifier {
                 // If we've dropped through without setting the return step to something non-nil
                 // then look for the next step.
-                returnStep = steps.rsd_next(after: {$0.identifier == previousIdentifier})
+                (returnStep, returnIndex) = _indexedStep(after: previousIdentifier)
             }
             else {
                 returnStep = steps.first
+                returnIndex = (returnStep != nil) ? 0 : nil
             }
             
             shouldSkip = false
             if let nextId = _checkConditionalSkipRules(before: returnStep, with: result, isPeeking: isPeeking) {
                 if nextId == RSDIdentifier.nextStep {
-                    returnStep = steps.rsd_next(after: {$0.identifier == returnStep?.identifier})
+                    (returnStep, returnIndex) = _indexedStep(after: returnStep?.identifier)
+                } else if self.stepNavigatorIndex != nil {
+                    (returnStep, returnIndex) = _indexedStep(with: nextId)
                 } else {
                     returnStep = steps.first(where: {$0.identifier == nextId})
                 }
             }
-            if !shouldSkip, (returnStep != nil), let navigationSkipStep = self.navigationSkipRule(for: returnStep!) {
+            if !shouldSkip, let navigableStep = returnStep,
+                let navigationSkipStep = _navigationSkipRule(for: navigableStep, at: returnIndex) {
                 shouldSkip = navigationSkipStep.shouldSkipStep(with: result, isPeeking: isPeeking)
             }
             if (shouldSkip) {
                 previousStep = returnStep
+                previousIndex = returnIndex
             }
             
         } while (shouldSkip)
@@ -233,6 +286,20 @@ extension RSDOrderedStepNavigator {
         return (returnStep, stepDirection)
     }
     
+    private func _navigationRule(for step: RSDStep, at index: Int?) -> RSDNavigationRule? {
+        if let idx = index, let navigatorIndex = self.stepNavigatorIndex {
+            return navigatorIndex.navigationRule(at: idx)
+        }
+        return self.navigationRule(for: step)
+    }
+    
+    private func _navigationSkipRule(for step: RSDStep, at index: Int?) -> RSDNavigationSkipRule? {
+        if let idx = index, let navigatorIndex = self.stepNavigatorIndex {
+            return navigatorIndex.navigationSkipRule(at: idx)
+        }
+        return self.navigationSkipRule(for: step)
+    }
+    
     /// Return the step to go to before the given step.
     ///
     /// - parameters:
@@ -276,7 +343,26 @@ extension RSDOrderedStepNavigator {
     ///     - total:        The total number of steps.
     ///     - isEstimated:  Whether or not the progress is an estimate (if the task has variable navigation).
     public func progress(for step: RSDStep, with result: RSDTaskResult?) -> (current: Int, total: Int, isEstimated: Bool)? {
-        if let markers = self.progressMarkers {
+        if let markers = self.progressMarkers, let markerIndex = self.stepNavigatorIndex?.progressMarkerIndex {
+            // Look up the last index into the markers where the step has been displayed without building
+            // an array of the step history.
+            guard let stepHistory = result?.stepHistory else { return nil }
+            var idx: Int? = markerIndex[step.identifier]
+            for stepResult in stepHistory {
+                if let markerIdx = markerIndex[stepResult.identifier], markerIdx > (idx ?? -1) {
+                    idx = markerIdx
+                }
+            }
+            guard let lastIdx = idx else { return nil }
+            
+            let current = lastIdx + 1
+            if current == markers.count, markerIndex[step.identifier] == nil {
+                return nil
+            } else {
+                return (current, markers.count, false)
+            }
+        }
+        else if let markers = self.progressMarkers {
             // Get the list of steps that have been shown and add the step under test in case this is
             // called before that step is added to the step history.
             guard let stepHistory = result?.stepHistory.map({ $0.identifier }) else { return nil }
@@ -300,6 +386,19 @@ extension RSDOrderedStepNavigator {
                 return (current, markers.count, false)
             }
         }
+        else if let navigatorIndex = self.stepNavigatorIndex {
+            // Count the results that are not included in the steps rather than building a set of the steps.
+            var resultSet = Set<String>()
+            var additionalCount = 0
+            for stepResult in result?.stepHistory ?? [] {
+                if resultSet.insert(stepResult.identifier).inserted, !navigatorIndex.contains(stepResult.identifier) {
+                    additionalCount += 1
+                }
+            }
+            let total = navigatorIndex.uniqueCount + additionalCount
+            let current = resultSet.count - (resultSet.contains(step.identifier) ? 1 : 0)
+            return (current + 1, total, true)
+        }
         else {
             // Look at the total number of steps and the result.
             let resultSet = Set(result?.stepHistory.map({ $0.identifier }) ?? [])
@@ -0,0 +1,239 @@
+//
+//  RSDPowerSpectrum.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+#if canImport(Accelerate)
+import Accelerate
+#endif
+
+/// `RSDPowerSpectrum` calculates the power of each frequency bin of a real signal with a fixed length
+/// using a fast Fourier transform. If the length is not a power of two, then the Bluestein (chirp-z)
+/// algorithm is used so that the bins are the same as those of a discrete Fourier transform with the
+/// same length as the signal.
+///
+/// On Apple platforms, the power-of-two transforms use vDSP. Otherwise, an in-place radix-2 transform
+/// is used. All the buffers are allocated when the spectrum is initialized.
+///
+/// An instance of this class is **not** thread-safe.
+final class RSDPowerSpectrum {
+    
+    /// The number of samples in the signal.
+    let length: Int
+    
+    /// The number of points in the power-of-two transform.
+    let transformLength: Int
+    
+    /// The power of each frequency bin `k` in `0...length/2` calculated by the last call to
+    /// `calculate()`.
+    private(set) var power: [Double]
+    
+    /// Is the Bluestein algorithm used to calculate the transform?
+    private let usesChirp: Bool
+    
+    /// The chirp `exp(-iπn²/N)` for each sample `n` in the signal.
+    private let chirpReal: [Double]
+    private let chirpImag: [Double]
+    
+    /// The transform of the conjugate chirp. This is convolved with the chirped signal.
+    private var filterReal: [Double]
+    private var filterImag: [Double]
+    
+    /// The buffers used to calculate the transform in place.
+    private var real: [Double]
+    private var imag: [Double]
+    
+    #if canImport(Accelerate)
+    private let log2Length: vDSP_Length
+    private let setup: FFTSetupD
+    #else
+    /// The twiddle factors `exp(-2πik/M)` for `k` in `0..<M/2`.
+    private let twiddleReal: [Double]
+    private let twiddleImag: [Double]
+    #endif
+    
+    /// Initialize the spectrum with the length of the signal.
+    /// - parameter length: The number of samples in the signal. Must be greater than `1`.
+    init(length: Int) {
+        precondition(length > 1, "The signal must include more than one sample.")
+        self.length = length
+        
+        var transformLength = 2
+        while transformLength < length {
+            transformLength *= 2
+        }
+        self.usesChirp = (transformLength != length)
+        if usesChirp {
+            // The convolution must be at least 2N - 1 points to avoid wrapping.
+            while transformLength < 2 * length - 1 {
+                transformLength *= 2
+            }
+            // Use n² mod 2N to calculate the angle so that the precision is not lost for large n.
+            let angles = (0..<length).map { Double.pi * Double(($0 * $0) % (2 * length)) / Double(length) }
+            self.chirpReal = angles.map { cos($0) }
+            self.chirpImag = angles.map { -sin($0) }
+        }
+        else {
+            self.chirpReal = []
+            self.chirpImag = []
+        }
+        self.transformLength = transformLength
+        self.power = Array(repeating: 0, count: length / 2 + 1)
+        self.real = Array(repeating: 0, count: transformLength)
+        self.imag = Array(repeating: 0, count: transformLength)
+        self.filterReal = []
+        self.filterImag = []
+        
+        #if canImport(Accelerate)
+        self.log2Length = vDSP_Length(transformLength.trailingZeroBitCount)
+        guard let setup = vDSP_create_fftsetupD(self.log2Length, FFTRadix(kFFTRadix2)) else {
+            fatalError("Failed to create the FFT setup for \(transformLength) points.")
+        }
+        self.setup = setup
+        #else
+        let angles = (0..<(transformLength / 2)).map { 2 * Double.pi * Double($0) / Double(transformLength) }
+        self.twiddleReal = angles.map { cos($0) }
+        self.twiddleImag = angles.map { -sin($0) }
+        #endif
+        
+        if usesChirp {
+            // The filter is the conjugate chirp at n and M - n, and zero between.
+            for n in 0..<length {
+                real[n] = chirpReal[n]
+                imag[n] = -chirpImag[n]
+                if n > 0 {
+                    real[transformLength - n] = chirpReal[n]
+                    imag[transformLength - n] = -chirpImag[n]
+                }
+            }
+            transform(inverse: false)
+            filterReal = real
+            filterImag = imag
+        }
+    }
+    
+    deinit {
+        #if canImport(Accelerate)
+        vDSP_destroy_fftsetupD(setup)
+        #endif
+    }
+    
+    /// Calculate the power of each frequency bin of the signal and store it in `power`.
+    /// - parameter signal: Returns the value of the signal at the given index in `0..<length`.
+    func calculate(_ signal: (Int) -> Double) {
+        if usesChirp {
+            for n in 0..<length {
+                let value = signal(n)
+                real[n] = value * chirpReal[n]
+                imag[n] = value * chirpImag[n]
+            }
+        }
+        else {
+            for n in 0..<length {
+                real[n] = signal(n)
+                imag[n] = 0
+            }
+        }
+        for n in length..<transformLength {
+            real[n] = 0
+            imag[n] = 0
+        }
+        transform(inverse: false)
+        
+        var scale: Double = 1
+        if usesChirp {
+            // Convolve with the filter. The magnitude of the chirp is 1, so the power of each bin is the
+            // power of the convolution scaled by the unnormalized inverse transform.
+            for k in 0..<transformLength {
+                let a = real[k], b = imag[k]
+                real[k] = a * filterReal[k] - b * filterImag[k]
+                imag[k] = a * filterImag[k] + b * filterReal[k]
+            }
+            transform(inverse: true)
+            scale = 1 / Double(transformLength * transformLength)
+        }
+        for k in 0..<power.count {
+            power[k] = (real[k] * real[k] + imag[k] * imag[k]) * scale
+        }
+    }
+    
+    /// Transform the `real` and `imag` buffers in place.
+    private func transform(inverse: Bool) {
+        #if canImport(Accelerate)
+        let direction = FFTDirection(inverse ? kFFTDirection_Inverse : kFFTDirection_Forward)
+        real.withUnsafeMutableBufferPointer { realBuffer in
+            imag.withUnsafeMutableBufferPointer { imagBuffer in
+                var split = DSPDoubleSplitComplex(realp: realBuffer.baseAddress!, imagp: imagBuffer.baseAddress!)
+                vDSP_fft_zipD(setup, &split, 1, log2Length, direction)
+            }
+        }
+        #else
+        let count = transformLength
+        
+        // Reorder the values by bit-reversed index.
+        var j = 0
+        for i in 1..<count {
+            var bit = count >> 1
+            while j & bit != 0 {
+                j ^= bit
+                bit >>= 1
+            }
+            j |= bit
+            if i < j {
+                real.swapAt(i, j)
+                imag.swapAt(i, j)
+            }
+        }
+        
+        // Combine the butterflies.
+        var size = 2
+        while size <= count {
+            let half = size / 2
+            let step = count / size
+            for start in Swift.stride(from: 0, to: count, by: size) {
+                for k in 0..<half {
+                    let wr = twiddleReal[k * step]
+                    let wi = inverse ? -twiddleImag[k * step] : twiddleImag[k * step]
+                    let a = start + k, b = start + k + half
+                    let tr = real[b] * wr - imag[b] * wi
+                    let ti = real[b] * wi + imag[b] * wr
+                    real[b] = real[a] - tr
+                    imag[b] = imag[a] - ti
+                    real[a] += tr
+                    imag[a] += ti
+                }
+            }
+            size *= 2
+        }
+        #endif
+    }
+}
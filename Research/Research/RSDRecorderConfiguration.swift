@@ -102,4 +102,78 @@ public protocol RSDJSONRecorderConfiguration : RSDRecorderConfiguration {
     /// ```
     ///
     var usesRootDictionary: Bool { get }
+    
+    /// The output format to use when writing each sample to the file. If `nil`, then the samples will
+    /// be written using the `.prettyPrinted` format.
+    var jsonOutputFormat: RSDJSONOutputFormat? { get }
+    
+    /// The content encoding to use to compress the file as it is written. If `nil`, then the file is
+    /// not compressed.
+    var contentEncoding: RSDContentEncoding? { get }
+}
+
+extension RSDJSONRecorderConfiguration {
+    
+    /// By default, the samples are written using the `.prettyPrinted` format.
+    public var jsonOutputFormat: RSDJSONOutputFormat? {
+        return nil
+    }
+    
+    /// By default, the file is not compressed.
+    public var contentEncoding: RSDContentEncoding? {
+        return nil
+    }
+}
+
+/// `RSDJSONOutputFormat` describes how the samples written by a `RSDRecordSampleLogger` are formatted
+/// when the samples are encoded as JSON.
+public enum RSDJSONOutputFormat : String, Codable {
+    
+    /// Each sample is pretty-printed and included in the root element of the file. This is the default.
+    case prettyPrinted
+    
+    /// Each sample is written on a single line without whitespace and included in the root element of
+    /// the file. The file is still a valid JSON document, but it is smaller and faster to write.
+    case compact
+    
+    /// Each sample is written on a single line without whitespace and the file does **not** include a
+    /// root element. This is the "newline-delimited JSON" format where each line in the file is a
+    /// valid JSON document.
+    ///
+    /// - seealso: http://ndjson.org
+    case newlineDelimited = "ndjson"
+    
+    /// Is the sample written to a single line?
+    public var isCompact: Bool {
+        return self != .prettyPrinted
+    }
+    
+    /// Does the file include a root element?
+    public var includesRootElement: Bool {
+        return self != .newlineDelimited
+    }
+    
+    /// The content type for a file written using this format.
+    public var contentType: String {
+        return includesRootElement ? "application/json" : "application/x-ndjson"
+    }
+    
+    /// The file extension for a file written using this format.
+    public var fileExtension: String {
+        return includesRootElement ? "json" : "ndjson"
+    }
+}
+
+/// `RSDContentEncoding` describes how a file written by a `RSDDataLogger` is compressed as the data is
+/// written to the file. The raw value is the HTTP content encoding for the file and is included in the
+/// `RSDFileManifest` so that an archive can store the file without compressing it again.
+public enum RSDContentEncoding : String, Codable {
+    
+    /// The file is compressed using a streaming deflate and written in the gzip file format.
+    case gzip
+    
+    /// The path extension to append to the file extension.
+    public var fileExtension: String {
+        return "gz"
+    }
 }
@@ -201,8 +201,9 @@ extension RSDResourceTransformer {
         // get the url
         let (url, resourceType) = try resourceURL(ofType: defaultExtension, bundle: bundle)
         
-        // get the data
-        let data = try Data(contentsOf: url)
+        // get the data. Bundled resources are read-only so the file can be mapped into memory rather than
+        // copied, which lets the decoder page in only what it reads.
+        let data = try Data(contentsOf: url, options: .mappedIfSafe)
         return (data, resourceType)
     }
 }
@@ -63,9 +63,12 @@ public struct RSDResultType : RSDFactoryTypeRepresentable, Codable, Hashable {
     /// Defaults to creating a `RSDNavigationResult`.
     public static let navigation: RSDResultType = "navigation"
     
+    /// Defaults to creating a `RSDWindowedFeaturesResultObject`.
+    public static let windowedFeatures: RSDResultType = "windowedFeatures"
+    
     /// List of all the standard types.
     public static func allStandardTypes() -> [RSDResultType] {
-        return [.base, .answer, .collection, .task, .file, .error, .navigation]
+        return [.base, .answer, .collection, .task, .file, .error, .navigation, .windowedFeatures]
     }
 }
 
@@ -0,0 +1,128 @@
+//
+//  RSDRingBuffer.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDRingBuffer` is a preallocated, lock-free, single-producer/single-consumer queue.
+///
+/// The buffer is intended for handing values from a sensor callback to a serial processing queue
+/// without dispatching a block or allocating memory for each value. One thread may call `push()`
+/// and one thread may call `drain()` concurrently. If the buffer is full, then `push()` will
+/// return `false` and the value is counted as dropped.
+///
+/// - seealso: `RSDSampleRecorder.IngestionPolicy`
+public final class RSDRingBuffer<Element> {
+    
+    /// The number of values that can be held in the buffer. This is always a power of 2.
+    public let capacity: Int
+    
+    private let index: RSDRingBufferIndexRef
+    private let slots: UnsafeMutablePointer<Element?>
+    
+    /// Default initializer.
+    /// - parameter capacity: The minimum number of values that can be held in the buffer. This is
+    ///                       rounded up to the next power of 2.
+    public init(capacity: Int) {
+        let index = RSDRingBufferIndexCreate(max(capacity, 1))
+        self.index = index
+        self.capacity = RSDRingBufferIndexGetCapacity(index)
+        self.slots = UnsafeMutablePointer<Element?>.allocate(capacity: self.capacity)
+        self.slots.initialize(repeating: nil, count: self.capacity)
+    }
+    
+    deinit {
+        slots.deinitialize(count: capacity)
+        slots.deallocate()
+        RSDRingBufferIndexDestroy(index)
+    }
+    
+    /// The number of values waiting to be drained. This is approximate unless called from the
+    /// producer or consumer thread.
+    public var count: Int {
+        return RSDRingBufferIndexGetCount(index)
+    }
+    
+    /// The total number of values that were dropped because the buffer was full.
+    public var droppedCount: Int {
+        return RSDRingBufferIndexGetDropCount(index)
+    }
+    
+    /// **Producer.** Add a value to the buffer.
+    /// - parameter value: The value to add.
+    /// - returns: `true` if the value was added or `false` if the buffer is full and the value was
+    ///            dropped.
+    @discardableResult
+    public func push(_ value: Element) -> Bool {
+        let slot = RSDRingBufferIndexBeginWrite(index)
+        guard slot >= 0 else {
+            RSDRingBufferIndexRecordDrop(index)
+            return false
+        }
+        slots[slot] = value
+        RSDRingBufferIndexCommitWrite(index)
+        return true
+    }
+    
+    /// **Producer.** Mark the buffer as needing to be drained.
+    /// - returns: `true` if the caller should schedule the consumer to drain the buffer or `false`
+    ///            if the consumer is already scheduled.
+    public func scheduleDrain() -> Bool {
+        return RSDRingBufferIndexScheduleDrain(index)
+    }
+    
+    /// **Consumer.** Remove the values from the buffer and append them to the given array.
+    ///
+    /// - parameters:
+    ///     - values: The array to append the values to. Reusing the same array with its capacity
+    ///               reserved allows draining the buffer without allocating memory.
+    ///     - maxCount: The maximum number of values to remove.
+    /// - returns: The number of values that were removed.
+    @discardableResult
+    public func drain(into values: inout [Element], maxCount: Int = .max) -> Int {
+        RSDRingBufferIndexClearDrainScheduled(index)
+        var start: Int = 0
+        let count = min(RSDRingBufferIndexBeginRead(index, &start), maxCount)
+        guard count > 0 else { return 0 }
+        let mask = capacity - 1
+        for ii in 0..<count {
+            let slot = (start + ii) & mask
+            // Move the value out of the slot so that the buffer does not retain it.
+            if let value = slots[slot] {
+                values.append(value)
+            }
+            slots[slot] = nil
+        }
+        RSDRingBufferIndexCommitRead(index, count)
+        return count
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  RSDRingBufferIndex.h
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ An opaque reference to the read and write cursors for a lock-free single-producer/single-consumer ring buffer.
+
+ The cursors are implemented using C11 atomics so that a single producer thread and a single consumer thread can exchange values without taking a lock or allocating memory. The storage for the values is owned by the caller. The cursors only describe which slots in that storage may be written by the producer and which slots may be read by the consumer.
+
+ @warning Only one thread may call the producer functions and only one thread may call the consumer functions at a time.
+ */
+typedef struct RSDRingBufferIndex * RSDRingBufferIndexRef;
+
+/**
+ Create the cursors for a ring buffer.
+
+ @param capacity    The minimum number of slots in the ring buffer. This is rounded up to the next power of 2.
+ @return            A new ring buffer index. The caller is responsible for calling `RSDRingBufferIndexDestroy()`.
+ */
+RSDRingBufferIndexRef RSDRingBufferIndexCreate(NSInteger capacity);
+
+/**
+ Free the memory used by the ring buffer index.
+ */
+void RSDRingBufferIndexDestroy(RSDRingBufferIndexRef index);
+
+/**
+ The number of slots in the ring buffer. This is always a power of 2.
+ */
+NSInteger RSDRingBufferIndexGetCapacity(RSDRingBufferIndexRef index);
+
+/**
+ The number of values that have been written but not yet read. This is exact when called from either the producer or the consumer thread and approximate otherwise.
+ */
+NSInteger RSDRingBufferIndexGetCount(RSDRingBufferIndexRef index);
+
+/**
+ **Producer.** Returns the slot to write the next value into or `-1` if the ring buffer is full. If a slot is returned, then the producer must call `RSDRingBufferIndexCommitWrite()` after writing the value to the slot.
+ */
+NSInteger RSDRingBufferIndexBeginWrite(RSDRingBufferIndexRef index);
+
+/**
+ **Producer.** Publish the value written to the slot returned by `RSDRingBufferIndexBeginWrite()` to the consumer.
+ */
+void RSDRingBufferIndexCommitWrite(RSDRingBufferIndexRef index);
+
+/**
+ **Consumer.** Returns the number of values available to read and sets `startSlot` to the slot of the first value. The values are stored in consecutive slots, wrapping around to slot `0` at the end of the buffer.
+ */
+NSInteger RSDRingBufferIndexBeginRead(RSDRingBufferIndexRef index, NSInteger *startSlot);
+
+/**
+ **Consumer.** Release the given number of slots back to the producer.
+ */
+void RSDRingBufferIndexCommitRead(RSDRingBufferIndexRef index, NSInteger count);
+
+/**
+ Increment the count of values that were dropped because the ring buffer was full.
+
+ @return    The total number of dropped values.
+ */
+NSInteger RSDRingBufferIndexRecordDrop(RSDRingBufferIndexRef index);
+
+/**
+ The total number of values that were dropped because the ring buffer was full.
+ */
+NSInteger RSDRingBufferIndexGetDropCount(RSDRingBufferIndexRef index);
+
+/**
+ Atomically set a flag to mark that the consumer has been scheduled to drain the ring buffer.
+
+ @return    `YES` if the flag was changed by this call and the caller should schedule the consumer, or `NO` if the consumer was already scheduled.
+ */
+BOOL RSDRingBufferIndexScheduleDrain(RSDRingBufferIndexRef index);
+
+/**
+ **Consumer.** Clear the flag set by `RSDRingBufferIndexScheduleDrain()`. This should be called *before* reading the available values so that a value that is written while the consumer is reading will schedule another drain.
+ */
+void RSDRingBufferIndexClearDrainScheduled(RSDRingBufferIndexRef index);
+
+NS_ASSUME_NONNULL_END
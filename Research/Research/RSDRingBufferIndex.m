@@ -0,0 +1,134 @@
+//
+//  RSDRingBufferIndex.m
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "RSDRingBufferIndex.h"
+#import <stdatomic.h>
+#import <stdlib.h>
+
+// The cursors are padded to separate cache lines so that the producer and consumer do not invalidate
+// each other's cache line when updating their own cursor.
+#define RSD_CACHE_LINE_SIZE 64
+
+struct RSDRingBufferIndex {
+    // Written by the producer.
+    _Atomic(NSInteger) tail;
+    char _tailPadding[RSD_CACHE_LINE_SIZE - sizeof(NSInteger)];
+    
+    // Written by the consumer.
+    _Atomic(NSInteger) head;
+    char _headPadding[RSD_CACHE_LINE_SIZE - sizeof(NSInteger)];
+    
+    // Shared state that is updated infrequently.
+    _Atomic(NSInteger) dropCount;
+    atomic_bool drainScheduled;
+    NSInteger capacity;
+    NSInteger mask;
+};
+
+RSDRingBufferIndexRef RSDRingBufferIndexCreate(NSInteger capacity) {
+    NSInteger size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    RSDRingBufferIndexRef index = calloc(1, sizeof(struct RSDRingBufferIndex));
+    atomic_init(&index->tail, 0);
+    atomic_init(&index->head, 0);
+    atomic_init(&index->dropCount, 0);
+    atomic_init(&index->drainScheduled, false);
+    index->capacity = size;
+    index->mask = size - 1;
+    return index;
+}
+
+void RSDRingBufferIndexDestroy(RSDRingBufferIndexRef index) {
+    free(index);
+}
+
+NSInteger RSDRingBufferIndexGetCapacity(RSDRingBufferIndexRef index) {
+    return index->capacity;
+}
+
+NSInteger RSDRingBufferIndexGetCount(RSDRingBufferIndexRef index) {
+    NSInteger head = atomic_load_explicit(&index->head, memory_order_acquire);
+    NSInteger tail = atomic_load_explicit(&index->tail, memory_order_acquire);
+    return tail - head;
+}
+
+NSInteger RSDRingBufferIndexBeginWrite(RSDRingBufferIndexRef index) {
+    NSInteger tail = atomic_load_explicit(&index->tail, memory_order_relaxed);
+    NSInteger head = atomic_load_explicit(&index->head, memory_order_acquire);
+    if (tail - head >= index->capacity) {
+        return -1;
+    }
+    return tail & index->mask;
+}
+
+void RSDRingBufferIndexCommitWrite(RSDRingBufferIndexRef index) {
+    NSInteger tail = atomic_load_explicit(&index->tail, memory_order_relaxed);
+    atomic_store_explicit(&index->tail, tail + 1, memory_order_release);
+}
+
+NSInteger RSDRingBufferIndexBeginRead(RSDRingBufferIndexRef index, NSInteger *startSlot) {
+    NSInteger head = atomic_load_explicit(&index->head, memory_order_relaxed);
+    NSInteger tail = atomic_load_explicit(&index->tail, memory_order_seq_cst);
+    *startSlot = head & index->mask;
+    return tail - head;
+}
+
+void RSDRingBufferIndexCommitRead(RSDRingBufferIndexRef index, NSInteger count) {
+    NSInteger head = atomic_load_explicit(&index->head, memory_order_relaxed);
+    atomic_store_explicit(&index->head, head + count, memory_order_release);
+}
+
+NSInteger RSDRingBufferIndexRecordDrop(RSDRingBufferIndexRef index) {
+    return atomic_fetch_add_explicit(&index->dropCount, 1, memory_order_relaxed) + 1;
+}
+
+NSInteger RSDRingBufferIndexGetDropCount(RSDRingBufferIndexRef index) {
+    return atomic_load_explicit(&index->dropCount, memory_order_relaxed);
+}
+
+// The producer writes `tail` and then reads `drainScheduled`, while the consumer writes `drainScheduled`
+// and then reads `tail`. Release/acquire ordering allows each thread's load to be reordered before its
+// store, so both threads could miss the other's update and the value would sit in the buffer without a
+// drain being scheduled. The sequentially consistent fences prevent that reordering.
+
+BOOL RSDRingBufferIndexScheduleDrain(RSDRingBufferIndexRef index) {
+    atomic_thread_fence(memory_order_seq_cst);
+    return !atomic_exchange_explicit(&index->drainScheduled, true, memory_order_seq_cst);
+}
+
+void RSDRingBufferIndexClearDrainScheduled(RSDRingBufferIndexRef index) {
+    atomic_store_explicit(&index->drainScheduled, false, memory_order_seq_cst);
+    atomic_thread_fence(memory_order_seq_cst);
+}
@@ -248,6 +248,7 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         // Set paused to false and set the start uptime and timestamp
         isPaused = false
         clock = RSDClock()
+        _setupSampleBuffers()
         _syncUpdateStatus(.starting)
         
         self.loggerQueue.async {
@@ -296,6 +297,7 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         self.loggerQueue.async {
             do {
                 self._syncUpdateStatus(.processingResults)
+                self._drainSampleBuffers(ignoringStatus: true)
                 try self._stopLogger()
             } catch let err {
                 self.error = err
@@ -543,6 +545,45 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         return (self.configuration as? RSDJSONRecorderConfiguration)?.usesRootDictionary ?? false
     }
     
+    /// The output format to use when the samples are encoded as JSON. By default, this will return the
+    /// `jsonOutputFormat` defined by the configuration or `.prettyPrinted` if not defined.
+    ///
+    /// - seealso: `RSDJSONOutputFormat`
+    open var jsonOutputFormat: RSDJSONOutputFormat {
+        return (self.configuration as? RSDJSONRecorderConfiguration)?.jsonOutputFormat ?? .prettyPrinted
+    }
+    
+    /// The policy used to split the logging files into segments. By default, this is `nil` and each
+    /// logger writes all the samples to a single file.
+    ///
+    /// If the policy is not `nil`, then each segment is a complete file that is added to the results as
+    /// soon as it is closed so that it can be processed while the recording continues. The identifier of
+    /// the file result for each segment after the first includes the segment index.
+    ///
+    /// - seealso: `RSDDataLogger.RotationPolicy`, `didCloseSegment(_:loggerIdentifier:)`
+    open var rotationPolicy: RSDDataLogger.RotationPolicy? {
+        return nil
+    }
+    
+    /// The content encoding to use to compress the logging files as they are written. By default, this
+    /// will return the `contentEncoding` defined by the configuration or `nil` if not defined.
+    ///
+    /// - seealso: `RSDContentEncoding`
+    open var contentEncoding: RSDContentEncoding? {
+        return (self.configuration as? RSDJSONRecorderConfiguration)?.contentEncoding
+    }
+    
+    /// The policy used to determine when the samples written to each logger are flushed to the file.
+    /// Default = `.writeThrough`.
+    ///
+    /// If the policy has a `flushInterval`, then the loggers are checked on a timer on the `loggerQueue`
+    /// so that the samples are flushed even if the sensor stops sending samples.
+    ///
+    /// - seealso: `RSDDataLogger.FlushPolicy`
+    open var flushPolicy: RSDDataLogger.FlushPolicy {
+        return .writeThrough
+    }
+    
     /// instantiate a marker for recording step transitions as well as start and stop points.
     /// The default implementation will instantiate a `RSDRecordMarker`.
     ///
@@ -574,6 +615,10 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
     ///     - loggerIdentifier: The identifier for the logger for which to create the marker. If nil, then the
     ///                         `defaultLoggerIdentifier` will be used.
     public final func writeSample(_ sample: RSDSampleRecord, loggerIdentifier:String? = nil) {
+        if let buffer = _sampleBuffer(for: loggerIdentifier) {
+            _push(sample, to: buffer)
+            return
+        }
         self.loggerQueue.async {
             // Only write to the file if the recorder status indicates that the logging file is open
             guard self.status >= RSDAsyncActionStatus.starting && self.status <= RSDAsyncActionStatus.running else { return }
@@ -596,6 +641,12 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
     ///     - loggerIdentifier: The identifier for the logger for which to create the marker. If nil, then the
     ///                         `defaultLoggerIdentifier` will be used.
     public final func writeSamples(_ samples: [RSDSampleRecord], loggerIdentifier:String? = nil) {
+        if let buffer = _sampleBuffer(for: loggerIdentifier) {
+            for sample in samples {
+                _push(sample, to: buffer)
+            }
+            return
+        }
         self.loggerQueue.async {
             // Only write to the file if the recorder status indicates that the logging file is open
             guard self.status >= RSDAsyncActionStatus.starting && self.status <= RSDAsyncActionStatus.running else { return }
@@ -622,11 +673,17 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
     /// - returns: A new instance of a `RSDDataLogger`.
     /// - throws: An error if opening the log file failed.
     open func instantiateLogger(with identifier: String) throws -> RSDDataLogger? {
+        let columnarFormat = columnarEncodingFormat()
         let format = stringEncodingFormat()
-        let ext = format?.fileExtension ?? "json"
+        let jsonFormat = self.jsonOutputFormat
+        let encoding = self.contentEncoding
+        var ext = columnarFormat?.fileExtension ?? format?.fileExtension ?? jsonFormat.fileExtension
+        if let encodingExt = encoding?.fileExtension {
+            ext = "\(ext).\(encodingExt)"
+        }
         let shouldDelete = (self.configuration as? RSDRestartableRecorderConfiguration)?.shouldDeletePrevious ?? false
         let url = try RSDFileResultUtility.createFileURL(identifier: identifier, ext: ext, outputDirectory: outputDirectory, shouldDeletePrevious: shouldDelete)
-        return try RSDRecordSampleLogger(identifier: identifier, url: url, usesRootDictionary: self.usesRootDictionary, stringEncodingFormat: format)
+        return try RSDRecordSampleLogger(identifier: identifier, url: url, usesRootDictionary: self.usesRootDictionary, stringEncodingFormat: format, jsonOutputFormat: jsonFormat, columnarFormat: columnarFormat, contentEncoding: encoding, flushPolicy: self.flushPolicy)
     }
     
     /// Returns the string encoding format to use for this file. Default is `nil`. If this is `nil`
@@ -635,6 +692,13 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         return nil
     }
     
+    /// Returns the binary columnar format to use for this file. Default is `nil`. If this is not `nil`
+    /// then it takes precedence over the `stringEncodingFormat()` and the file can be converted to JSON
+    /// or a delimiter-separated file using `RSDColumnarSampleReader`.
+    open func columnarEncodingFormat() -> RSDColumnarSampleFormat? {
+        return nil
+    }
+    
     /// Write a marker to each logging file.
     private func _writeMarkers(step: RSDStep?, taskViewModel: RSDPathComponent) {
         let uptime = RSDClock.uptime()
@@ -642,6 +706,9 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         let date = Date()
         self.loggerQueue.async {
             
+            // Write any buffered samples *before* the marker.
+            self._drainSampleBuffers()
+            
             // Update the marker
             self.updateMarker(step: step, taskViewModel: taskViewModel)
             let stepPath = self.currentStepPath
@@ -663,6 +730,141 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
         }
     }
     
+    // MARK: Sample ingestion
+    
+    /// `IngestionPolicy` is used to configure a recorder to add samples to a preallocated ring
+    /// buffer for each logger rather than dispatching each sample to the `loggerQueue`.
+    ///
+    /// When a sample is written, it is added to the buffer for its logger. The first sample added
+    /// to an empty buffer schedules the buffer to be drained on the `loggerQueue` after the
+    /// `drainInterval`. The samples are then written to the logger in a single batch.
+    ///
+    /// - note: The sample buffers support a *single* producer. All calls to `writeSample()` and
+    ///         `writeSamples()` for a given logger must be made from the same serial queue.
+    public struct IngestionPolicy {
+        
+        /// The number of samples that can be held in the buffer for each logger. If the buffer is
+        /// full, then samples are dropped. This is rounded up to the next power of 2.
+        public var bufferCapacity: Int
+        
+        /// The time to wait after a sample is added to an empty buffer before draining the buffer.
+        /// A longer interval writes larger batches but requires a larger buffer.
+        public var drainInterval: TimeInterval
+        
+        /// Default initializer.
+        public init(bufferCapacity: Int = 1024, drainInterval: TimeInterval = 0.1) {
+            self.bufferCapacity = bufferCapacity
+            self.drainInterval = drainInterval
+        }
+        
+        /// Buffer up to 1024 samples for each logger and drain every 0.1 seconds.
+        public static let `default` = IngestionPolicy()
+    }
+    
+    /// The policy to use for buffering samples. If `nil`, then each call to `writeSample()` or
+    /// `writeSamples()` will dispatch the sample(s) to the `loggerQueue`. Default = `nil`.
+    ///
+    /// - note: This must be set *before* the recorder is started. The sample buffers are created the
+    ///         first time the recorder is started and are reused if the recorder is restarted.
+    public var ingestionPolicy: IngestionPolicy?
+    
+    /// The total number of samples that were dropped because the sample buffer was full.
+    public var droppedSampleCount: Int {
+        return _sampleBuffers.reduce(0) { $0 + $1.value.droppedCount }
+    }
+    
+    /// Called on the `loggerQueue` when samples have been dropped because the sample buffer for the
+    /// given logger was full. The default implementation will print a debug message.
+    ///
+    /// - parameters:
+    ///     - count: The number of samples dropped since the last time this method was called.
+    ///     - loggerIdentifier: The identifier for the logger.
+    open func didDropSamples(_ count: Int, loggerIdentifier: String) {
+        debugPrint("WARNING: \(count) samples dropped from \(loggerIdentifier). Sample buffer is full.")
+    }
+    
+    /// Called on the `loggerQueue` when a logger has closed a segment of its file. The file result for the
+    /// segment has already been added to the results. The default implementation does nothing.
+    ///
+    /// Override this method to start processing the segment (for example, adding it to an archive)
+    /// while the recorder continues to write samples to the next segment.
+    ///
+    /// - parameters:
+    ///     - fileResult: The file result for the closed segment.
+    ///     - loggerIdentifier: The identifier for the logger.
+    open func didCloseSegment(_ fileResult: RSDFileResult, loggerIdentifier: String) {
+    }
+    
+    /// The sample buffers. These are created the first time the recorder is started *before* any
+    /// samples can be written and are never replaced, so the producers can read them without a lock.
+    private var _sampleBuffers: [String : RSDRingBuffer<RSDSampleRecord>] = [:]
+    private var _defaultSampleBuffer: RSDRingBuffer<RSDSampleRecord>?
+    
+    /// Buffer used to drain the samples. This should only be accessed on the `loggerQueue`.
+    private var _drainedSamples: [RSDSampleRecord] = []
+    
+    /// The drop count last reported for each logger. This should only be accessed on the `loggerQueue`.
+    private var _reportedDropCounts: [String : Int] = [:]
+    
+    /// The timer used to flush the loggers. This should only be accessed on the `loggerQueue`.
+    private var _flushTimer: DispatchSourceTimer?
+    
+    private func _setupSampleBuffers() {
+        assert(self.status <= .permissionGranted, "The sample buffers cannot be set up while the recorder is running.")
+        guard let policy = self.ingestionPolicy, _sampleBuffers.isEmpty else { return }
+        for identifier in self.loggerIdentifiers {
+            _sampleBuffers[identifier] = RSDRingBuffer(capacity: policy.bufferCapacity)
+        }
+        _defaultSampleBuffer = _sampleBuffers[self.defaultLoggerIdentifier]
+        _drainedSamples.reserveCapacity(policy.bufferCapacity)
+    }
+    
+    private func _sampleBuffer(for loggerIdentifier: String?) -> RSDRingBuffer<RSDSampleRecord>? {
+        guard let identifier = loggerIdentifier else { return _defaultSampleBuffer }
+        return _sampleBuffers[identifier]
+    }
+    
+    private func _push(_ sample: RSDSampleRecord, to buffer: RSDRingBuffer<RSDSampleRecord>) {
+        buffer.push(sample)
+        if buffer.scheduleDrain() {
+            let interval = self.ingestionPolicy?.drainInterval ?? 0
+            self.loggerQueue.asyncAfter(deadline: .now() + interval) {
+                self._drainSampleBuffers()
+            }
+        }
+    }
+    
+    /// Write the buffered samples to the loggers. This method should be called on the `loggerQueue`.
+    private func _drainSampleBuffers(ignoringStatus: Bool = false) {
+        for (identifier, buffer) in _sampleBuffers {
+            _drainedSamples.removeAll(keepingCapacity: true)
+            buffer.drain(into: &_drainedSamples)
+            
+            let dropCount = buffer.droppedCount
+            let reportedCount = _reportedDropCounts[identifier] ?? 0
+            if dropCount > reportedCount {
+                _reportedDropCounts[identifier] = dropCount
+                didDropSamples(dropCount - reportedCount, loggerIdentifier: identifier)
+            }
+            
+            // Only write to the file if the recorder status indicates that the logging file is open
+            guard _drainedSamples.count > 0,
+                ignoringStatus || (self.status >= RSDAsyncActionStatus.starting && self.status <= RSDAsyncActionStatus.running),
+                let logger = self.loggers[identifier] as? RSDRecordSampleLogger
+                else {
+                    continue
+            }
+            do {
+                try logger.writeSamples(_drainedSamples)
+            } catch let err {
+                DispatchQueue.global().async {
+                    self.didFail(with: err)
+                }
+            }
+        }
+        _drainedSamples.removeAll(keepingCapacity: true)
+    }
+    
     /// Open log files. This method should be called on the `loggerQueue`.
     private func _startLogger(at taskViewModel: RSDPathComponent) throws {
         let step = taskViewModel.currentNode?.step
@@ -672,27 +874,60 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
                 continue
             }
             loggers[identifier] = dataLogger
+            if dataLogger.rotationPolicy == nil {
+                dataLogger.rotationPolicy = self.rotationPolicy
+            }
+            dataLogger.segmentHandler = { [weak self] (logger, segment) in
+                self?._didRotate(logger, closing: segment)
+            }
             if let logger = dataLogger as? RSDRecordSampleLogger {
                 let marker = instantiateMarker(uptime: self.clock.startUptime, timestamp: 0, date: self.clock.startDate, stepPath: currentStepPath, loggerIdentifier: identifier)
                 try logger.writeSample(marker)
             }
         }
+        _startFlushTimer()
+    }
+    
+    /// Start a timer on the `loggerQueue` to flush the loggers if any of them buffer data for a limited
+    /// time. This method should be called on the `loggerQueue`.
+    private func _startFlushTimer() {
+        let intervals = self.loggers.values.compactMap { $0.flushPolicy.flushInterval }
+        guard _flushTimer == nil, let interval = intervals.min() else { return }
+        let timer = DispatchSource.makeTimerSource(queue: self.loggerQueue)
+        timer.schedule(deadline: .now() + interval, repeating: interval)
+        timer.setEventHandler { [weak self] in
+            self?._flushLoggers()
+        }
+        timer.resume()
+        _flushTimer = timer
+    }
+    
+    /// Flush the loggers. This method is called on the `loggerQueue`.
+    private func _flushLoggers() {
+        do {
+            for (_, logger) in self.loggers {
+                try logger.flushIfNeeded()
+            }
+        } catch let err {
+            DispatchQueue.global().async {
+                self.didFail(with: err)
+            }
+        }
     }
     
     /// Close log files. This method should be called on the `loggerQueue`.
     private func _stopLogger() throws {
+        _flushTimer?.cancel()
+        _flushTimer = nil
+        
         var error: Error?
         for (_, logger) in self.loggers {
             do {
                 try logger.close()
                 
                 // Create and add the result
-                var fileResult = RSDFileResultObject(identifier: self.configuration.identifier)
-                fileResult.startDate = self.startDate
-                fileResult.endDate = Date()
-                fileResult.url = logger.url
-                fileResult.startUptime = self.clock.startSystemUptime
-                fileResult.contentType = logger.contentType
+                let startDate = logger.closedSegments.isEmpty ? self.startDate : logger.segmentStartDate
+                let fileResult = _fileResult(for: logger, url: logger.url, segmentIndex: logger.segmentIndex, startDate: startDate, endDate: Date())
                 self.appendResults(fileResult)
             }
             catch let err {
@@ -708,6 +943,48 @@ open class RSDSampleRecorder : NSObject, RSDAsyncAction {
             throw error!
         }
     }
+    
+    /// Called when a logger has closed a segment and opened the next one. This method is called on the
+    /// `loggerQueue`.
+    private func _didRotate(_ logger: RSDDataLogger, closing segment: RSDDataLogger.Segment) {
+        let startDate = (segment.index == 0) ? self.startDate : segment.startDate
+        let fileResult = _fileResult(for: logger, url: segment.url, segmentIndex: segment.index, startDate: startDate, endDate: segment.endDate)
+        self.appendResults(fileResult)
+        
+        // Start the new segment with a marker so that the file can be processed on its own. This is
+        // called after the rotation is complete and the first write to a segment never rotates it.
+        if let recordLogger = logger as? RSDRecordSampleLogger {
+            let uptime = RSDClock.uptime()
+            let timestamp = clock.zeroRelativeTime(to: ProcessInfo.processInfo.systemUptime)
+            let marker = instantiateMarker(uptime: uptime, timestamp: timestamp, date: Date(), stepPath: currentStepPath, loggerIdentifier: logger.identifier)
+            do {
+                try recordLogger.writeSample(marker)
+            } catch let err {
+                DispatchQueue.global().async {
+                    self.didFail(with: err)
+                }
+            }
+        }
+        
+        didCloseSegment(fileResult, loggerIdentifier: logger.identifier)
+    }
+    
+    /// Create the file result for a file written by the given logger. The identifier for each segment after
+    /// the first includes the segment index so that it does not replace the file result for the previous
+    /// segment in the `collectionResult`.
+    ///
+    /// - example: "motion", "motion-1", "motion-2"
+    private func _fileResult(for logger: RSDDataLogger, url: URL, segmentIndex: Int, startDate: Date, endDate: Date) -> RSDFileResultObject {
+        let identifier = (segmentIndex > 0) ? "\(self.configuration.identifier)-\(segmentIndex)" : self.configuration.identifier
+        var fileResult = RSDFileResultObject(identifier: identifier)
+        fileResult.startDate = startDate
+        fileResult.endDate = endDate
+        fileResult.url = url
+        fileResult.startUptime = self.clock.startSystemUptime
+        fileResult.contentType = logger.contentType
+        fileResult.contentEncoding = logger.contentEncoding?.rawValue
+        return fileResult
+    }
 }
 
 /// A protocol that can be used to define the keys and header to use in a string-separated file.
@@ -782,13 +1059,41 @@ public class RSDRecordSampleLogger : RSDDataLogger {
     /// used to support encoding in that format.
     public let stringEncodingFormat: RSDStringSeparatedEncodingFormat?
     
-    /// Returns "application/json" or the string encoding if applicable.
+    /// The output format used to write the samples if the samples are encoded as JSON.
+    /// - seealso: `RSDSampleRecorder.jsonOutputFormat`
+    public let jsonOutputFormat: RSDJSONOutputFormat
+    
+    /// Does the recorder use a binary columnar format for saving the samples? If so, this describes the
+    /// columns and takes precedence over both the string encoding format and the JSON output format.
+    /// - seealso: `RSDSampleRecorder.columnarEncodingFormat()`
+    public let columnarFormat: RSDColumnarSampleFormat?
+    
+    /// Returns the JSON content type or the string encoding if applicable.
     override public var contentType: String? {
-        return stringEncodingFormat?.contentType ?? "application/json"
+        return columnarFormat?.contentType ?? stringEncodingFormat?.contentType ?? jsonOutputFormat.contentType
     }
     
     private let startText: String
     
+    /// The encoder used to encode each sample as JSON. The encoder is created once and reused for the
+    /// life of the logger.
+    private let jsonEncoder: JSONEncoder
+    
+    /// The UTF-8 encoded separator to write before each sample that is not the first sample.
+    private let sampleSeparator: Data
+    
+    /// The encoder used to encode each sample as a row in a delimiter-separated file.
+    private let delimiterEncoder: RSDDelimiterSeparatedEncoder?
+    
+    /// The encoder used to collect samples into blocks if the samples are written using a columnar format.
+    private let columnarEncoder: RSDColumnarSampleEncoder?
+    
+    /// The system uptime when the last columnar block was written.
+    private var lastBlockUptime: TimeInterval = ProcessInfo.processInfo.systemUptime
+    
+    /// Reusable buffer used to build each row before writing it to the file.
+    private var rowData = Data()
+    
     /// Default initializer. The initializer will automatically open the file and write the
     /// JSON root element and start the sample array.
     ///
@@ -796,13 +1101,35 @@ public class RSDRecordSampleLogger : RSDDataLogger {
     ///     - identifier: A unique identifier for the logger.
     ///     - url: The url to the file.
     ///     - usesRootDictionary: Is the root element in the json file a dictionary?
-    public init(identifier: String, url: URL, usesRootDictionary: Bool, stringEncodingFormat: RSDStringSeparatedEncodingFormat? = nil) throws {
+    ///     - stringEncodingFormat: The string encoding format to use, or `nil` to use JSON.
+    ///     - jsonOutputFormat: The output format to use if the samples are encoded as JSON.
+    ///     - columnarFormat: The binary columnar format to use, or `nil` to use a text format.
+    ///     - contentEncoding: The content encoding to use to compress the file, or `nil` to write the
+    ///                        samples without compression.
+    ///     - flushPolicy: The policy used to determine when to flush appended data to the file.
+    public init(identifier: String, url: URL, usesRootDictionary: Bool, stringEncodingFormat: RSDStringSeparatedEncodingFormat? = nil, jsonOutputFormat: RSDJSONOutputFormat = .prettyPrinted, columnarFormat: RSDColumnarSampleFormat? = nil, contentEncoding: RSDContentEncoding? = nil, flushPolicy: FlushPolicy = .writeThrough) throws {
         self.usesRootDictionary = usesRootDictionary
         self.stringEncodingFormat = stringEncodingFormat
+        self.jsonOutputFormat = jsonOutputFormat
+        self.columnarFormat = columnarFormat
+        self.columnarEncoder = columnarFormat.map { RSDColumnarSampleEncoder(format: $0) }
+        
+        let jsonEncoder = RSDFactory.shared.createJSONEncoder()
+        if jsonOutputFormat.isCompact {
+            jsonEncoder.outputFormatting = []
+        }
+        self.jsonEncoder = jsonEncoder
+        self.sampleSeparator = Data((jsonOutputFormat.includesRootElement ? ",\n" : "\n").utf8)
         
         let startText: String
-        if let format = stringEncodingFormat {
+        if columnarFormat != nil {
+            // The binary format starts with its own header.
+            startText = ""
+        } else if let format = stringEncodingFormat {
             startText = "\(format.fileTableHeader())"
+        } else if !jsonOutputFormat.includesRootElement {
+            // Newline-delimited JSON does not have a root element.
+            startText = ""
         } else if usesRootDictionary {
             // If this json file uses a dictionary as its root, then add a start date timestamp
             // and a key for the items in the dictionary.
@@ -817,12 +1144,15 @@ public class RSDRecordSampleLogger : RSDDataLogger {
             // Otherwise, just open the array
             startText = "[\n"
         }
-        guard let data = startText.data(using: .utf8) else {
+        guard let data = columnarFormat?.headerData() ?? startText.data(using: .utf8) else {
             throw RSDRecordSampleLoggerError.stringEncodingFailed(startText)
         }
         self.startText = startText
+        self.delimiterEncoder = stringEncodingFormat.map {
+            RSDDelimiterSeparatedEncoder(codingKeys: $0.codingKeys(), delimiter: $0.encodingSeparator)
+        }
         
-        try super.init(identifier: identifier, url: url, initialData: data)
+        try super.init(identifier: identifier, url: url, initialData: data, contentEncoding: contentEncoding, flushPolicy: flushPolicy)
     }
     
     /// Write multiple samples to the logger.
@@ -838,57 +1168,82 @@ public class RSDRecordSampleLogger : RSDDataLogger {
     /// - parameter sample: The sample to add to the logging file.
     /// - throws: Error if writing the sample fails because the wasn't enough memory on the device.
     public func writeSample(_ sample: RSDSampleRecord) throws {
-        if let format = self.stringEncodingFormat {
-            let string = try sample.rsd_delimiterEncodedString(with: format.codingKeys(), delimiter: format.encodingSeparator)
-            if sampleCount > 0 || startText.count > 0 {
-                try write("\n\(string)")
-            } else {
-                try write("\(string)")
+        if let encoder = self.columnarEncoder {
+            try encoder.append(sample)
+            if encoder.isBlockFull {
+                try writeBlock()
+            }
+        }
+        else if let encoder = self.delimiterEncoder {
+            rowData.removeAll(keepingCapacity: true)
+            if segmentSampleCount > 0 || startText.count > 0 {
+                rowData.append(0x0A) // "\n"
             }
+            try encoder.encode(sample, appendingTo: &rowData)
+            try write(rowData)
         }
         else {
-            if sampleCount > 0 {
-                // If this is not the first sample then write a comma and line feed
-                try write(",\n")
+            rowData.removeAll(keepingCapacity: true)
+            if segmentSampleCount > 0 {
+                // If this is not the first sample then write a separator (comma and/or line feed)
+                rowData.append(sampleSeparator)
             }
-            let data = try sample.rsd_jsonEncodedData()
-            try write(data)
+            rowData.append(try sample.rsd_encodeObject(to: jsonEncoder))
+            try write(rowData)
         }
     }
     
-    /// Close the file. This will write the end tag for the root element and then close the file handle.
-    /// If there is an error thrown by writing the closing tag, then the file handle will be closed and
-    /// the error will be rethrown.
-    ///
-    /// - throws: Error thrown when attempting to write the closing tag.
-    public override func close() throws {
+    /// Write a partial columnar block if the flush interval has elapsed and then flush the buffered data.
+    public override func flushIfNeeded() throws {
+        if shouldWriteBlock() {
+            try writeBlock()
+        }
+        try super.flushIfNeeded()
+    }
+    
+    /// Returns the data to write at the end of each file. If the samples are written using a columnar
+    /// format, this is the last block. Otherwise, if the samples are encoded as JSON with a root element,
+    /// this is the end tag for the root element.
+    public override func segmentTrailerData() throws -> Data? {
         
-        /// If there is a string encoding format, then there isn't a need for a JSON closure.
-        guard self.stringEncodingFormat == nil else {
-            try super.close()
-            return
+        // If the samples are written using a columnar format, then write the last block. Each file has
+        // its own string table.
+        if let encoder = self.columnarEncoder {
+            lastBlockUptime = ProcessInfo.processInfo.systemUptime
+            let count = encoder.rowCount
+            let data = (count > 0) ? encoder.encodeBlock() : nil
+            encoder.resetStringTable()
+            addToSampleCount(count)
+            return data
+        }
+        
+        /// If there is a string encoding format or the file does not have a root element, then there
+        /// isn't a need for a JSON closure.
+        guard self.stringEncodingFormat == nil, self.jsonOutputFormat.includesRootElement else {
+            return nil
         }
         
         // Write the json closure to the file
         let endText = usesRootDictionary ? "\n]\n}" : "\n]"
-        var writeError: Error?
-        do {
-            try write(endText)
-        } catch let err {
-            writeError = err
-        }
-        try super.close()
-        // If there was an error writing the closure, then rethrow that error *after* closing the file
-        if let error = writeError {
-            throw error
+        guard let data = endText.data(using: .utf8) else {
+            throw RSDRecordSampleLoggerError.stringEncodingFailed(endText)
         }
+        return data
     }
     
-    private func write(_ string: String) throws {
-        guard let data = string.data(using: .utf8) else {
-            throw RSDRecordSampleLoggerError.stringEncodingFailed(string)
-        }
-        try write(data)
+    /// Write the samples collected by the columnar encoder as a block.
+    private func writeBlock() throws {
+        lastBlockUptime = ProcessInfo.processInfo.systemUptime
+        guard let encoder = self.columnarEncoder, encoder.rowCount > 0 else { return }
+        let count = encoder.rowCount
+        try write(encoder.encodeBlock(), sampleCount: count)
+    }
+    
+    /// A partial block is written if the flush interval has elapsed so that the samples are not held in
+    /// memory longer than they would be using a text format.
+    private func shouldWriteBlock() -> Bool {
+        guard let interval = flushPolicy.flushInterval else { return false }
+        return ProcessInfo.processInfo.systemUptime - lastBlockUptime >= interval
     }
 }
 
@@ -52,7 +52,17 @@ public struct RSDSectionStepObject: RSDSectionStep, RSDConditionalStepNavigator,
     public let steps: [RSDStep]
     
     /// A list of step markers to use for calculating progress.
-    public var progressMarkers: [String]?
+    public var progressMarkers: [String]? {
+        didSet {
+            _stepNavigatorIndex.setProgressMarkers(progressMarkers)
+        }
+    }
+    
+    /// The index of the steps in this section. This is built once when the section is initialized.
+    public var stepNavigatorIndex: RSDStepNavigatorIndex? {
+        return _stepNavigatorIndex
+    }
+    private var _stepNavigatorIndex: RSDStepNavigatorIndex
     
     /// A list of asynchronous actions to run on the task.
     public var asyncActions: [RSDAsyncActionConfiguration]?
@@ -69,6 +79,7 @@ public struct RSDSectionStepObject: RSDSectionStep, RSDConditionalStepNavigator,
         self.identifier = identifier
         self.steps = steps
         self.stepType = type ?? .section
+        self._stepNavigatorIndex = RSDStepNavigatorIndex(steps: steps)
     }
     
     /// Instantiate a step result that is appropriate for this step. The default for this struct is a `RSDTaskResultObject`.
@@ -157,8 +168,11 @@ public struct RSDSectionStepObject: RSDSectionStep, RSDConditionalStepNavigator,
         self.identifier = try container.decode(String.self, forKey: .identifier)
         self.stepType = try container.decode(RSDStepType.self, forKey: .stepType)
         let stepsContainer = try container.nestedUnkeyedContainer(forKey: .steps)
-        self.steps = try decoder.factory.decodeSteps(from: stepsContainer)
-        self.progressMarkers = try container.decodeIfPresent([String].self, forKey: .progressMarkers)
+        let steps = try decoder.factory.decodeSteps(from: stepsContainer)
+        let progressMarkers = try container.decodeIfPresent([String].self, forKey: .progressMarkers)
+        self.steps = steps
+        self.progressMarkers = progressMarkers
+        self._stepNavigatorIndex = RSDStepNavigatorIndex(steps: steps, progressMarkers: progressMarkers)
         self.asyncActions = try self.decodeAsyncActions(from: decoder, initialActions: nil)
     }
     
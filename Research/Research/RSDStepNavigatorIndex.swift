@@ -0,0 +1,165 @@
+//
+//  RSDStepNavigatorIndex.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDStepNavigatorIndex` is an immutable lookup table for the steps of an `RSDOrderedStepNavigator`. It maps
+/// each step identifier to the index of the step within the `steps` array and caches the navigation rules of
+/// each step so that navigating forward does not require searching the step array or casting each step.
+///
+/// The cached rules are the same as those returned by the default implementation of `RSDConditionalStepNavigator`
+/// where the step *is* the rule. A navigator that customizes `navigationRule(for:)` or `navigationSkipRule(for:)`
+/// should not return an index.
+///
+/// - seealso: `RSDOrderedStepNavigator.stepNavigatorIndex`
+public struct RSDStepNavigatorIndex {
+    
+    fileprivate struct StepRules {
+        let sectionNavigator: RSDConditionalStepNavigator?
+        let navigationRule: RSDNavigationRule?
+        let navigationSkipRule: RSDNavigationSkipRule?
+        
+        init(step: RSDStep) {
+            self.sectionNavigator = step as? RSDConditionalStepNavigator
+            self.navigationRule = step as? RSDNavigationRule
+            self.navigationSkipRule = step as? RSDNavigationSkipRule
+        }
+    }
+    
+    /// The identifiers of the steps in order.
+    public let identifiers: [String]
+    
+    /// A mapping of the step identifier to the index of the first step with that identifier.
+    private let indexMap: [String : Int]
+    
+    /// The cached rules for each step.
+    private let rules: [StepRules]
+    
+    /// A mapping of the progress marker to the last index of that marker in the list of progress markers.
+    public private(set) var progressMarkerIndex: [String : Int]?
+    
+    /// Initialize the index for the given steps.
+    /// - parameters:
+    ///     - steps: The ordered list of steps.
+    ///     - progressMarkers: The progress markers used by the navigator. Default = `nil`.
+    public init(steps: [RSDStep], progressMarkers: [String]? = nil) {
+        self.init(identifiers: steps.map { $0.identifier }, rules: steps.map { StepRules(step: $0) })
+        self.setProgressMarkers(progressMarkers)
+    }
+    
+    private init(identifiers: [String], rules: [StepRules]) {
+        self.identifiers = identifiers
+        self.rules = rules
+        var indexMap = [String : Int](minimumCapacity: identifiers.count)
+        for (idx, identifier) in identifiers.enumerated() where indexMap[identifier] == nil {
+            indexMap[identifier] = idx
+        }
+        self.indexMap = indexMap
+    }
+    
+    /// The number of steps included in the index.
+    public var count: Int {
+        return identifiers.count
+    }
+    
+    /// The number of unique step identifiers.
+    public var uniqueCount: Int {
+        return indexMap.count
+    }
+    
+    /// The index of the first step with the given identifier.
+    public func index(of identifier: String) -> Int? {
+        return indexMap[identifier]
+    }
+    
+    /// Whether or not the index includes a step with the given identifier.
+    public func contains(_ identifier: String) -> Bool {
+        return indexMap[identifier] != nil
+    }
+    
+    /// The step at the given index cast to a conditional step navigator (if it is a section or subtask).
+    public func sectionNavigator(at index: Int) -> RSDConditionalStepNavigator? {
+        return rules[index].sectionNavigator
+    }
+    
+    /// The navigation rule (if any) of the step at the given index.
+    public func navigationRule(at index: Int) -> RSDNavigationRule? {
+        return rules[index].navigationRule
+    }
+    
+    /// The navigation skip rule (if any) of the step at the given index.
+    public func navigationSkipRule(at index: Int) -> RSDNavigationSkipRule? {
+        return rules[index].navigationSkipRule
+    }
+    
+    /// Set the progress markers used to calculate progress.
+    public mutating func setProgressMarkers(_ progressMarkers: [String]?) {
+        guard let markers = progressMarkers else {
+            self.progressMarkerIndex = nil
+            return
+        }
+        var markerIndex = [String : Int](minimumCapacity: markers.count)
+        for (idx, marker) in markers.enumerated() {
+            markerIndex[marker] = idx
+        }
+        self.progressMarkerIndex = markerIndex
+    }
+    
+    /// Return a copy of the index with the step inserted at the given index. The cached rules for the
+    /// existing steps are reused.
+    public func inserting(_ step: RSDStep, at index: Int, progressMarkers: [String]?) -> RSDStepNavigatorIndex {
+        var identifiers = self.identifiers
+        var rules = self.rules
+        identifiers.insert(step.identifier, at: index)
+        rules.insert(StepRules(step: step), at: index)
+        var copy = RSDStepNavigatorIndex(identifiers: identifiers, rules: rules)
+        copy.setProgressMarkers(progressMarkers)
+        return copy
+    }
+    
+    /// Return a copy of the index with the steps with the given identifiers removed. The cached rules for the
+    /// remaining steps are reused.
+    public func removing(_ stepIdentifiers: Set<String>, progressMarkers: [String]?) -> RSDStepNavigatorIndex {
+        var identifiers = [String]()
+        var rules = [StepRules]()
+        identifiers.reserveCapacity(self.identifiers.count)
+        rules.reserveCapacity(self.rules.count)
+        for (identifier, rule) in zip(self.identifiers, self.rules) where !stepIdentifiers.contains(identifier) {
+            identifiers.append(identifier)
+            rules.append(rule)
+        }
+        var copy = RSDStepNavigatorIndex(identifiers: identifiers, rules: rules)
+        copy.setProgressMarkers(progressMarkers)
+        return copy
+    }
+}
@@ -0,0 +1,156 @@
+//
+//  RSDTaskCache.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDTaskCache` is a thread-safe, in-memory cache of decoded tasks. When the total cost of the cached tasks
+/// is greater than the memory budget, the least recently used tasks are evicted.
+///
+/// The cost of a task is an estimate of the memory used by the decoded task. By default, the task repository
+/// uses the size of the resource file that the task was decoded from.
+///
+/// - seealso: `RSDTaskRepository.taskCache`
+public final class RSDTaskCache {
+    
+    /// The key used to identify a decoded task.
+    public struct Key : Hashable {
+        
+        /// The identifier of the task.
+        public let identifier: String
+        
+        /// The URL of the resource that the task is decoded from (if known).
+        public let resourceURL: URL?
+        
+        /// The schema identifier (if any).
+        public let schemaIdentifier: String?
+        
+        /// The schema revision (if any).
+        public let schemaRevision: Int?
+        
+        public init(identifier: String, resourceURL: URL? = nil, schemaInfo: RSDSchemaInfo? = nil) {
+            self.identifier = identifier
+            self.resourceURL = resourceURL
+            self.schemaIdentifier = schemaInfo?.schemaIdentifier
+            self.schemaRevision = schemaInfo?.schemaVersion
+        }
+    }
+    
+    private struct Entry {
+        let task: RSDTask
+        let cost: Int
+        var lastAccess: UInt64
+    }
+    
+    /// The maximum total cost of the tasks held by the cache.
+    public let memoryBudget: Int
+    
+    /// The total cost of the tasks currently held by the cache.
+    public var totalCost: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return _totalCost
+    }
+    
+    /// The number of tasks currently held by the cache.
+    public var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return entries.count
+    }
+    
+    private let lock = NSLock()
+    private var entries: [Key : Entry] = [:]
+    private var _totalCost: Int = 0
+    private var accessCount: UInt64 = 0
+    
+    /// Default initializer.
+    /// - parameter memoryBudget: The maximum total cost of the cached tasks. Default = 8 MB.
+    public init(memoryBudget: Int = 8 * 1024 * 1024) {
+        self.memoryBudget = memoryBudget
+    }
+    
+    /// Returns the cached task for the given key and marks it as the most recently used task.
+    public func task(for key: Key) -> RSDTask? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard entries[key] != nil else { return nil }
+        accessCount += 1
+        entries[key]!.lastAccess = accessCount
+        return entries[key]!.task
+    }
+    
+    /// Add the task to the cache. If the cost of the task is greater than the memory budget, then the task
+    /// is not cached. Otherwise, the least recently used tasks are evicted until the total cost is within
+    /// the budget.
+    ///
+    /// - parameters:
+    ///     - task: The task to add.
+    ///     - key: The key for the task.
+    ///     - cost: The estimated cost of the task.
+    public func insert(_ task: RSDTask, for key: Key, cost: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        if let previous = entries.removeValue(forKey: key) {
+            _totalCost -= previous.cost
+        }
+        guard cost <= memoryBudget else { return }
+        
+        while _totalCost + cost > memoryBudget,
+            let oldest = entries.min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+                entries[oldest.key] = nil
+                _totalCost -= oldest.value.cost
+        }
+        
+        accessCount += 1
+        entries[key] = Entry(task: task, cost: cost, lastAccess: accessCount)
+        _totalCost += cost
+    }
+    
+    /// Remove the task with the given key.
+    public func removeTask(for key: Key) {
+        lock.lock()
+        defer { lock.unlock() }
+        if let previous = entries.removeValue(forKey: key) {
+            _totalCost -= previous.cost
+        }
+    }
+    
+    /// Remove all the cached tasks.
+    public func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        entries.removeAll()
+        _totalCost = 0
+    }
+}
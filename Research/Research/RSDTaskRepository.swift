@@ -45,17 +45,38 @@ open class RSDTaskRepository : NSObject {
     /// Pointer to a task transformer used to retain the transformer while the task is being fetched.
     private var _taskTransformers = [UUID : RSDTaskTransformer]()
     
+    /// The cache of decoded tasks. If `nil`, then tasks are decoded each time they are fetched. Default = `nil`.
+    ///
+    /// If the cache is set, then a fetched task is returned as a copy of the cached task (if the task conforms
+    /// to `RSDCopyTask`), and concurrent fetches of the same task are coalesced into a single fetch.
+    public var taskCache: RSDTaskCache?
+    
+    /// The queue used to prefetch tasks.
+    private let prefetchQueue = DispatchQueue(label: "org.sagebase.Research.TaskRepository.prefetch", qos: .utility)
+    
+    /// The lock used to protect the transformers and the pending fetches.
+    private let lock = NSLock()
+    
+    /// The completion handlers waiting on a task that is currently being fetched.
+    private var _pendingFetches = [RSDTaskCache.Key : [(RSDTask?, Error?) -> Void]]()
+    
     /// Fetch the task for a given task info. The base class implementation will fetch the task from the
     /// `resourceTransformer` that is optionally included on the task info or from an embedded resource.
     open func fetchTask(for taskInfo: RSDTaskInfo, completion: @escaping FetchCompletionHandler) {
         do {
             let taskTransformer = try self.taskTransformer(for: taskInfo)
             let schemaInfo = self.schemaInfo(for: taskInfo)
+            if let cache = self.taskCache, !(taskTransformer is RSDCopyTask) {
+                _fetchTask(for: taskInfo, taskTransformer: taskTransformer, schemaInfo: schemaInfo, cache: cache, isPrefetch: false) { (task, error) in
+                    completion(taskInfo, task, error)
+                }
+                return
+            }
             let uuid = UUID()
-            _taskTransformers[uuid] = taskTransformer
+            _retain(taskTransformer, uuid)
             taskTransformer.fetchTask(with: taskInfo.identifier, schemaInfo: schemaInfo) { [weak self] (task, error) in
                 completion(taskInfo, task, error)
-                self?._taskTransformers[uuid] = nil
+                self?._release(uuid)
             }
         } catch let error {
             DispatchQueue.main.async {
@@ -64,6 +85,122 @@ open class RSDTaskRepository : NSObject {
         }
     }
     
+    /// Decode the tasks for the given task infos on a background queue and add them to the `taskCache`. If the
+    /// repository does not have a task cache, then this method does nothing.
+    ///
+    /// - parameters:
+    ///     - taskInfos: The task infos for the tasks to prefetch.
+    ///     - completion: The completion handler called on the main queue when all the tasks have been fetched.
+    open func prefetchTasks(for taskInfos: [RSDTaskInfo], completion: (() -> Void)? = nil) {
+        let group = DispatchGroup()
+        if let cache = self.taskCache {
+            for taskInfo in taskInfos {
+                guard let taskTransformer = try? self.taskTransformer(for: taskInfo),
+                    !(taskTransformer is RSDCopyTask)
+                    else {
+                        continue
+                }
+                group.enter()
+                _fetchTask(for: taskInfo, taskTransformer: taskTransformer, schemaInfo: self.schemaInfo(for: taskInfo), cache: cache, isPrefetch: true) { (_, _) in
+                    group.leave()
+                }
+            }
+        }
+        group.notify(queue: .main) {
+            completion?()
+        }
+    }
+    
+    /// Returns the key to use to cache the task for the given task info.
+    open func cacheKey(for taskInfo: RSDTaskInfo, taskTransformer: RSDTaskTransformer, schemaInfo: RSDSchemaInfo?) -> RSDTaskCache.Key {
+        let url = (taskTransformer as? RSDResourceTransformer).flatMap { try? $0.fullURL() }
+        return RSDTaskCache.Key(identifier: taskInfo.identifier, resourceURL: url, schemaInfo: schemaInfo)
+    }
+    
+    /// Returns the estimated memory cost of the decoded task. The base class implementation returns the size
+    /// of the resource file if the task was decoded from a local file, or 64 KB otherwise.
+    open func cacheCost(for task: RSDTask, key: RSDTaskCache.Key) -> Int {
+        if let url = key.resourceURL, url.isFileURL,
+            let fileSize = (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize {
+            return fileSize
+        }
+        return 64 * 1024
+    }
+    
+    private func _fetchTask(for taskInfo: RSDTaskInfo, taskTransformer: RSDTaskTransformer, schemaInfo: RSDSchemaInfo?, cache: RSDTaskCache, isPrefetch: Bool, completion: @escaping (RSDTask?, Error?) -> Void) {
+        let key = self.cacheKey(for: taskInfo, taskTransformer: taskTransformer, schemaInfo: schemaInfo)
+        if let task = cache.task(for: key) {
+            DispatchQueue.main.async {
+                completion(self._copy(task), nil)
+            }
+            return
+        }
+        
+        // If the task is already being fetched then wait for that fetch to finish.
+        lock.lock()
+        if _pendingFetches[key] != nil {
+            _pendingFetches[key]!.append(completion)
+            lock.unlock()
+            return
+        }
+        _pendingFetches[key] = [completion]
+        lock.unlock()
+        
+        let finish: (RSDTask?, Error?) -> Void = { (task, error) in
+            if let task = task {
+                cache.insert(task, for: key, cost: self.cacheCost(for: task, key: key))
+            }
+            self.lock.lock()
+            let handlers = self._pendingFetches.removeValue(forKey: key) ?? []
+            self.lock.unlock()
+            handlers.forEach { $0(task.map { self._copy($0) }, error) }
+        }
+        
+        // Prefetch local resources on a low priority queue rather than using the transformer which decodes
+        // on the default global queue.
+        if isPrefetch, let resourceTransformer = taskTransformer as? RSDTaskResourceTransformer,
+            !resourceTransformer.isOnlineResourceURL() {
+            prefetchQueue.async {
+                do {
+                    let task = try resourceTransformer.factory.decodeTask(with: resourceTransformer, taskIdentifier: taskInfo.identifier, schemaInfo: schemaInfo)
+                    DispatchQueue.main.async {
+                        finish(task, nil)
+                    }
+                } catch let err {
+                    DispatchQueue.main.async {
+                        finish(nil, err)
+                    }
+                }
+            }
+            return
+        }
+        
+        let uuid = UUID()
+        _retain(taskTransformer, uuid)
+        taskTransformer.fetchTask(with: taskInfo.identifier, schemaInfo: schemaInfo) { [weak self] (task, error) in
+            finish(task, error)
+            self?._release(uuid)
+        }
+    }
+    
+    /// Cached tasks are shared so return a copy of the task if possible.
+    private func _copy(_ task: RSDTask) -> RSDTask {
+        guard let copyTask = task as? RSDCopyTask else { return task }
+        return copyTask.copy(with: task.identifier, schemaInfo: task.schemaInfo)
+    }
+    
+    private func _retain(_ taskTransformer: RSDTaskTransformer, _ uuid: UUID) {
+        lock.lock()
+        _taskTransformers[uuid] = taskTransformer
+        lock.unlock()
+    }
+    
+    private func _release(_ uuid: UUID) {
+        lock.lock()
+        _taskTransformers[uuid] = nil
+        lock.unlock()
+    }
+    
     /// Returns the schema to use for the given task info.
     open func schemaInfo(for taskInfo: RSDTaskInfo) -> RSDSchemaInfo? {
         return taskInfo.schemaInfo
@@ -52,6 +52,27 @@ public protocol RSDTaskResult : RSDResult, RSDAnswerResultFinder {
     /// The step history is used to describe the path you took to get to where you are going, whereas
     /// the asynchronous results include any canonical results that are independent of path.
     var asyncResults: [RSDResult]? { get set }
+    
+    /// Find a result within the step history.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    func findResult(with identifier: String) -> RSDResult?
+    
+    /// Append the result to the end of the step history, replacing the previous instance with the same identifier.
+    /// - parameter result:  The result to add to the step history.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating func appendStepHistory(with result: RSDResult) -> RSDResult?
+    
+    /// Remove results from the step history from the result with the given identifier to the end of the array.
+    /// - parameter stepIdentifier:  The identifier of the result associated with the given step.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating func removeStepHistory(from stepIdentifier: String) -> Array<RSDResult>?
+    
+    /// Append the async results with the given result, replacing the previous instance with the same identifier.
+    /// - parameter result:  The result to add to the async results.
+    mutating func appendAsyncResult(with result: RSDResult)
 }
 
 /// The `RSDTaskRunResult` is a task result where the task run UUID can be set to allow for nested
@@ -68,7 +89,7 @@ extension RSDTaskResult  {
     /// - parameter step: The step associated with the result.
     /// - returns: The result or `nil` if not found.
     public func findResult(for step: RSDStep) -> RSDResult? {
-        return self.stepHistory.first(where: { $0.identifier == step.identifier })
+        return self.findResult(with: step.identifier)
     }
     
     /// Find a result within the step history.
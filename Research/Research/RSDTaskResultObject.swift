@@ -60,10 +60,34 @@ public struct RSDTaskResultObject : RSDTaskRunResult, Codable {
     
     /// A listing of the step history for this task or section. The listed step results should *only* include the
     /// last result for any given step.
-    public var stepHistory: [RSDResult] = []
+    public var stepHistory: [RSDResult] {
+        get { return _stepHistory.results }
+        set { _stepHistory = RSDIndexedResults(newValue) }
+    }
+    private var _stepHistory = RSDIndexedResults() {
+        didSet { _invalidateAnswerIndex() }
+    }
     
     /// A list of all the asynchronous results for this task. The list should include uniquely identified results.
-    public var asyncResults: [RSDResult]?
+    public var asyncResults: [RSDResult]? {
+        get { return _asyncResults?.results }
+        set { _asyncResults = newValue.map { RSDIndexedResults($0) } }
+    }
+    private var _asyncResults: RSDIndexedResults? {
+        didSet { _invalidateAnswerIndex() }
+    }
+    
+    /// Whether or not to cache the answer results returned by `findAnswerResult(with:)` and
+    /// `findAnswerResult(with:inSection:)`. The cache is discarded whenever the step history or async results
+    /// are changed. Default = `false`.
+    ///
+    /// - note: Only enable the answer index if the results held by this task result are value types or are
+    /// not mutated in place after they are added. Changes to a result *object* that is already included in
+    /// the step history will not invalidate the cached answers.
+    public var usesAnswerIndex: Bool = false {
+        didSet { _invalidateAnswerIndex() }
+    }
+    private var _answerIndex: RSDAnswerResultIndex?
     
     /// Default initializer for this object.
     ///
@@ -134,6 +158,133 @@ public struct RSDTaskResultObject : RSDTaskRunResult, Codable {
     }
 }
 
+extension RSDTaskResultObject {
+    
+    /// Find a result within the step history.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    public func findResult(with identifier: String) -> RSDResult? {
+        return _stepHistory.result(with: identifier)
+    }
+    
+    /// Find an *answer* result within this task result. If `usesAnswerIndex` is `true` then the result of the
+    /// search is cached.
+    ///
+    /// - seealso: `RSDAnswerResultFinder`
+    ///
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The result or `nil` if not found.
+    public func findAnswerResult(with identifier: String) -> RSDAnswerResult? {
+        guard let answerIndex = _answerIndex else {
+            return _findAnswerResult(with: identifier)
+        }
+        return answerIndex.answerResult(for: identifier) { _findAnswerResult(with: identifier) }
+    }
+    
+    /// Find an *answer* result within the step result with the given section identifier. If `usesAnswerIndex`
+    /// is `true` then the result of the search is cached.
+    ///
+    /// - parameters:
+    ///     - identifier: The identifier associated with the answer result.
+    ///     - sectionIdentifier: The identifier of the step result that includes the answer.
+    /// - returns: The result or `nil` if not found.
+    public func findAnswerResult(with identifier: String, inSection sectionIdentifier: String) -> RSDAnswerResult? {
+        let find: () -> RSDAnswerResult? = {
+            let section = self._stepHistory.result(with: sectionIdentifier) ?? self._asyncResults?.result(with: sectionIdentifier)
+            return (section as? RSDAnswerResultFinder)?.findAnswerResult(with: identifier)
+        }
+        guard let answerIndex = _answerIndex else { return find() }
+        return answerIndex.answerResult(for: identifier, inSection: sectionIdentifier, find)
+    }
+    
+    private func _findAnswerResult(with identifier: String) -> RSDAnswerResult? {
+        for result in _stepHistory.results {
+            if let answerResult = (result as? RSDAnswerResultFinder)?.findAnswerResult(with: identifier) {
+                return answerResult
+            }
+        }
+        if let results = _asyncResults?.results {
+            for result in results {
+                if let answerResult = (result as? RSDAnswerResultFinder)?.findAnswerResult(with: identifier) {
+                    return answerResult
+                }
+            }
+        }
+        return nil
+    }
+    
+    /// Append the result to the end of the step history, replacing the previous instance with the same identifier.
+    /// - parameter result:  The result to add to the step history.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating public func appendStepHistory(with result: RSDResult) -> RSDResult? {
+        return _stepHistory.appendReplacing(result)
+    }
+    
+    /// The change token of the step result with the given identifier. The token changes each time the
+    /// result is added to or replaced in the step history.
+    /// - parameter identifier: The identifier associated with the result.
+    /// - returns: The change token or `nil` if not found.
+    internal func stepHistoryChangeToken(for identifier: String) -> UInt64? {
+        return _stepHistory.changeToken(for: identifier)
+    }
+    
+    /// Remove results from the step history from the result with the given identifier to the end of the array.
+    /// - parameter stepIdentifier:  The identifier of the result associated with the given step.
+    /// - returns: The previous result or `nil` if there wasn't one.
+    @discardableResult
+    mutating public func removeStepHistory(from stepIdentifier: String) -> Array<RSDResult>? {
+        return _stepHistory.removeAll(from: stepIdentifier)
+    }
+    
+    /// Append the async results with the given result, replacing the previous instance with the same identifier.
+    /// - parameter result:  The result to add to the async results.
+    mutating public func appendAsyncResult(with result: RSDResult) {
+        if _asyncResults == nil {
+            _asyncResults = RSDIndexedResults([result])
+        }
+        else {
+            _asyncResults!.appendReplacing(result)
+        }
+    }
+    
+    private mutating func _invalidateAnswerIndex() {
+        _answerIndex = usesAnswerIndex ? RSDAnswerResultIndex() : nil
+    }
+}
+
+/// A cache of the answer results found within a task result. The cache is a reference type that is replaced
+/// (rather than cleared) when the task result is mutated so that copies of the task result which share the
+/// same results also share the same cache.
+private final class RSDAnswerResultIndex {
+    
+    private let lock = NSLock()
+    private var answers: [String : RSDAnswerResult?] = [:]
+    private var sectionAnswers: [String : [String : RSDAnswerResult?]] = [:]
+    
+    func answerResult(for identifier: String, _ find: () -> RSDAnswerResult?) -> RSDAnswerResult? {
+        lock.lock()
+        defer { lock.unlock() }
+        if let cached = answers[identifier] {
+            return cached
+        }
+        let answer = find()
+        answers[identifier] = .some(answer)
+        return answer
+    }
+    
+    func answerResult(for identifier: String, inSection sectionIdentifier: String, _ find: () -> RSDAnswerResult?) -> RSDAnswerResult? {
+        lock.lock()
+        defer { lock.unlock() }
+        if let cached = sectionAnswers[sectionIdentifier]?[identifier] {
+            return cached
+        }
+        let answer = find()
+        sectionAnswers[sectionIdentifier, default: [:]][identifier] = .some(answer)
+        return answer
+    }
+}
+
 extension RSDTaskResultObject : RSDDocumentableCodableObject {
     
     static func codingKeys() -> [CodingKey] {
@@ -107,6 +107,15 @@ open class RSDTaskState : NSObject {
     /// A queue that can be used to serialize archiving and cleaning up the file output.
     public let fileManagementQueue = DispatchQueue(label: "org.sagebase.Research.fileQueue.\(UUID())")
     
+    /// The maximum number of child archives and archivable results to build at the same time when
+    /// archiving the results. The data is always inserted into each archive in the same order, and at most
+    /// this many results are built ahead of the result being inserted. Default = `1`, which builds the
+    /// archives serially.
+    ///
+    /// - note: If this is greater than `1`, then the `RSDDataArchiveManager`, the data archives, and the
+    ///         `RSDArchivable` results must be thread-safe.
+    public var maxConcurrentArchiveOperations: Int = 1
+    
     /// Convenience method for encoding a result. This is a work-around for a limitation of the encoder
     /// where it cannot encode an object without a Type for the object.
     /// - parameter encoder: The factory top-level encoder.
@@ -164,7 +173,17 @@ open class RSDTaskState : NSObject {
     public func archiveResults(with manager: RSDDataArchiveManager, completion: ((_ error: Error?) -> Void)? = nil) {
         fileManagementQueue.async {
             do {
-                let taskArchiver = TaskArchiver(manager: manager, taskResult: self.taskResult, scheduleIdentifier: self.scheduleIdentifier)
+                let taskArchiver: TaskArchiver
+                if let archiver = self._incrementalArchiver, archiver.manager === manager {
+                    archiver.taskResult = self.taskResult
+                    taskArchiver = archiver
+                }
+                else {
+                    self._incrementalArchiver?.discardAllStagedData()
+                    taskArchiver = TaskArchiver(manager: manager, taskResult: self.taskResult, scheduleIdentifier: self.scheduleIdentifier)
+                }
+                self._incrementalArchiver = nil
+                taskArchiver.maxConcurrentOperationCount = self.maxConcurrentArchiveOperations
                 let archives = try taskArchiver.buildArchives()
                 manager.encryptAndUpload(taskResult: self.taskResult, dataArchives: archives) {
                     self.cleanup(error: nil, completion: completion)
@@ -176,4 +195,71 @@ open class RSDTaskState : NSObject {
             }
         }
     }
+    
+    // MARK: Incremental archiving
+    
+    /// The archiver used to stage results as the task runs. This is only accessed on the
+    /// `fileManagementQueue`.
+    private var _incrementalArchiver: TaskArchiver?
+    
+    /// Start archiving the results incrementally as the steps are completed.
+    ///
+    /// When this method is called before the task runs and the data archive vended by the manager is an
+    /// `RSDIncrementalDataArchive`, then each step result is added to the archive on the
+    /// `fileManagementQueue` as the step is completed. The archive data for the step (including the data for
+    /// file results) is inserted into the archive, the answers are collected, and the results of subtasks
+    /// that are archived separately are staged in their own archives. Otherwise, nothing is staged and the
+    /// archives are built when the task finishes.
+    ///
+    /// When `archiveResults(with:)` is called with the same manager, the staged data is used for each step
+    /// result that has the same change token in the final task result, and the other step results are added
+    /// to the archive then. The answers map, task result, and metadata are always encoded when the task
+    /// finishes since they include all the results.
+    ///
+    /// - note: The data archive is requested from the manager when this method is called, so the
+    ///         `scheduleIdentifier` should be set before calling this method. The change token only changes
+    ///         when a step result is added to the step history, so a result that is a reference type must be
+    ///         replaced rather than mutated after the step is completed.
+    /// - parameter manager: The data archive manager to use to archive the results.
+    public func startIncrementalArchive(with manager: RSDDataArchiveManager) {
+        let taskResult = self.taskResult
+        let scheduleIdentifier = self.scheduleIdentifier
+        fileManagementQueue.async {
+            self._incrementalArchiver?.discardAllStagedData()
+            let archiver = TaskArchiver(manager: manager, taskResult: taskResult, scheduleIdentifier: scheduleIdentifier)
+            self._incrementalArchiver = archiver
+        }
+    }
+    
+    /// Stop archiving the results incrementally and discard the staged data. This is called when the task is
+    /// cancelled without saving the results.
+    public func discardIncrementalArchive() {
+        fileManagementQueue.async {
+            self._incrementalArchiver?.discardAllStagedData()
+            self._incrementalArchiver = nil
+        }
+    }
+    
+    /// Stage a step result that has been added to the task result.
+    internal func stageResultForArchive(_ result: RSDResult) {
+        let changeToken = (self.taskResult as? RSDTaskResultObject)?.stepHistoryChangeToken(for: result.identifier)
+        fileManagementQueue.async {
+            self._incrementalArchiver?.stageResult(result, changeToken: changeToken)
+        }
+    }
+    
+    /// Discard the staged data for step results that were removed from the task result.
+    internal func discardStagedResults(_ results: [RSDResult]) {
+        let identifiers = results.map { $0.identifier }
+        fileManagementQueue.async {
+            self._incrementalArchiver?.discardStagedResults(with: identifiers)
+        }
+    }
+    
+    /// Discard the staged data for all the step results when the task result is reset.
+    internal func discardAllStagedResults() {
+        fileManagementQueue.async {
+            self._incrementalArchiver?.discardAllStagedData()
+        }
+    }
 }
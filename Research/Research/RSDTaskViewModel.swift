@@ -307,6 +307,9 @@ open class RSDTaskViewModel : RSDTaskState, RSDTaskPathComponent {
                 let result = previousStep.pathResult()
                 self.taskResult.appendStepHistory(with: result)
             }
+            if self.parent == nil, let result = self.taskResult.stepHistory.last {
+                self.stageResultForArchive(result)
+            }
         }
         
         // move to the next step
@@ -330,6 +333,9 @@ open class RSDTaskViewModel : RSDTaskState, RSDTaskPathComponent {
     /// Call through to the task controller to handle the task finished with a reason of `.cancelled`.
     open func cancel(shouldSave: Bool = false) {
         let reason: RSDTaskFinishReason = shouldSave ? .saved : .discarded
+        if !shouldSave {
+            self.discardIncrementalArchive()
+        }
         self.taskController?.handleTaskDidFinish(with: reason, error: nil)
     }
     
@@ -491,6 +497,7 @@ open class RSDTaskViewModel : RSDTaskState, RSDTaskPathComponent {
                 var runResult = newResult as? RSDTaskRunResult
                 runResult?.taskRunUUID = previousResult.taskRunUUID
                 strongSelf.taskResult = runResult ?? newResult
+                strongSelf.discardAllStagedResults()
             }
             else {
                 err = error ?? RSDValidationError.unexpectedNullObject("Fetched a nil task without an associated error")
@@ -577,6 +584,9 @@ open class RSDTaskViewModel : RSDTaskState, RSDTaskPathComponent {
     /// - parameter stepIdentifier:  The identifier of the result associated with the given step.
     func removeStepHistory(from stepIdentifier: String) {
         guard let results = taskResult.removeStepHistory(from: stepIdentifier) else { return }
+        if self.parent == nil {
+            self.discardStagedResults(results)
+        }
         if self.previousResults == nil {
             self.previousResults = results
         }
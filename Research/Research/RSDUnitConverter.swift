@@ -44,6 +44,21 @@ public struct RSDUnitConverter {
     /// The converter to use for length measurements.
     public static let feetAndInches = USCustomaryUnitConverter<UnitLength>(largeUnit: .feet, smallUnit: .inches, baseUnit: .centimeters)
     
+    /// Convert the values in place from one unit to another unit of the same dimension. This is more
+    /// efficient than converting an array of `Measurement` values since the conversion coefficient is
+    /// calculated once for the whole buffer.
+    ///
+    /// - parameters:
+    ///     - values: The values to convert.
+    ///     - fromUnit: The unit of the input values.
+    ///     - toUnit: The unit to convert the values to.
+    public static func convert<UnitType : Dimension>(_ values: inout [Double], from fromUnit: UnitType, to toUnit: UnitType) {
+        values.withUnsafeMutableBufferPointer { (buffer) in
+            guard let baseAddress = buffer.baseAddress else { return }
+            Dimension.convertValues(baseAddress, count: buffer.count, fromUnit: fromUnit, toUnit: toUnit)
+        }
+    }
+    
     /// `USCustomaryUnitConverter` is generic struct for converting measurements from various units.
     ///
     /// - note: US Customary and Imperial units measurements are typically shown using a "larger"
@@ -94,6 +109,15 @@ public struct RSDUnitConverter {
             }
         }
         
+        /// Convert the values in place to the `baseUnit`.
+        ///
+        /// - parameters:
+        ///     - values: The values to convert.
+        ///     - unit: The unit of the input values.
+        public func convertToBaseUnit(_ values: inout [Double], from unit: UnitType) {
+            RSDUnitConverter.convert(&values, from: unit, to: baseUnit)
+        }
+        
         /// Convert the input US Customary unit values to a `Measurement` of the same unit type. This
         /// will convert the `largeValue` to a `Measurement` with a unit of `largeUnit` and the `smallValue`
         /// to a `Measurement` with a unit of `smallUnit`. The measurements will be summed and the total will
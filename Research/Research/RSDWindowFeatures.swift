@@ -0,0 +1,102 @@
+//
+//  RSDWindowFeatures.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDWindowFeatures` holds the summary statistics for a window of three-axis samples.
+///
+/// - seealso: `RSDWindowedFeatureExtractor`
+public struct RSDWindowFeatures : Codable, Equatable {
+    
+    /// The summary statistics for a single axis.
+    public struct Axis : Codable, Equatable {
+        
+        /// The mean value.
+        public let mean: Double
+        
+        /// The population variance.
+        public let variance: Double
+        
+        /// The root-mean-square of the values (including the mean).
+        public let rms: Double
+        
+        /// The minimum value.
+        public let min: Double
+        
+        /// The maximum value.
+        public let max: Double
+        
+        /// The number of times the signal crosses its mean value.
+        public let zeroCrossings: Int
+        
+        /// The frequency (in hertz) with the most power after the mean is removed.
+        public let dominantFrequency: Double
+        
+        public init(mean: Double, variance: Double, rms: Double, min: Double, max: Double, zeroCrossings: Int, dominantFrequency: Double) {
+            self.mean = mean
+            self.variance = variance
+            self.rms = rms
+            self.min = min
+            self.max = max
+            self.zeroCrossings = zeroCrossings
+            self.dominantFrequency = dominantFrequency
+        }
+    }
+    
+    /// The system clock uptime of the first sample in the window.
+    public let startUptime: TimeInterval
+    
+    /// The system clock uptime of the last sample in the window.
+    public let endUptime: TimeInterval
+    
+    /// The number of samples in the window.
+    public let sampleCount: Int
+    
+    /// The features for the x-axis.
+    public let x: Axis
+    
+    /// The features for the y-axis.
+    public let y: Axis
+    
+    /// The features for the z-axis.
+    public let z: Axis
+    
+    public init(startUptime: TimeInterval, endUptime: TimeInterval, sampleCount: Int, x: Axis, y: Axis, z: Axis) {
+        self.startUptime = startUptime
+        self.endUptime = endUptime
+        self.sampleCount = sampleCount
+        self.x = x
+        self.y = y
+        self.z = z
+    }
+}
@@ -0,0 +1,225 @@
+//
+//  RSDWindowedFeatureExtractor.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDWindowedFeatureExtractor` calculates summary statistics over a window of three-axis samples as
+/// the samples are recorded. This allows a recorder to save per-window features without having to
+/// parse the full log file after the recording has finished.
+///
+/// The extractor keeps the most recent `windowLength` samples in a ring buffer. Each time `stride` new
+/// samples have been added to a full buffer, the features of the window are calculated and appended to
+/// `windows`. If `stride == windowLength`, then the windows do not overlap (tumbling windows).
+/// Otherwise, the windows slide by `stride` samples.
+///
+/// The ring buffer and the buffers used to calculate the power spectrum are allocated when the extractor
+/// is initialized. The only allocation while adding samples is when `windows` grows: it gains one element
+/// for each window, so a recording of one hour with one-second windows keeps 3,600 windows in memory.
+///
+/// An instance of this class is **not** thread-safe. It is intended to be owned by a single recorder
+/// and updated from a serial queue.
+///
+/// - seealso: `RSDWindowFeatures`, `RSDWindowedFeaturesResultObject`
+public final class RSDWindowedFeatureExtractor {
+    
+    /// The duration of the windows used to calculate the features.
+    public struct Window : Codable, Equatable {
+        
+        /// The duration (in seconds) of each window.
+        public let duration: TimeInterval
+        
+        /// The time (in seconds) between the start of each window. If `nil`, then this is the same as
+        /// the `duration` and the windows do not overlap.
+        public let stride: TimeInterval?
+        
+        public init(duration: TimeInterval, stride: TimeInterval? = nil) {
+            self.duration = duration
+            self.stride = stride
+        }
+    }
+    
+    /// An identifier for the samples, such as the sensor type.
+    public let identifier: String
+    
+    /// The number of samples in each window.
+    public let windowLength: Int
+    
+    /// The number of samples between the start of each window.
+    public let stride: Int
+    
+    /// The sampling rate (in hertz) used to calculate the dominant frequency.
+    public let samplingRate: Double
+    
+    /// The features for each of the windows that have been completed. This grows by one element each
+    /// time `stride` samples are added to a full window.
+    public private(set) var windows: [RSDWindowFeatures] = []
+    
+    /// The number of samples that have been added to the extractor.
+    public private(set) var sampleCount: Int = 0
+    
+    /// The ring buffer of samples.
+    private var samples: [SIMD3<Double>]
+    
+    /// The uptime of each sample in the ring buffer.
+    private var uptimes: [TimeInterval]
+    
+    /// The index in the ring buffer where the next sample will be written. Once the buffer is full, this
+    /// is also the index of the oldest sample.
+    private var head: Int = 0
+    
+    /// The number of samples added since the last window was calculated.
+    private var samplesSinceLastWindow: Int = 0
+    
+    /// The power spectrum used to find the dominant frequency.
+    private let spectrum: RSDPowerSpectrum
+    
+    /// Initialize the extractor with the length of the window in samples.
+    /// - parameters:
+    ///     - identifier: An identifier for the samples, such as the sensor type.
+    ///     - windowLength: The number of samples in each window. Must be greater than `1`.
+    ///     - stride: The number of samples between the start of each window. Default = `windowLength`.
+    ///     - samplingRate: The sampling rate (in hertz) of the samples.
+    public init(identifier: String, windowLength: Int, stride: Int? = nil, samplingRate: Double) {
+        precondition(windowLength > 1, "The window must include more than one sample.")
+        self.identifier = identifier
+        self.windowLength = windowLength
+        self.stride = max(stride ?? windowLength, 1)
+        self.samplingRate = samplingRate
+        self.samples = Array(repeating: SIMD3<Double>(repeating: 0), count: windowLength)
+        self.uptimes = Array(repeating: 0, count: windowLength)
+        self.spectrum = RSDPowerSpectrum(length: windowLength)
+    }
+    
+    /// Initialize the extractor with the duration of the window.
+    /// - parameters:
+    ///     - identifier: An identifier for the samples, such as the sensor type.
+    ///     - window: The duration of the window and the stride between windows.
+    ///     - samplingRate: The sampling rate (in hertz) of the samples.
+    public convenience init(identifier: String, window: Window, samplingRate: Double) {
+        let windowLength = max(Int((window.duration * samplingRate).rounded()), 2)
+        let stride = window.stride.map { Int(($0 * samplingRate).rounded()) }
+        self.init(identifier: identifier, windowLength: windowLength, stride: stride, samplingRate: samplingRate)
+    }
+    
+    /// Add a sample to the window.
+    /// - parameters:
+    ///     - uptime: The system clock uptime of the sample.
+    ///     - x: The x-axis value.
+    ///     - y: The y-axis value.
+    ///     - z: The z-axis value.
+    public func append(uptime: TimeInterval, x: Double, y: Double, z: Double) {
+        samples[head] = SIMD3<Double>(x, y, z)
+        uptimes[head] = uptime
+        head = (head + 1 == windowLength) ? 0 : head + 1
+        sampleCount += 1
+        samplesSinceLastWindow += 1
+        if sampleCount >= windowLength && samplesSinceLastWindow >= stride {
+            samplesSinceLastWindow = 0
+            windows.append(calculateFeatures())
+        }
+    }
+    
+    /// Calculate the features of the samples that are currently in the ring buffer. The buffer must be
+    /// full. The mean is removed from the samples before counting the zero-crossings and calculating
+    /// the dominant frequency.
+    private func calculateFeatures() -> RSDWindowFeatures {
+        let count = Double(windowLength)
+        
+        // The first pass calculates the mean, RMS, minimum, and maximum.
+        var sum = SIMD3<Double>(repeating: 0)
+        var sumOfSquares = SIMD3<Double>(repeating: 0)
+        var minimum = samples[0]
+        var maximum = samples[0]
+        for value in samples {
+            sum += value
+            sumOfSquares += value * value
+            for axis in 0..<3 {
+                minimum[axis] = Swift.min(minimum[axis], value[axis])
+                maximum[axis] = Swift.max(maximum[axis], value[axis])
+            }
+        }
+        let mean = sum / count
+        
+        // The second pass uses the samples in time order to calculate the variance and zero-crossings.
+        var sumOfDeviations = SIMD3<Double>(repeating: 0)
+        var zeroCrossings = SIMD3<Int>(repeating: 0)
+        var previous = SIMD3<Double>(repeating: 0)
+        for i in 0..<windowLength {
+            let deviation = sample(at: i) - mean
+            sumOfDeviations += deviation * deviation
+            for axis in 0..<3 where deviation[axis] != 0 {
+                if (previous[axis] < 0 && deviation[axis] > 0) || (previous[axis] > 0 && deviation[axis] < 0) {
+                    zeroCrossings[axis] += 1
+                }
+                previous[axis] = deviation[axis]
+            }
+        }
+        let variance = sumOfDeviations / count
+        
+        // Use the power spectrum to find the frequency bin with the most power. The DC bin is skipped
+        // because the mean has been removed.
+        var dominantBin = SIMD3<Int>(repeating: 0)
+        for axis in 0..<3 {
+            spectrum.calculate { sample(at: $0)[axis] - mean[axis] }
+            var maxPower: Double = 0
+            for k in 1..<spectrum.power.count where spectrum.power[k] > maxPower {
+                maxPower = spectrum.power[k]
+                dominantBin[axis] = k
+            }
+        }
+        
+        func axisFeatures(_ axis: Int) -> RSDWindowFeatures.Axis {
+            return RSDWindowFeatures.Axis(mean: mean[axis],
+                                          variance: variance[axis],
+                                          rms: (sumOfSquares[axis] / count).squareRoot(),
+                                          min: minimum[axis],
+                                          max: maximum[axis],
+                                          zeroCrossings: zeroCrossings[axis],
+                                          dominantFrequency: Double(dominantBin[axis]) * samplingRate / count)
+        }
+        
+        return RSDWindowFeatures(startUptime: uptimes[head],
+                                 endUptime: uptimes[(head + windowLength - 1) % windowLength],
+                                 sampleCount: windowLength,
+                                 x: axisFeatures(0),
+                                 y: axisFeatures(1),
+                                 z: axisFeatures(2))
+    }
+    
+    /// The sample at the given position in the window where `0` is the oldest sample.
+    @inline(__always)
+    private func sample(at position: Int) -> SIMD3<Double> {
+        let index = head + position
+        return samples[index < windowLength ? index : index - windowLength]
+    }
+}
@@ -0,0 +1,116 @@
+//
+//  RSDWindowedFeaturesResultObject.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import Foundation
+
+/// `RSDWindowedFeaturesResultObject` is a result that holds the features calculated by a
+/// `RSDWindowedFeatureExtractor` while a recorder was running.
+public struct RSDWindowedFeaturesResultObject : RSDResult, RSDArchivable, Codable {
+    
+    /// The identifier associated with the task, step, or asynchronous action.
+    public let identifier: String
+    
+    /// A String that indicates the type of the result. This is used to decode the result using a `RSDFactory`.
+    public let type: RSDResultType
+    
+    /// The start date timestamp for the result.
+    public var startDate: Date = Date()
+    
+    /// The end date timestamp for the result.
+    public var endDate: Date = Date()
+    
+    /// The sampling rate (in hertz) used to calculate the features.
+    public var samplingRate: Double
+    
+    /// The number of samples in each window.
+    public var windowLength: Int
+    
+    /// The number of samples between the start of each window.
+    public var stride: Int
+    
+    /// The features for each window.
+    public var windows: [RSDWindowFeatures]
+    
+    private enum CodingKeys : String, CodingKey, CaseIterable {
+        case identifier, type, startDate, endDate, samplingRate, windowLength, stride, windows
+    }
+    
+    /// Default initializer for this object.
+    ///
+    /// - parameters:
+    ///     - identifier: The identifier string.
+    ///     - samplingRate: The sampling rate (in hertz) used to calculate the features.
+    ///     - windowLength: The number of samples in each window.
+    ///     - stride: The number of samples between the start of each window.
+    ///     - windows: The features for each window.
+    ///     - type: The `RSDResultType` for this result. Default = `.windowedFeatures`.
+    public init(identifier: String, samplingRate: Double, windowLength: Int, stride: Int, windows: [RSDWindowFeatures], type: RSDResultType = .windowedFeatures) {
+        self.identifier = identifier
+        self.type = type
+        self.samplingRate = samplingRate
+        self.windowLength = windowLength
+        self.stride = stride
+        self.windows = windows
+    }
+    
+    /// Initialize the result with the windows calculated by the given extractor.
+    /// - parameters:
+    ///     - identifier: The identifier string.
+    ///     - extractor: The feature extractor.
+    public init(identifier: String, extractor: RSDWindowedFeatureExtractor) {
+        self.init(identifier: identifier, samplingRate: extractor.samplingRate, windowLength: extractor.windowLength, stride: extractor.stride, windows: extractor.windows)
+    }
+    
+    /// Build the archiveable or uploadable data for this result. The result is encoded as a JSON file.
+    public func buildArchiveData(at stepPath: String?) throws -> (manifest: RSDFileManifest, data: Data)? {
+        let manifest = RSDFileManifest(filename: "\(identifier).json", timestamp: startDate, contentType: "application/json", identifier: identifier, stepPath: stepPath)
+        let data = try self.rsd_jsonEncodedData()
+        return (manifest, data)
+    }
+}
+
+extension RSDWindowedFeaturesResultObject : RSDDocumentableCodableObject {
+    
+    static func codingKeys() -> [CodingKey] {
+        return CodingKeys.allCases
+    }
+    
+    static func examples() -> [Encodable] {
+        let axis = RSDWindowFeatures.Axis(mean: 0.01, variance: 0.04, rms: 0.2, min: -0.45, max: 0.5, zeroCrossings: 4, dominantFrequency: 2)
+        let window = RSDWindowFeatures(startUptime: 1234.567, endUptime: 1235.557, sampleCount: 100, x: axis, y: axis, z: axis)
+        var result = RSDWindowedFeaturesResultObject(identifier: "accelerometerFeatures", samplingRate: 100, windowLength: 100, stride: 100, windows: [window])
+        result.startDate = rsd_ISO8601TimestampFormatter.date(from: "2017-10-16T22:28:09.000-07:00")!
+        result.endDate = result.startDate.addingTimeInterval(5 * 60)
+        return [result]
+    }
+}
@@ -0,0 +1,94 @@
+//
+//  RSDZlibStream.h
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The direction of a `RSDZlibStream`.
+ */
+typedef NS_ENUM(NSInteger, RSDZlibStreamDirection) {
+    /// Compress data into the gzip file format.
+    RSDZlibStreamDirectionGzipEncode,
+    /// Decompress data that is in the gzip file format.
+    RSDZlibStreamDirectionGzipDecode,
+};
+
+/**
+ The error domain for errors returned by a `RSDZlibStream`. The error code is the libz status code.
+ */
+FOUNDATION_EXPORT NSErrorDomain const RSDZlibStreamErrorDomain;
+
+/**
+ `RSDZlibStream` is a thin wrapper around a libz stream that writes or reads the gzip file format (RFC 1952). The gzip header, the CRC-32 of the uncompressed data, and the trailer are written and checked by libz.
+
+ @warning An instance of this class is **not** thread-safe.
+ */
+@interface RSDZlibStream : NSObject
+
+/**
+ Create a stream.
+
+ @param direction   Whether the stream compresses or decompresses the data.
+ @param error       The error if the libz stream could not be initialized.
+ @return            A new stream or `nil` if the libz stream could not be initialized.
+ */
+- (nullable instancetype)initWithDirection:(RSDZlibStreamDirection)direction error:(NSError * __autoreleasing *)error NS_DESIGNATED_INITIALIZER;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ Whether the stream compresses or decompresses the data.
+ */
+@property (nonatomic, readonly) RSDZlibStreamDirection direction;
+
+/**
+ Has the end of the gzip stream been written or read?
+ */
+@property (nonatomic, readonly, getter=isFinished) BOOL finished;
+
+/**
+ Process a chunk of data and append the output to the given buffer.
+
+ @param data    The input data.
+ @param finish  Is this the last chunk of input? If compressing, then the remaining compressed data and the gzip trailer are appended to the output. If decompressing, then the data must include the end of the gzip stream.
+ @param output  The buffer to append the output to.
+ @param error   The error if the libz stream failed.
+ @return        `YES` if the data was processed.
+ */
+- (BOOL)processData:(NSData *)data finish:(BOOL)finish output:(NSMutableData *)output error:(NSError * __autoreleasing *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,127 @@
+//
+//  RSDZlibStream.m
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#import "RSDZlibStream.h"
+#import <zlib.h>
+
+NSErrorDomain const RSDZlibStreamErrorDomain = @"RSDZlibStreamErrorDomain";
+
+// Adding 16 to the window bits tells libz to write or read a gzip header and trailer rather than a zlib
+// wrapper.
+static const int RSDZlibGzipWindowBits = MAX_WBITS + 16;
+
+// The number of bytes to add to the output buffer for each call to libz.
+static const NSUInteger RSDZlibOutputChunkSize = 64 * 1024;
+
+@implementation RSDZlibStream {
+    z_stream _stream;
+}
+
+- (nullable instancetype)initWithDirection:(RSDZlibStreamDirection)direction error:(NSError * __autoreleasing *)error {
+    self = [super init];
+    if (self) {
+        _direction = direction;
+        memset(&_stream, 0, sizeof(_stream));
+        int status = (direction == RSDZlibStreamDirectionGzipEncode)
+            ? deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, RSDZlibGzipWindowBits, 8, Z_DEFAULT_STRATEGY)
+            : inflateInit2(&_stream, RSDZlibGzipWindowBits);
+        if (status != Z_OK) {
+            if (error) {
+                *error = [self errorWithStatus:status];
+            }
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_direction == RSDZlibStreamDirectionGzipEncode) {
+        deflateEnd(&_stream);
+    } else {
+        inflateEnd(&_stream);
+    }
+}
+
+- (BOOL)processData:(NSData *)data finish:(BOOL)finish output:(NSMutableData *)output error:(NSError * __autoreleasing *)error {
+    if (_finished || data.length > UINT_MAX) {
+        if (error) {
+            *error = [self errorWithStatus:Z_STREAM_ERROR];
+        }
+        return NO;
+    }
+    
+    _stream.next_in = (Bytef *)data.bytes;
+    _stream.avail_in = (uInt)data.length;
+    int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+    
+    while (YES) {
+        // Write directly into the end of the output buffer.
+        NSUInteger offset = output.length;
+        output.length = offset + RSDZlibOutputChunkSize;
+        _stream.next_out = (Bytef *)output.mutableBytes + offset;
+        _stream.avail_out = (uInt)RSDZlibOutputChunkSize;
+        
+        int status = (_direction == RSDZlibStreamDirectionGzipEncode) ? deflate(&_stream, flush) : inflate(&_stream, flush);
+        output.length = offset + RSDZlibOutputChunkSize - _stream.avail_out;
+        
+        if (status == Z_STREAM_END) {
+            _finished = YES;
+            break;
+        }
+        // `Z_BUF_ERROR` means that no progress was possible. This is not an error unless the stream should
+        // have been finished.
+        BOOL isTruncated = (status == Z_BUF_ERROR) && finish;
+        if ((status != Z_OK && status != Z_BUF_ERROR) || isTruncated) {
+            if (error) {
+                *error = [self errorWithStatus:status];
+            }
+            return NO;
+        }
+        // If there is space left in the output buffer, then all the input was consumed.
+        if (_stream.avail_out > 0 && !finish) {
+            break;
+        }
+    }
+    
+    _stream.next_in = NULL;
+    _stream.avail_in = 0;
+    return YES;
+}
+
+- (NSError *)errorWithStatus:(int)status {
+    NSString *message = (_stream.msg != NULL) ? @(_stream.msg) : [NSString stringWithFormat:@"libz failed with status %d", status];
+    return [NSError errorWithDomain:RSDZlibStreamErrorDomain code:status userInfo:@{ NSLocalizedDescriptionKey : message }];
+}
+
+@end
@@ -45,5 +45,8 @@ FOUNDATION_EXPORT const unsigned char ResearchVersionString[];
 #import <Research/RSDFractionFormatter.h>
 #import <Research/RSDLengthFormatter.h>
 #import <Research/RSDMassFormatter.h>
+#import <Research/RSDMeasurementWrapper.h>
+#import <Research/RSDRingBufferIndex.h>
+#import <Research/RSDZlibStream.h>
 
 
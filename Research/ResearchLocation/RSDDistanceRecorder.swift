@@ -348,6 +348,11 @@ public class RSDDistanceRecorder : RSDSampleRecorder, CLLocationManagerDelegate
         }
     }
     
+    /// Returns the `contentEncoding` from the location configuration.
+    override public var contentEncoding: RSDContentEncoding? {
+        return self.locationConfiguration?.contentEncoding
+    }
+    
     // MARK: Data management
     
     private var _stepStartLocation : CLLocation?
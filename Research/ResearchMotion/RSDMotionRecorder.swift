@@ -114,6 +114,35 @@ public class RSDMotionRecorder : RSDSampleRecorder {
         return self.motionConfiguration?.frequency ?? 100
     }()
     
+    /// Should the motion samples be written to the log file? This will be set to the `shouldLogSamples`
+    /// from the `coreMotionConfiguration`. If that value is `nil`, then the default is `true`.
+    lazy public var shouldLogSamples: Bool = {
+        return self.motionConfiguration?.shouldLogSamples ?? true
+    }()
+    
+    /// The number of sensor samples for each sample that is written to the log file. This will be set
+    /// using the `outputFrequency` from the `coreMotionConfiguration`. If that value is `nil`, then the
+    /// default is `1` and every sample is written.
+    lazy public var decimationFactor: Int = {
+        guard let outputFrequency = self.motionConfiguration?.outputFrequency, outputFrequency > 0
+            else {
+                return 1
+        }
+        return max(Int((self.frequency / outputFrequency).rounded()), 1)
+    }()
+    
+    /// The decimation filters for each sensor type. These are created when the recorder is started if
+    /// the `decimationFactor` is greater than `1`.
+    private var decimationFilters: [RSDMotionRecorderType : RSDDecimationFilter<RSDMotionRecord>] = [:]
+    
+    /// The feature extractors used to calculate windowed summary features for each sensor type while the
+    /// samples are recorded. The features are added to the results when the recorder is stopped.
+    ///
+    /// If this is empty when the recorder is started and the `coreMotionConfiguration` defines a
+    /// `featureWindow`, then an extractor is created for each of the `recorderTypes` that records a
+    /// three-axis vector. Set this property before starting the recorder to use custom extractors.
+    public var featureExtractors: [RSDMotionRecorderType : RSDWindowedFeatureExtractor] = [:]
+    
     /// For best results, only use a single motion manager to handle all motion sensor data.
     public private(set) var motionManager: CMMotionManager?
     
@@ -168,6 +197,27 @@ public class RSDMotionRecorder : RSDSampleRecorder {
         let motionManager = CMMotionManager()
         self.motionManager = motionManager
         
+        // Set up the feature extractors.
+        if featureExtractors.isEmpty, let window = self.motionConfiguration?.featureWindow {
+            for motionType in recorderTypes where motionType != .attitude {
+                featureExtractors[motionType] = RSDWindowedFeatureExtractor(identifier: motionType.rawValue, window: window, samplingRate: self.frequency)
+            }
+        }
+        
+        // Set up the decimation filters. The attitude quaternion is not filtered.
+        if decimationFactor > 1 {
+            for motionType in recorderTypes {
+                let tapCount: Int? = (motionType == .attitude) ? 1 : nil
+                decimationFilters[motionType] = RSDDecimationFilter(factor: decimationFactor, tapCount: tapCount)
+            }
+        }
+        
+        // The sample buffers, the feature extractors, and the decimation filters only support a single
+        // producer so if any of these are used, then the motion updates must be serialized.
+        if self.ingestionPolicy != nil || !featureExtractors.isEmpty || !decimationFilters.isEmpty {
+            motionQueue.maxConcurrentOperationCount = 1
+        }
+        
         // start each sensor
         var deviceMotionStarted = false
         for motionType in recorderTypes {
@@ -234,7 +284,10 @@ public class RSDMotionRecorder : RSDSampleRecorder {
     
     func recordRawSample(_ data: RSDVectorData) {
         let sample = RSDMotionRecord(stepPath: currentStepPath, data: data, referenceClock: self.clock)
-        self.writeSample(sample)
+        addToFeatureExtractor(sample)
+        if shouldLogSamples, let output = decimate(sample) {
+            self.writeSample(output)
+        }
     }
     
     func startDeviceMotion(with motionManager: CMMotionManager, updateInterval: TimeInterval, completion: ((Error?) -> Void)?) {
@@ -257,15 +310,42 @@ public class RSDMotionRecorder : RSDSampleRecorder {
         let samples = recorderTypes.compactMap {
             RSDMotionRecord(stepPath: currentStepPath, data: data, referenceFrame: frame, sensorType: $0, referenceClock: self.clock)
         }
-        self.writeSamples(samples)
+        samples.forEach { addToFeatureExtractor($0) }
+        if shouldLogSamples {
+            let outputs = decimationFilters.isEmpty ? samples : samples.compactMap { decimate($0) }
+            if outputs.count > 0 {
+                self.writeSamples(outputs)
+            }
+        }
+    }
+    
+    /// Returns the sample to write to the log file after it has been filtered by the decimation filter
+    /// for its sensor type or `nil` if the sample is dropped. This method is called on the motion queue.
+    func decimate(_ sample: RSDMotionRecord) -> RSDMotionRecord? {
+        guard let sensorType = sample.sensorType, let filter = decimationFilters[sensorType],
+            let x = sample.x, let y = sample.y, let z = sample.z
+            else {
+                return sample
+        }
+        guard let output = filter.process(sample, x: x, y: y, z: z) else { return nil }
+        let record = output.element
+        return RSDMotionRecord(uptime: record.uptime, timestamp: record.timestamp, stepPath: record.stepPath, timestampDate: record.timestampDate, sensorType: record.sensorType, eventAccuracy: record.eventAccuracy, referenceCoordinate: record.referenceCoordinate, heading: record.heading, x: output.vector.x, y: output.vector.y, z: output.vector.z, w: record.w)
+    }
+    
+    /// Add the sample to the feature extractor for its sensor type (if any). This method is called on
+    /// the motion queue.
+    func addToFeatureExtractor(_ sample: RSDMotionRecord) {
+        guard let sensorType = sample.sensorType, let extractor = featureExtractors[sensorType],
+            let uptime = sample.uptime, let x = sample.x, let y = sample.y, let z = sample.z
+            else {
+                return
+        }
+        extractor.append(uptime: uptime, x: x, y: y, z: z)
     }
     
     /// Override to stop updating the motion sensors.
     override public func stopRecorder(_ completion: @escaping ((RSDAsyncActionStatus) -> Void)) {
         
-        // Call completion immediately with a "stopping" status.
-        completion(.stopping)
-        
         DispatchQueue.main.async {
             
             self.stopInterruptionObserver()
@@ -290,8 +370,31 @@ public class RSDMotionRecorder : RSDSampleRecorder {
             }
             self.motionManager = nil
             
-            // and then call finished.
-            self.updateStatus(to: .finished, error: nil)
+            // If there are feature extractors, then wait for any pending sensor updates to be processed
+            // and add the features to the results. The completion is called after the results are added
+            // since the results are locked once the recorder is stopping.
+            guard !self.featureExtractors.isEmpty else {
+                completion(.finished)
+                return
+            }
+            self.motionQueue.addOperation {
+                let results = self.featureResults()
+                DispatchQueue.main.async {
+                    results.forEach { self.appendResults($0) }
+                    completion(.finished)
+                }
+            }
+        }
+    }
+    
+    /// Returns a result with the windowed features calculated by each of the feature extractors.
+    func featureResults() -> [RSDWindowedFeaturesResultObject] {
+        let endDate = Date()
+        return featureExtractors.sorted(by: { $0.key.rawValue < $1.key.rawValue }).map {
+            var result = RSDWindowedFeaturesResultObject(identifier: "\($0.key.rawValue)Features", extractor: $0.value)
+            result.startDate = self.startDate
+            result.endDate = endDate
+            return result
         }
     }
     
@@ -305,6 +408,38 @@ public class RSDMotionRecorder : RSDSampleRecorder {
         }
     }
     
+    /// Returns the binary columnar format to use for this file if the motion configuration sets
+    /// `usesBinaryEncoding` to `true`. Otherwise, returns `nil`.
+    override public func columnarEncodingFormat() -> RSDColumnarSampleFormat? {
+        if self.motionConfiguration?.usesBinaryEncoding == true {
+            return RSDMotionRecord.columnarFormat
+        } else {
+            return nil
+        }
+    }
+    
+    /// Returns the `jsonOutputFormat` from the motion configuration or `.prettyPrinted` if not defined.
+    override public var jsonOutputFormat: RSDJSONOutputFormat {
+        return self.motionConfiguration?.jsonOutputFormat ?? .prettyPrinted
+    }
+    
+    /// Returns the `contentEncoding` from the motion configuration.
+    override public var contentEncoding: RSDContentEncoding? {
+        return self.motionConfiguration?.contentEncoding
+    }
+    
+    /// Returns a rotation policy using the `segmentDuration` from the motion configuration.
+    override public var rotationPolicy: RSDDataLogger.RotationPolicy? {
+        guard let duration = self.motionConfiguration?.segmentDuration else { return nil }
+        return RSDDataLogger.RotationPolicy(maxSegmentDuration: duration)
+    }
+    
+    /// Returns `.buffered` so that the motion samples are written to the file in batches rather than
+    /// one sample at a time.
+    override public var flushPolicy: RSDDataLogger.FlushPolicy {
+        return .buffered
+    }
+    
     // MARK: Phone interruption
     
     private var _audioInterruptObserver: Any?
@@ -407,6 +542,23 @@ public struct RSDMotionRecord : RSDSampleRecord, RSDDelimiterSeparatedEncodable
         case uptime, timestamp, stepPath, timestampDate, sensorType, eventAccuracy, referenceCoordinate, heading, x, y, z, w
     }
     
+    /// The binary columnar format used to encode motion records. The columns are in the same order as
+    /// the coding keys so that a file exported from the binary format matches a CSV file.
+    public static let columnarFormat = RSDColumnarSampleFormat(columns: [
+        .init(CodingKeys.uptime.stringValue, .double),
+        .init(CodingKeys.timestamp.stringValue, .double),
+        .init(CodingKeys.stepPath.stringValue, .string),
+        .init(CodingKeys.timestampDate.stringValue, .string),
+        .init(CodingKeys.sensorType.stringValue, .string),
+        .init(CodingKeys.eventAccuracy.stringValue, .integer),
+        .init(CodingKeys.referenceCoordinate.stringValue, .string),
+        .init(CodingKeys.heading.stringValue, .double),
+        .init(CodingKeys.x.stringValue, .double),
+        .init(CodingKeys.y.stringValue, .double),
+        .init(CodingKeys.z.stringValue, .double),
+        .init(CodingKeys.w.stringValue, .double)
+        ])
+    
     fileprivate init(uptime: TimeInterval?, timestamp: TimeInterval?, stepPath: String, timestampDate: Date?, sensorType: RSDMotionRecorderType?, eventAccuracy: Int?, referenceCoordinate: RSDAttitudeReferenceFrame?, heading: Double?, x: Double?, y: Double?, z: Double?, w: Double?) {
         self.uptime = uptime
         self.timestamp = timestamp
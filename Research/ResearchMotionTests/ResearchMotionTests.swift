@@ -8,6 +8,7 @@
 
 import XCTest
 @testable import ResearchMotion
+@testable import Research
 
 class ResearchMotionTests: XCTestCase {
 
@@ -30,5 +31,80 @@ class ResearchMotionTests: XCTestCase {
             // Put the code you want to measure the time of here.
         }
     }
+    
+    func testMotionRecord_DelimiterEncoding() {
+        let records = RSDMotionRecord.examples().compactMap { $0 as? RSDMotionRecord }
+        XCTAssertEqual(records.count, 8)
+        let keys = RSDMotionRecord.codingKeys()
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: keys, delimiter: ",")
+        for record in records {
+            do {
+                let string = try encoder.encodeString(record)
+                let dictionary = try record.rsd_jsonEncodedDictionary()
+                let expected = keys.map { dictionary[$0.stringValue].map { "\($0)" } ?? "" }.joined(separator: ",")
+                XCTAssertEqual(string, expected)
+            } catch let err {
+                XCTFail("Failed to encode \(record): \(err)")
+            }
+        }
+    }
+    
+    func testMotionRecord_DelimiterEncoding_Performance() {
+        let examples = RSDMotionRecord.examples().compactMap { $0 as? RSDMotionRecord }
+        let records = (0..<1250).flatMap { _ in examples }
+        let format = CSVEncodingFormat<RSDMotionRecord>()
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: format.codingKeys(), delimiter: format.encodingSeparator)
+        var data = Data()
+        self.measure {
+            data.removeAll(keepingCapacity: true)
+            for record in records {
+                try! encoder.encode(record, appendingTo: &data)
+                data.append(0x0A)
+            }
+        }
+        
+        // The output should match the legacy JSON round-trip encoding.
+        let keys = format.codingKeys()
+        let expected = examples.map { (record) -> String in
+            let dictionary = try! record.rsd_jsonEncodedDictionary()
+            let row = keys.map { dictionary[$0.stringValue].map { "\($0)" } ?? "" }.joined(separator: format.encodingSeparator)
+            return "\(row)\n"
+            }.joined()
+        XCTAssertEqual(String(data: data, encoding: .utf8), String(repeating: expected, count: 1250))
+    }
+    
+    func testMotionRecorder_StopAddsFeatureResults() {
+        let window = RSDWindowedFeatureExtractor.Window(duration: 1)
+        var config = RSDMotionRecorderConfiguration(identifier: "motion", recorderTypes: [.accelerometer], frequency: 100)
+        config.featureWindow = window
+        let navigator = RSDConditionalStepNavigatorObject(with: [])
+        let taskViewModel = RSDTaskViewModel(task: RSDTaskObject(identifier: "task", stepNavigator: navigator))
+        let outputDirectory = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString, isDirectory: true)
+        let recorder = RSDMotionRecorder(configuration: config, taskViewModel: taskViewModel, outputDirectory: outputDirectory)
+        
+        // Add the samples to the extractor directly since the sensors are not available to the tests.
+        let extractor = RSDWindowedFeatureExtractor(identifier: RSDMotionRecorderType.accelerometer.rawValue, window: window, samplingRate: 100)
+        recorder.featureExtractors[.accelerometer] = extractor
+        for ii in 0..<200 {
+            extractor.append(uptime: Double(ii) / 100, x: sin(Double(ii)), y: 0.5, z: -1)
+        }
+        
+        let expect = expectation(description: "Stop \(config.identifier)")
+        var featureResults: [RSDWindowedFeaturesResultObject] = []
+        recorder.stop { (_, _, error) in
+            XCTAssertNil(error)
+            featureResults = recorder.collectionResult.inputResults.compactMap { $0 as? RSDWindowedFeaturesResultObject }
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+        
+        // The features should be added to the results before the recorder is finished.
+        XCTAssertEqual(recorder.status, .finished)
+        XCTAssertEqual(featureResults.map { $0.identifier }, ["accelerometerFeatures"])
+        XCTAssertGreaterThan(featureResults.first?.windows.count ?? 0, 0)
+        try? FileManager.default.removeItem(at: outputDirectory)
+    }
 
 }
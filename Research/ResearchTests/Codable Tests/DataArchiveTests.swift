@@ -73,7 +73,7 @@ class DataArchiveTests: XCTestCase {
             sectionResult.appendStepHistory(with: buildSingleAnswerResult(identifier: "single", answer: 3))
             sectionResult.appendStepHistory(with: RSDAnswerResultObject(identifier: "only", answerType: .integer, value: 9))
             taskViewModel.taskResult.appendStepHistory(with: sectionResult)
-
+            
             let manager = TestArchiveManager()
             let archive = TestDataArchive("foo")
             manager.dataArchiverFor[taskViewModel.taskResult.identifier] = archive
@@ -101,7 +101,7 @@ class DataArchiveTests: XCTestCase {
                 case "asyncFile.txt":
                     XCTAssertEqual(manifest.contentType, "text/plain")
                     XCTAssertEqual(manifest.identifier, "asyncFile")
-                    
+                
                 case "answers.json":
                     XCTAssertEqual(manifest.contentType, "application/json")
                     if let string = String(data: data, encoding: .utf8) {
@@ -116,7 +116,7 @@ class DataArchiveTests: XCTestCase {
                     XCTAssertEqual(dictionary["sectionA_single"], 3)
                     XCTAssertEqual(dictionary["only"], 7)
                     XCTAssertEqual(dictionary["sectionA_only"], 9)
-
+                
                 case "taskResult.json":
                     XCTAssertEqual(manifest.contentType, "application/json")
                 
@@ -186,7 +186,7 @@ class DataArchiveTests: XCTestCase {
                     case "asyncFile.txt":
                         XCTAssertEqual(manifest.contentType, "text/plain")
                         XCTAssertEqual(manifest.identifier, "asyncFile")
-                        
+                    
                     case "answers.json":
                         XCTAssertEqual(manifest.contentType, "application/json")
                         if let string = String(data: data, encoding: .utf8) {
@@ -196,27 +196,303 @@ class DataArchiveTests: XCTestCase {
                         let dictionary = try decoder.decode([String : Int].self, from: data)
                         XCTAssertEqual(dictionary.count, 3)
                         XCTAssertEqual(dictionary["collection_input1"], 1)
-                        
+                    
                     case "taskResult.json":
                         XCTAssertEqual(manifest.contentType, "application/json")
-                        
+                    
                     default:
                         XCTFail("Manifest filename unexpected: \(manifest.filename)")
                     }
                 }
             }
+        
+        
+        
+        
+        } catch let err {
+            XCTFail("Failed unexpectedly: \(err)")
+            return
+        }
+    }
+    
+    func testDataArchiver_Incremental() {
+        let counter = TestArchivableResult.Counter()
+        var baseResult = RSDTaskResultObject(identifier: "foo")
+        baseResult.appendStepHistory(with: RSDResultObject(identifier: "step1"))
+        baseResult.appendStepHistory(with: TestArchivableResult(identifier: "scoreA", score: 2, counter: counter))
+        var collection = buildCollectionResult(identifier: "collection")
+        collection.appendInputResults(with: TestArchivableResult(identifier: "scoreB", score: 3, counter: counter))
+        baseResult.appendStepHistory(with: collection)
+        baseResult.appendStepHistory(with: RSDAnswerResultObject(identifier: "only", answerType: .integer, value: 7))
+        
+        // Build the archive for the full task result.
+        let fullViewModel = buildTaskViewModel(identifier: "foo")
+        fullViewModel.taskResult = baseResult
+        let fullArchive = archiveResults(for: fullViewModel, incremental: false) { _ in }
+        XCTAssertEqual(counter.buildCount, 2)
+        
+        // Build the archive by staging each step as it is completed.
+        counter.buildCount = 0
+        let viewModel = buildTaskViewModel(identifier: "foo")
+        var taskResult = baseResult
+        taskResult.stepHistory = []
+        viewModel.taskResult = taskResult
+        let archive = archiveResults(for: viewModel, incremental: true, archive: TestIncrementalDataArchive("foo")) { (viewModel) in
+            // Stage a result that is replaced when the participant goes back.
+            let replaced = TestArchivableResult(identifier: "scoreA", score: 1, counter: counter)
+            viewModel.taskResult.appendStepHistory(with: RSDResultObject(identifier: "step1"))
+            viewModel.taskResult.appendStepHistory(with: replaced)
+            viewModel.stageResultForArchive(replaced)
+            viewModel.removeStepHistory(from: "scoreA")
             
+            for result in baseResult.stepHistory.dropFirst() {
+                viewModel.taskResult.appendStepHistory(with: result)
+                viewModel.stageResultForArchive(result)
+            }
+        }
+        
+        // The staged results should not be built again when the archive is completed.
+        XCTAssertEqual(counter.buildCount, 3)
+        XCTAssertEqual(archive.insertedData.map { $0.0.filename }, fullArchive.insertedData.map { $0.0.filename })
+        XCTAssertEqual(archive.insertedData.map { $0.1 }, fullArchive.insertedData.map { $0.1 })
+        XCTAssertEqual(Set(archive.metadata?.files ?? []), Set(fullArchive.metadata?.files ?? []))
+    }
+    
+    func testDataArchiver_Incremental_ChangedResult() {
+        let counter = TestArchivableResult.Counter()
+        let viewModel = buildTaskViewModel(identifier: "foo")
+        let archive = archiveResults(for: viewModel, incremental: true, archive: TestIncrementalDataArchive("foo")) { (viewModel) in
+            // Replace a staged result without staging the replacement.
+            let staged = TestArchivableResult(identifier: "scoreA", score: 1, counter: counter)
+            viewModel.taskResult.appendStepHistory(with: staged)
+            viewModel.stageResultForArchive(staged)
+            viewModel.taskResult.appendStepHistory(with: TestArchivableResult(identifier: "scoreA", score: 2, counter: counter))
+        }
+        
+        // The staged data should be removed and rebuilt for the changed result.
+        XCTAssertEqual(counter.buildCount, 2)
+        let data = archive.insertedData.filter { $0.0.filename == "scoreA.json" }.map { $0.1 }
+        XCTAssertEqual(data.count, 1)
+        XCTAssertEqual(data.first, try? JSONEncoder().encode(["score" : 2]))
+    }
+    
+    func testDataArchiver_Incremental_InsertsStagedData() {
+        let counter = TestArchivableResult.Counter()
+        let viewModel = buildTaskViewModel(identifier: "foo")
+        let archive = TestIncrementalDataArchive("foo")
+        let finalArchive = archiveResults(for: viewModel, incremental: true, archive: archive) { (viewModel) in
+            do {
+                let fileResult = try buildFileResult(identifier: "file", outputDirectory: viewModel.outputDirectory)
+                let scoreA = TestArchivableResult(identifier: "scoreA", score: 1, counter: counter)
+                for result in [fileResult, scoreA] as [RSDResult] {
+                    viewModel.taskResult.appendStepHistory(with: result)
+                    viewModel.stageResultForArchive(result)
+                }
+            } catch let err {
+                XCTFail("Failed to build file result: \(err)")
+            }
             
+            // The staged data is inserted into the archive as each step is completed.
+            viewModel.fileManagementQueue.sync {}
+            XCTAssertEqual(archive.insertedData.map { $0.0.filename }, ["file.txt", "scoreA.json"])
             
+            // Going back removes the staged data from the archive.
+            viewModel.removeStepHistory(from: "scoreA")
+            viewModel.fileManagementQueue.sync {}
+            XCTAssertEqual(archive.insertedData.map { $0.0.filename }, ["file.txt"])
             
+            let scoreB = TestArchivableResult(identifier: "scoreB", score: 2, counter: counter)
+            viewModel.taskResult.appendStepHistory(with: scoreB)
+            viewModel.stageResultForArchive(scoreB)
+        }
+        
+        XCTAssertEqual(counter.buildCount, 2)
+        XCTAssertEqual(finalArchive.insertedData.map { $0.0.filename }, ["file.txt", "scoreB.json", "taskResult.json"])
+        XCTAssertEqual(Set(finalArchive.metadata?.files.map { $0.filename } ?? []), ["file.txt", "scoreB.json", "taskResult.json"])
+    }
+    
+    func testDataArchiver_Incremental_Sections() {
+        let counter = TestArchivableResult.Counter()
+        let viewModel = buildTaskViewModel(identifier: "foo")
+        let manager = TestArchiveManager()
+        let mainArchive = TestIncrementalDataArchive("foo")
+        let subArchive = TestIncrementalDataArchive("sectionB")
+        manager.dataArchiverFor["foo"] = mainArchive
+        manager.dataArchiverFor["sectionB"] = subArchive
+        viewModel.startIncrementalArchive(with: manager)
+        
+        // The results for "sectionA" are added to the main archive and the results for "sectionB" are
+        // added to the archive for that section.
+        var sectionA = RSDTaskResultObject(identifier: "sectionA")
+        sectionA.appendStepHistory(with: TestArchivableResult(identifier: "scoreA", score: 1, counter: counter))
+        sectionA.appendStepHistory(with: buildCollectionResult(identifier: "collection"))
+        var sectionB = RSDTaskResultObject(identifier: "sectionB")
+        sectionB.appendStepHistory(with: TestArchivableResult(identifier: "scoreB", score: 2, counter: counter))
+        sectionB.appendStepHistory(with: buildSingleAnswerResult(identifier: "single", answer: 5))
+        for result in [sectionA, sectionB] {
+            viewModel.taskResult.appendStepHistory(with: result)
+            viewModel.stageResultForArchive(result)
+        }
+        viewModel.fileManagementQueue.sync {}
+        XCTAssertEqual(mainArchive.insertedData.map { $0.0.filename }, ["scoreA.json"])
+        XCTAssertEqual(subArchive.insertedData.map { $0.0.filename }, ["scoreB.json"])
+        
+        let expect = expectation(description: "Archive results \(viewModel.identifier)")
+        viewModel.archiveResults(with: manager) { (err) in
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+        XCTAssertNil(manager.handleArchiveFailure_error)
+        
+        // The staged results should not be built again, and the staged answers should be included.
+        XCTAssertEqual(counter.buildCount, 2)
+        XCTAssertEqual(manager.encryptAndUpload_dataArchives?.map { $0.identifier } ?? [], ["foo", "sectionB"])
+        XCTAssertEqual(mainArchive.insertedData.map { $0.0.filename }, ["scoreA.json", "answers.json", "taskResult.json"])
+        XCTAssertEqual(subArchive.insertedData.map { $0.0.filename }, ["scoreB.json", "answers.json", "taskResult.json"])
+        do {
+            let decoder = RSDFactory.shared.createJSONDecoder()
+            let mainAnswers = try decoder.decode([String : Int].self, from: mainArchive.insertedData[1].1)
+            XCTAssertEqual(mainAnswers, ["sectionA_collection_input1" : 1, "sectionA_collection_input2" : 2, "sectionA_collection_input3" : 3])
+            let subAnswers = try decoder.decode([String : Int].self, from: subArchive.insertedData[1].1)
+            XCTAssertEqual(subAnswers, ["single" : 5])
         } catch let err {
-            XCTFail("Failed unexpectedly: \(err)")
-            return
+            XCTFail("Failed to decode answers: \(err)")
         }
     }
     
+    func testDataArchiver_Incremental_Cancel() {
+        let counter = TestArchivableResult.Counter()
+        let viewModel = buildTaskViewModel(identifier: "foo")
+        let manager = TestArchiveManager()
+        let archive = TestIncrementalDataArchive("foo")
+        manager.dataArchiverFor["foo"] = archive
+        viewModel.startIncrementalArchive(with: manager)
+        
+        let result = TestArchivableResult(identifier: "scoreA", score: 1, counter: counter)
+        viewModel.taskResult.appendStepHistory(with: result)
+        viewModel.stageResultForArchive(result)
+        viewModel.fileManagementQueue.sync {}
+        XCTAssertEqual(archive.insertedData.count, 1)
+        
+        // Cancelling the task should discard the staged data.
+        viewModel.cancel()
+        viewModel.fileManagementQueue.sync {}
+        XCTAssertEqual(archive.insertedData.count, 0)
+    }
+    
+    func testDataArchiver_Concurrent() {
+        let counter = TestArchivableResult.Counter()
+        var taskResult = RSDTaskResultObject(identifier: "foo")
+        taskResult.appendStepHistory(with: TestArchivableResult(identifier: "scoreA", score: 1, counter: counter))
+        taskResult.appendStepHistory(with: TestArchivableResult(identifier: "failed", score: 0, counter: counter, shouldFail: true))
+        for sectionIdentifier in ["sectionA", "sectionB", "sectionC"] {
+            var sectionResult = RSDTaskResultObject(identifier: sectionIdentifier)
+            for ii in 1...4 {
+                sectionResult.appendStepHistory(with: TestArchivableResult(identifier: "score\(ii)", score: ii, counter: counter))
+            }
+            sectionResult.appendStepHistory(with: buildCollectionResult(identifier: "collection"))
+            taskResult.appendStepHistory(with: sectionResult)
+        }
+        taskResult.appendStepHistory(with: TestArchivableResult(identifier: "scoreB", score: 2, counter: counter))
+        
+        func archive(maxConcurrentOperations: Int) -> (TestArchiveManager, [String : TestDataArchive]) {
+            let taskViewModel = buildTaskViewModel(identifier: "foo")
+            taskViewModel.taskResult = taskResult
+            taskViewModel.maxConcurrentArchiveOperations = maxConcurrentOperations
+            let manager = TestArchiveManager()
+            manager.shouldContinueOnFail_return = true
+            for identifier in ["foo", "sectionA", "sectionC"] {
+                manager.dataArchiverFor[identifier] = TestDataArchive(identifier)
+            }
+            let expect = expectation(description: "Archive results \(taskViewModel.identifier)")
+            taskViewModel.archiveResults(with: manager) { (err) in
+                expect.fulfill()
+            }
+            waitForExpectations(timeout: 2) { (err) in
+                XCTAssertNil(err)
+            }
+            return (manager, manager.dataArchiverFor)
+        }
+        
+        let (serialManager, serialArchives) = archive(maxConcurrentOperations: 1)
+        let (manager, archives) = archive(maxConcurrentOperations: 4)
+        
+        XCTAssertNil(manager.handleArchiveFailure_error)
+        XCTAssertNotNil(manager.shouldContinueOnFail_error)
+        XCTAssertEqual(manager.shouldContinueOnFail_archive?.identifier, "foo")
+        XCTAssertEqual(manager.encryptAndUpload_dataArchives?.map { $0.identifier }, serialManager.encryptAndUpload_dataArchives?.map { $0.identifier })
+        XCTAssertEqual(manager.encryptAndUpload_dataArchives?.map { $0.identifier }, ["foo", "sectionA", "sectionC"])
+        
+        for (identifier, serialArchive) in serialArchives {
+            guard let archive = archives[identifier] else {
+                XCTFail("Missing archive \(identifier)")
+                continue
+            }
+            XCTAssertEqual(archive.insertedData.map { $0.0.filename }, serialArchive.insertedData.map { $0.0.filename }, identifier)
+            XCTAssertEqual(archive.insertedData.map { $0.1 }, serialArchive.insertedData.map { $0.1 }, identifier)
+        }
+        
+        // The results from section B are added to the main archive.
+        XCTAssertEqual(archives["foo"]?.insertedData.map { $0.0.filename },
+                       ["scoreA.json", "score1.json", "score2.json", "score3.json", "score4.json", "scoreB.json", "answers.json", "taskResult.json"])
+    }
+    
+    func testDataArchiver_Concurrent_BoundsPendingData() {
+        let counter = TestArchivableResult.Counter()
+        let resultCount = 20
+        var taskResult = RSDTaskResultObject(identifier: "foo")
+        for ii in 0..<resultCount {
+            taskResult.appendStepHistory(with: TestArchivableResult(identifier: "score\(ii)", score: ii, counter: counter))
+        }
+        let taskViewModel = buildTaskViewModel(identifier: "foo")
+        taskViewModel.taskResult = taskResult
+        taskViewModel.maxConcurrentArchiveOperations = 2
+        let manager = TestArchiveManager()
+        let archive = TestDataArchive("foo")
+        manager.dataArchiverFor["foo"] = archive
+        
+        // When a result is inserted, only the results up to the size of the worker pool past it can
+        // have been built.
+        var maxPendingCount = 0
+        archive.insertDataIntoArchive_called = { _ in
+            maxPendingCount = max(maxPendingCount, counter.buildCount - archive.insertedData.count)
+        }
+        let expect = expectation(description: "Archive results \(taskViewModel.identifier)")
+        taskViewModel.archiveResults(with: manager) { (err) in
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+        XCTAssertEqual(counter.buildCount, resultCount)
+        XCTAssertLessThanOrEqual(maxPendingCount, 2)
+        XCTAssertEqual(archive.insertedData.prefix(resultCount).map { $0.0.filename }, (0..<resultCount).map { "score\($0).json" })
+    }
+    
     // Helper method
     
+    func archiveResults(for taskViewModel: RSDTaskViewModel, incremental: Bool, archive: TestDataArchive? = nil, runTask: (RSDTaskViewModel) -> Void) -> TestDataArchive {
+        let manager = TestArchiveManager()
+        let archive = archive ?? TestDataArchive(taskViewModel.taskResult.identifier)
+        manager.dataArchiverFor[taskViewModel.taskResult.identifier] = archive
+        if incremental {
+            taskViewModel.startIncrementalArchive(with: manager)
+        }
+        runTask(taskViewModel)
+        
+        let expect = expectation(description: "Archive results \(taskViewModel.identifier)")
+        taskViewModel.archiveResults(with: manager) { (err) in
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+        XCTAssertNil(manager.handleArchiveFailure_error)
+        return archive
+    }
+    
     func buildTaskViewModel(identifier: String) -> RSDTaskViewModel {
         let navigator = RSDConditionalStepNavigatorObject(with: [])
         let task = RSDTaskObject(identifier: identifier, stepNavigator: navigator)
@@ -224,7 +500,7 @@ class DataArchiveTests: XCTestCase {
     }
     
     func buildFileResult(identifier: String, outputDirectory: URL) throws -> RSDFileResultObject {
-
+        
         let url = try RSDFileResultUtility.createFileURL(identifier: identifier, ext: "txt", outputDirectory: outputDirectory)
         let uuid = UUID().uuidString
         try uuid.write(to: url, atomically: true, encoding: .utf8)
@@ -300,7 +576,7 @@ class TestArchiveManager: NSObject, RSDDataArchiveManager {
 }
 
 class TestDataArchive: NSObject, RSDDataArchive {
-
+    
     let identifier: String
     var scheduleIdentifier: String?
     
@@ -313,12 +589,14 @@ class TestDataArchive: NSObject, RSDDataArchive {
     var shouldInsert: [RSDReservedFilename] = [.answers, .taskResult, .metadata]
     var insertedData: [(RSDFileManifest, Data)] = []
     var metadata: RSDTaskMetadata?
+    var insertDataIntoArchive_called: ((RSDFileManifest) -> Void)?
     
     func shouldInsertData(for filename: RSDReservedFilename) -> Bool {
         return shouldInsert.contains(filename)
     }
     
     func insertDataIntoArchive(_ data: Data, manifest: RSDFileManifest) {
+        insertDataIntoArchive_called?(manifest)
         insertedData.append((manifest, data))
     }
     
@@ -330,3 +608,67 @@ class TestDataArchive: NSObject, RSDDataArchive {
         return result as? RSDArchivable
     }
 }
+
+class TestIncrementalDataArchive: TestDataArchive, RSDIncrementalDataArchive {
+    
+    func removeDataFromArchive(with manifest: RSDFileManifest) throws {
+        insertedData.removeAll(where: { $0.0 == manifest })
+    }
+}
+
+struct TestArchivableResult : RSDResult, RSDArchivable {
+    
+    final class Counter {
+        private let lock = NSLock()
+        private var _buildCount: Int = 0
+        
+        var buildCount: Int {
+            get {
+                lock.lock()
+                defer { lock.unlock() }
+                return _buildCount
+            }
+            set {
+                lock.lock()
+                _buildCount = newValue
+                lock.unlock()
+            }
+        }
+        
+        func increment() {
+            lock.lock()
+            _buildCount += 1
+            lock.unlock()
+        }
+    }
+    
+    private enum CodingKeys : String, CodingKey {
+        case identifier, type, startDate, endDate, score
+    }
+    
+    let identifier: String
+    let type: RSDResultType = "testArchivable"
+    var startDate: Date = Date(timeIntervalSinceReferenceDate: 0)
+    var endDate: Date = Date(timeIntervalSinceReferenceDate: 0)
+    let score: Int
+    let counter: Counter
+    let shouldFail: Bool
+    
+    init(identifier: String, score: Int, counter: Counter, shouldFail: Bool = false) {
+        self.identifier = identifier
+        self.score = score
+        self.counter = counter
+        self.shouldFail = shouldFail
+        self.endDate = Date(timeIntervalSinceReferenceDate: TimeInterval(score))
+    }
+    
+    func buildArchiveData(at stepPath: String?) throws -> (manifest: RSDFileManifest, data: Data)? {
+        if shouldFail {
+            throw RSDValidationError.undefinedClassType("Test failure for \(identifier)")
+        }
+        counter.increment()
+        let manifest = RSDFileManifest(filename: "\(identifier).json", timestamp: startDate, contentType: "application/json", identifier: identifier, stepPath: stepPath)
+        let data = try JSONEncoder().encode(["score" : score])
+        return (manifest, data)
+    }
+}
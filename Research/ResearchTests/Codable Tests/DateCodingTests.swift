@@ -0,0 +1,145 @@
+//
+//  DateCodingTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class DateCodingTests: XCTestCase {
+    
+    let timestamps = ["2017-10-16T22:28:09.000-07:00",
+                      "2017-10-16T22:28:09.123Z",
+                      "2017-10-16T22:28:09.999+05:30",
+                      "2016-02-29T00:00:00.001-02:30",
+                      "1969-12-31T23:59:59.999+00:00",
+                      "1600-01-01T12:00:00.500-08:00",
+                      "2019-11-06T10:05:03.042-0800",
+                      "2019-11-06T10:05:03-08:00",
+                      "2019-11-06T10:05:03Z"]
+    
+    override func setUp() {
+        super.setUp()
+        
+        // Use a statically defined timezone.
+        rsd_ISO8601TimestampFormatter.timeZone = TimeZone(secondsFromGMT: Int(-2.5 * 60 * 60))
+    }
+    
+    func formatterDate(from string: String) -> Date? {
+        let androidFormatter = DateFormatter()
+        androidFormatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSSZ"
+        androidFormatter.locale = Locale(identifier: "en_US_POSIX")
+        return rsd_ISO8601TimestampFormatter.date(from: string) ??
+            androidFormatter.date(from: string) ??
+            ISO8601DateFormatter().date(from: string)
+    }
+    
+    func testDecodeTimestamp_MatchesFormatter() {
+        for string in timestamps {
+            guard case .timestamp(let date) = RSDISO8601Shape(string) else {
+                XCTFail("Failed to parse \(string)")
+                continue
+            }
+            XCTAssertEqual(date, formatterDate(from: string), string)
+            XCTAssertEqual(RSDFactory.shared.decodeDate(from: string), date, string)
+        }
+    }
+    
+    func testDecodeShapes() {
+        let dateOnly = RSDFactory.shared.decodeDate(from: "2017-10-16")
+        XCTAssertEqual(dateOnly, rsd_ISO8601DateOnlyFormatter.date(from: "2017-10-16"))
+        let timeOnly = RSDFactory.shared.decodeDate(from: "08:30:15.250")
+        XCTAssertEqual(timeOnly, rsd_ISO8601TimeOnlyFormatter.date(from: "08:30:15.250"))
+        XCTAssertNotNil(RSDFactory.shared.decodeDate(from: "08:30:15"))
+        
+        // Decoding a time without fractional seconds should not change the shared time-only formatter.
+        XCTAssertEqual(rsd_ISO8601TimeOnlyFormatter.dateFormat, "HH:mm:ss.SSS")
+        
+        if case .unknown = RSDISO8601Shape("2017-02-30T10:00:00.000Z") {} else {
+            XCTFail("Expected an invalid date to fall back to the formatters.")
+        }
+        if case .unknown = RSDISO8601Shape("1500-01-01T10:00:00.000Z") {} else {
+            XCTFail("Expected a date before the Gregorian cutover to fall back to the formatters.")
+        }
+        XCTAssertNil(RSDFactory.shared.decodeDate(from: "not a date"))
+    }
+    
+    func testEncodeTimestamp_MatchesFormatter() {
+        let timeZones = [TimeZone(secondsFromGMT: 0)!,
+                         TimeZone(secondsFromGMT: Int(-2.5 * 60 * 60))!,
+                         TimeZone(identifier: "America/Los_Angeles")!,
+                         TimeZone(identifier: "Asia/Kolkata")!]
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyy-MM-dd'T'HH:mm:ss.SSSZZZZZ"
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        var dates = timestamps.compactMap { formatterDate(from: $0) }
+        dates.append(Date(timeIntervalSinceReferenceDate: 0.0005))
+        dates.append(Date(timeIntervalSince1970: -0.0005))
+        dates.append(Date(timeIntervalSinceReferenceDate: 592_000_000.123_456))
+        for timeZone in timeZones {
+            formatter.timeZone = timeZone
+            for date in dates {
+                XCTAssertEqual(rsd_ISO8601TimestampString(from: date, timeZone: timeZone),
+                               formatter.string(from: date), "\(timeZone)")
+            }
+        }
+    }
+    
+    func testDecodeDatePerformance() {
+        let factory = RSDFactory()
+        let strings = (0..<2000).map { "2019-11-06T10:\(String(format: "%02d", $0 % 60)):03.042-07:00" }
+        measure {
+            for string in strings {
+                _ = factory.decodeDate(from: string)
+            }
+        }
+    }
+    
+    func testDecodeDateFallbackPerformance() {
+        let factory = RSDFactory()
+        let strings = (0..<2000).map { _ in "not a date" }
+        measure {
+            for string in strings {
+                _ = factory.decodeDate(from: string)
+            }
+        }
+    }
+    
+    func testEncodeDatePerformance() {
+        let factory = RSDFactory()
+        let dates = (0..<2000).map { Date(timeIntervalSinceReferenceDate: 592_000_000 + Double($0) * 0.137) }
+        measure {
+            for date in dates {
+                _ = factory.encodeString(from: date, codingPath: [])
+            }
+        }
+    }
+}
@@ -0,0 +1,153 @@
+//
+//  JSONCoderCacheTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class JSONCoderCacheTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+        
+        // Use a statically defined timezone.
+        rsd_ISO8601TimestampFormatter.timeZone = TimeZone(secondsFromGMT: Int(-2.5 * 60 * 60))
+    }
+    
+    func testWithJSONEncoder_ReusesEncoder() {
+        let factory = RSDFactory()
+        var codingInfos: [ObjectIdentifier] = []
+        for _ in 0..<10 {
+            factory.withJSONEncoder { (encoder: JSONEncoder) -> Void in
+                if let codingInfo = encoder.userInfo[.codingInfo] as? RSDCodingInfo {
+                    codingInfos.append(ObjectIdentifier(codingInfo))
+                }
+                XCTAssertTrue(RSDFactory.factory(from: encoder.userInfo) === factory)
+            }
+        }
+        XCTAssertEqual(factory.coderCache.createdCount, 1)
+        XCTAssertEqual(Set(codingInfos).count, 10, "Each use should have a new coding info.")
+    }
+    
+    func testWithJSONDecoder_ResetsUserInfo() {
+        let factory = RSDFactory()
+        factory.withJSONDecoder(taskIdentifier: "foo") { (decoder: JSONDecoder) -> Void in
+            XCTAssertEqual(decoder.userInfo[.taskIdentifier] as? String, "foo")
+        }
+        factory.withJSONDecoder { (decoder: JSONDecoder) -> Void in
+            XCTAssertNil(decoder.userInfo[.taskIdentifier])
+            XCTAssertNotNil(decoder.userInfo[.codingInfo] as? RSDCodingInfo)
+        }
+        XCTAssertEqual(factory.coderCache.createdCount, 1)
+    }
+    
+    func testDecodeTask_ReusesDecoder() {
+        let factory = RSDFactory()
+        let json = """
+        {
+            "identifier": "foo",
+            "steps": [
+                {
+                    "identifier": "step1",
+                    "type": "instruction",
+                    "title": "Step 1"
+                }
+            ]
+        }
+        """.data(using: .utf8)!
+        
+        for _ in 0..<10 {
+            do {
+                let task = try factory.decodeTask(with: json, resourceType: .json, taskIdentifier: "bar")
+                XCTAssertEqual(task.identifier, "bar")
+            } catch let err {
+                XCTFail("Failed to decode task: \(err)")
+            }
+        }
+        XCTAssertEqual(factory.coderCache.createdCount, 1)
+    }
+    
+    func testCachedCoders_DoNotRetainFactory() {
+        weak var weakFactory: RSDFactory?
+        do {
+            let factory = RSDFactory()
+            weakFactory = factory
+            let result = RSDTaskResultObject.exampleResult()
+            let data = factory.withJSONEncoder { try? $0.encode(result) }
+            XCTAssertNotNil(data)
+            let session = factory.createEncodingSession(outputFormat: .compact)
+            XCTAssertNotNil(try? session.encode(result))
+            if let data = data {
+                let decoded = factory.withJSONDecoder { try? $0.decode(RSDTaskResultObject.self, from: data) }
+                XCTAssertEqual(decoded?.identifier, result.identifier)
+            }
+        }
+        XCTAssertNil(weakFactory, "The cached coders should not retain the factory.")
+    }
+    
+    func testEncodingSession_MatchesEncoder() {
+        let result = RSDTaskResultObject.exampleResult()
+        let expected = try? RSDFactory.shared.createJSONEncoder().encode(result)
+        let session = RSDFactory.shared.createEncodingSession()
+        XCTAssertEqual(try? session.encode(result), expected)
+        XCTAssertEqual(try? session.encodeObject(result), expected)
+        XCTAssertEqual(session.encodeCount, 2)
+        
+        let compactSession = RSDFactory.shared.createEncodingSession(outputFormat: .compact)
+        let compactData = try? compactSession.encode(result)
+        XCTAssertNotNil(compactData)
+        XCTAssertLessThan(compactData?.count ?? .max, expected?.count ?? 0)
+    }
+    
+    func testEncodePerformance_NewEncoder() {
+        let result = RSDTaskResultObject.exampleResult()
+        let factory = RSDFactory()
+        measure {
+            for _ in 0..<200 {
+                _ = try? factory.createJSONEncoder().encode(result)
+            }
+        }
+    }
+    
+    func testEncodePerformance_EncodingSession() {
+        let result = RSDTaskResultObject.exampleResult()
+        let factory = RSDFactory()
+        measure {
+            let session = factory.createEncodingSession()
+            for _ in 0..<200 {
+                _ = try? session.encode(result)
+            }
+        }
+        // Only one encoder should be allocated for all the measured encodes.
+        XCTAssertEqual(factory.coderCache.createdCount, 1)
+    }
+}
@@ -333,6 +333,110 @@ class FormatterTests: XCTestCase {
         XCTAssertFalse(success)
     }
     
+    func testFractionFormatter_MaximumDenominator() {
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 7, RSDFractionDefaultTolerance).numerator, 22)
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 7, RSDFractionDefaultTolerance).denominator, 7)
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 100, RSDFractionDefaultTolerance).numerator, 311)
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 100, RSDFractionDefaultTolerance).denominator, 99)
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 1000, RSDFractionDefaultTolerance).numerator, 355)
+        XCTAssertEqual(RSDFractionFromDouble(Double.pi, 1000, RSDFractionDefaultTolerance).denominator, 113)
+        XCTAssertEqual(RSDFractionFromDouble(-0.75, 1000, RSDFractionDefaultTolerance).numerator, -3)
+        XCTAssertEqual(RSDFractionFromDouble(-0.75, 1000, RSDFractionDefaultTolerance).denominator, 4)
+        XCTAssertEqual(RSDFractionFromDouble(Double.nan, 1000, RSDFractionDefaultTolerance).denominator, 0)
+    }
+    
+    func testFractionFormatter_Coding() {
+        let formatter = RSDFractionFormatter()
+        formatter.maximumDenominator = 16
+        formatter.tolerance = 0.01
+        
+        let data = NSKeyedArchiver.archivedData(withRootObject: formatter)
+        guard let decoded = NSKeyedUnarchiver.unarchiveObject(with: data) as? RSDFractionFormatter else {
+            XCTFail("Failed to decode the formatter")
+            return
+        }
+        XCTAssertEqual(decoded.maximumDenominator, 16)
+        XCTAssertEqual(decoded.tolerance, 0.01)
+        XCTAssertEqual(decoded.string(from: NSNumber(value: Double.pi)), "22/7")
+    }
+    
+    func testFractionFormatter_MatchesSternBrocot() {
+        let values = fractionTestValues()
+        for value in values {
+            let expected = sternBrocotFraction(value)
+            let actual = NSNumber(value: value).fractionalValue()
+            XCTAssertEqual(actual.numerator, expected.numerator, "\(value)")
+            XCTAssertEqual(actual.denominator, expected.denominator, "\(value)")
+        }
+    }
+    
+    func testFractionFormatter_Batch() {
+        let values = fractionTestValues()
+        var fractions = Array(repeating: RSDFraction(), count: values.count)
+        RSDFractionsFromDoubles(values, &fractions, values.count, RSDFractionDefaultMaximumDenominator, RSDFractionDefaultTolerance)
+        for (idx, value) in values.enumerated() {
+            let expected = NSNumber(value: value).fractionalValue()
+            XCTAssertEqual(fractions[idx].numerator, expected.numerator, "\(value)")
+            XCTAssertEqual(fractions[idx].denominator, expected.denominator, "\(value)")
+        }
+    }
+    
+    func testFractionFormatter_Performance_ContinuedFraction() {
+        let values = fractionTestValues()
+        var fractions = Array(repeating: RSDFraction(), count: values.count)
+        self.measure {
+            for _ in 0..<10 {
+                RSDFractionsFromDoubles(values, &fractions, values.count, RSDFractionDefaultMaximumDenominator, RSDFractionDefaultTolerance)
+            }
+        }
+    }
+    
+    func testFractionFormatter_Performance_SternBrocot() {
+        let values = fractionTestValues()
+        self.measure {
+            for _ in 0..<10 {
+                _ = values.map { sternBrocotFraction($0) }
+            }
+        }
+    }
+    
+    /// Fractions from halves through 64ths, plus a few values that are not common fractions.
+    func fractionTestValues() -> [Double] {
+        var values: [Double] = [0.1, 0.3, 1.0 / 7.0, 2.0 / 11.0, 0.123, 12.3456]
+        for denominator in 2...64 {
+            for numerator in 1..<(2 * denominator) {
+                values.append(Double(numerator) / Double(denominator))
+            }
+        }
+        return values
+    }
+    
+    /// Stern-Brocot search used by earlier versions of `-[NSNumber fractionalValue]`.
+    func sternBrocotFraction(_ value: Double) -> (numerator: Int, denominator: Int) {
+        let accuracy = 0.00001
+        var x = value
+        let n = floor(x)
+        x -= n
+        if x < accuracy {
+            return (Int(n), 1)
+        } else if (1 - accuracy) < x {
+            return (Int(n + 1), 1)
+        }
+        var lower = (n: 0.0, d: 1.0)
+        var upper = (n: 1.0, d: 1.0)
+        for _ in 0..<1000 {
+            let middle = (n: lower.n + upper.n, d: lower.d + upper.d)
+            if middle.d * (x + accuracy) < middle.n {
+                upper = middle
+            } else if middle.n < (x - accuracy) * middle.d {
+                lower = middle
+            } else {
+                return (Int(n * middle.d + middle.n), Int(middle.d))
+            }
+        }
+        return (1, 0)
+    }
+    
     func testDurationFormatter_1hour_2minute_full() {
         NSLocale.setCurrentTest(Locale(identifier: "en_US"))
 
@@ -446,4 +550,82 @@ class FormatterTests: XCTestCase {
             XCTFail("Failed to convert string to inches")
         }
     }
+    
+    func testDurationFormatter_1hour_2minute_30second_positional() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        
+        let formatter = RSDDurationFormatter()
+        formatter.fromStringUnit = .seconds
+        formatter.unitsStyle = .positional
+        formatter.allowedUnits = [.hour, .minute, .second]
+        
+        XCTAssertEqual(formatter.number(from: "1:02:30")?.doubleValue, 3750)
+        XCTAssertEqual(formatter.number(from: "0:00:12.5")?.doubleValue, 12.5)
+        XCTAssertEqual(formatter.number(from: "1:02:30:45")?.doubleValue, 3750)
+    }
+    
+    func testDurationFormatter_Positional_DefersToSuper() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        
+        let formatter = RSDDurationFormatter()
+        formatter.fromStringUnit = .seconds
+        formatter.unitsStyle = .positional
+        formatter.allowedUnits = [.hour, .minute, .second]
+        
+        let systemFormatter = DateComponentsFormatter()
+        systemFormatter.unitsStyle = .positional
+        systemFormatter.allowedUnits = [.hour, .minute, .second]
+        
+        // If the system formatter can parse the string, then its value is used rather than the value
+        // from the positional scanner.
+        let inputString = "1:02:30"
+        var systemObj: AnyObject?
+        let systemSuccess = systemFormatter.getObjectValue(&systemObj, for: inputString, errorDescription: nil)
+        
+        var obj: AnyObject?
+        let success = formatter.getObjectValue(&obj, for: inputString, errorDescription: nil)
+        XCTAssertTrue(success)
+        if systemSuccess, let num = systemObj as? NSNumber {
+            XCTAssertEqual((obj as? NSMeasurement)?.doubleValue, num.doubleValue)
+        }
+        else if systemSuccess, let measurement = systemObj as? NSMeasurement {
+            XCTAssertEqual(obj as? NSMeasurement, measurement)
+        }
+        else if let output = obj as? Measurement<UnitDuration> {
+            XCTAssertEqual(output.converted(to: .seconds).value, 3750)
+        }
+        else {
+            XCTFail("Failed to convert \(inputString) to a duration")
+        }
+    }
+    
+    func testDurationFormatter_Performance_String() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        
+        let formatter = RSDDurationFormatter()
+        formatter.unitsStyle = .positional
+        formatter.allowedUnits = [.minute, .second]
+        formatter.zeroFormattingBehavior = .pad
+        
+        self.measure {
+            for ii in 0..<1000 {
+                _ = formatter.string(from: TimeInterval(ii))
+            }
+        }
+    }
+    
+    func testDurationFormatter_Performance_Number() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        
+        let formatter = RSDDurationFormatter()
+        formatter.unitsStyle = .positional
+        formatter.allowedUnits = [.hour, .minute, .second]
+        let strings = (0..<1000).map { "\($0 / 3600):\(($0 / 60) % 60):\($0 % 60)" }
+        
+        self.measure {
+            for string in strings {
+                _ = formatter.number(from: string)
+            }
+        }
+    }
 }
@@ -0,0 +1,204 @@
+//
+//  MeasurementParserTests.swift
+//  Research
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class MeasurementParserTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+    }
+    
+    override func tearDown() {
+        NSLocale.setCurrentTest(nil)
+        super.tearDown()
+    }
+    
+    func lengthFormatter() -> RSDLengthFormatter {
+        let formatter = RSDLengthFormatter()
+        formatter.isForPersonHeightUse = true
+        formatter.unitStyle = .medium
+        return formatter
+    }
+    
+    func massFormatter() -> RSDMassFormatter {
+        let formatter = RSDMassFormatter()
+        formatter.isForPersonMassUse = true
+        formatter.unitStyle = .medium
+        return formatter
+    }
+    
+    func frenchLengthFormatter() -> RSDLengthFormatter {
+        let formatter = lengthFormatter()
+        formatter.numberFormatter.decimalSeparator = ","
+        formatter.numberFormatter.groupingSeparator = " "
+        return formatter
+    }
+    
+    func testParserCache() {
+        let parser1 = RSDMeasurementParser.parser(for: lengthFormatter().numberFormatter)
+        let parser2 = RSDMeasurementParser.parser(for: massFormatter().numberFormatter)
+        XCTAssertNotNil(parser1)
+        XCTAssertTrue(parser1 === parser2)
+        
+        let parser3 = RSDMeasurementParser.parser(for: frenchLengthFormatter().numberFormatter)
+        XCTAssertNotNil(parser3)
+        XCTAssertFalse(parser1 === parser3)
+        XCTAssertEqual(parser3?.decimalSeparator, ",")
+        XCTAssertEqual(parser3?.groupingSeparator, " ")
+    }
+    
+    func testParser_5ft_3in() {
+        let formatter = lengthFormatter() as! RSDMeasurementFormatter
+        guard let measurement = RSDMeasurementWrapper.measurement(from: "5' 3\"", with: formatter) else {
+            XCTFail("Failed to parse the string")
+            return
+        }
+        XCTAssertEqual(measurement.converting(to: UnitLength.inches).doubleValue, 63, accuracy: 0.0001)
+    }
+    
+    func testParser_3lb_4oz() {
+        let formatter = massFormatter() as! RSDMeasurementFormatter
+        guard let measurement = RSDMeasurementWrapper.measurement(from: "3 lb, 4 oz", with: formatter) else {
+            XCTFail("Failed to parse the string")
+            return
+        }
+        XCTAssertEqual(measurement.converting(to: UnitMass.ounces).doubleValue, 52, accuracy: 0.0001)
+    }
+    
+    func testParser_GroupingAndDecimal() {
+        let formatter = frenchLengthFormatter() as! RSDMeasurementFormatter
+        guard let measurement = RSDMeasurementWrapper.measurement(from: "1 234,5 cm", with: formatter) else {
+            XCTFail("Failed to parse the string")
+            return
+        }
+        XCTAssertEqual(measurement.unit, UnitLength.centimeters)
+        XCTAssertEqual(measurement.doubleValue, 1234.5, accuracy: 0.0001)
+    }
+    
+    func testParser_NoUnit() {
+        let formatter = lengthFormatter()
+        formatter.fromStringUnit = .inches
+        guard let measurement = RSDMeasurementWrapper.measurement(from: "12.5", with: formatter as! RSDMeasurementFormatter) else {
+            XCTFail("Failed to parse the string")
+            return
+        }
+        XCTAssertEqual(measurement.unit, UnitLength.inches)
+        XCTAssertEqual(measurement.doubleValue, 12.5, accuracy: 0.0001)
+    }
+    
+    func testParser_NoNumber() {
+        let formatter = lengthFormatter() as! RSDMeasurementFormatter
+        XCTAssertNil(RSDMeasurementWrapper.measurement(from: "ft", with: formatter))
+    }
+    
+    func testParser_NotAMeasurementResult() {
+        let formatter = lengthFormatter() as! RSDMeasurementFormatter
+        guard let parser = RSDMeasurementParser.parser(for: formatter.numberFormatter()) else {
+            XCTFail("Failed to create the parser")
+            return
+        }
+        var result = RSDMeasurementParserResult.unsupported
+        XCTAssertNil(parser.measurement(from: "ft", with: formatter, result: &result))
+        XCTAssertEqual(result, .notAMeasurement)
+        
+        XCTAssertNotNil(parser.measurement(from: "20 in", with: formatter, result: &result))
+        XCTAssertEqual(result, .measurement)
+        
+        // A string with more parts than the parser can scan falls back to the regex parser.
+        let longString = Array(repeating: "1 in", count: 20).joined(separator: " ")
+        XCTAssertNil(parser.measurement(from: longString, with: formatter, result: &result))
+        XCTAssertEqual(result, .unsupported)
+        XCTAssertNotNil(RSDMeasurementWrapper.measurement(from: longString, with: formatter))
+    }
+    
+    func testRegex_NonBreakingSpaceGrouping() {
+        let formatter = lengthFormatter()
+        formatter.numberFormatter.decimalSeparator = ","
+        formatter.numberFormatter.groupingSeparator = "\u{00A0}"
+        guard let measurement = RSDMeasurementWrapper.regexMeasurement(from: "1\u{00A0}234,5 cm", with: formatter as! RSDMeasurementFormatter) else {
+            XCTFail("Failed to parse the string")
+            return
+        }
+        XCTAssertEqual(measurement.doubleValue, 1234.5, accuracy: 0.0001)
+    }
+    
+    func testParser_MatchesRegex() {
+        let corpus = ["5' 3\"", "5′ 6″", "20 in", "5 ft, 6 in", "5 foot 6", "170 cm", "1.75 m", ".5 in"]
+        let formatter = lengthFormatter() as! RSDMeasurementFormatter
+        for string in corpus {
+            let expected = RSDMeasurementWrapper.regexMeasurement(from: string, with: formatter)
+            let actual = RSDMeasurementWrapper.measurement(from: string, with: formatter)
+            XCTAssertNotNil(actual, "\(string)")
+            if let expected = expected, let actual = actual {
+                XCTAssertEqual(actual.converting(to: UnitLength.meters).doubleValue,
+                               expected.converting(to: UnitLength.meters).doubleValue,
+                               accuracy: 0.00001, "\(string)")
+            }
+        }
+    }
+    
+    // MARK: Performance
+    
+    let lengthCorpus = ["5' 3\"", "5′ 6″", "20 in", "5 ft, 6 in", "170 cm", "1.75 m"]
+    let massCorpus = ["3 lb, 4 oz", "120 lb", "65.5 kg", "8 lb, 11.5 oz"]
+    let iterations = 1000
+    
+    func testPerformance_Parser() {
+        let length = lengthFormatter() as! RSDMeasurementFormatter
+        let mass = massFormatter() as! RSDMeasurementFormatter
+        let french = frenchLengthFormatter() as! RSDMeasurementFormatter
+        self.measure {
+            for _ in 0..<iterations {
+                lengthCorpus.forEach { _ = RSDMeasurementWrapper.measurement(from: $0, with: length) }
+                massCorpus.forEach { _ = RSDMeasurementWrapper.measurement(from: $0, with: mass) }
+                _ = RSDMeasurementWrapper.measurement(from: "1 234,5 cm", with: french)
+            }
+        }
+    }
+    
+    func testPerformance_Regex() {
+        let length = lengthFormatter() as! RSDMeasurementFormatter
+        let mass = massFormatter() as! RSDMeasurementFormatter
+        let french = frenchLengthFormatter() as! RSDMeasurementFormatter
+        self.measure {
+            for _ in 0..<iterations {
+                lengthCorpus.forEach { _ = RSDMeasurementWrapper.regexMeasurement(from: $0, with: length) }
+                massCorpus.forEach { _ = RSDMeasurementWrapper.regexMeasurement(from: $0, with: mass) }
+                _ = RSDMeasurementWrapper.regexMeasurement(from: "1 234,5 cm", with: french)
+            }
+        }
+    }
+}
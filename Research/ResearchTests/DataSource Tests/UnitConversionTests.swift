@@ -63,6 +63,49 @@ class UnitConversionTests: XCTestCase {
         XCTAssertEqual(UnitMass(fromSymbol: "lb"), UnitMass.pounds)
     }
     
+    func testUnitLengthForLocalizedString() {
+        let locale = Locale(identifier: "en_US")
+        XCTAssertEqual(UnitLength(fromLocalizedString: "foot", locale: locale, unitStyle: .long), UnitLength.feet)
+        XCTAssertEqual(UnitLength(fromLocalizedString: "feet", locale: locale, unitStyle: .long), UnitLength.feet)
+        XCTAssertEqual(UnitLength(fromLocalizedString: "inches", locale: locale, unitStyle: .long), UnitLength.inches)
+        XCTAssertEqual(UnitLength(fromLocalizedString: "centimeters", locale: locale, unitStyle: .long), UnitLength.centimeters)
+        XCTAssertNil(UnitLength(fromLocalizedString: "pounds", locale: locale, unitStyle: .long))
+    }
+    
+    func testUnitMassForLocalizedString() {
+        let locale = Locale(identifier: "en_US")
+        XCTAssertEqual(UnitMass(fromLocalizedString: "pound", locale: locale, unitStyle: .long), UnitMass.pounds)
+        XCTAssertEqual(UnitMass(fromLocalizedString: "pounds", locale: locale, unitStyle: .long), UnitMass.pounds)
+        XCTAssertEqual(UnitMass(fromLocalizedString: "ounces", locale: locale, unitStyle: .long), UnitMass.ounces)
+        XCTAssertEqual(UnitMass(fromLocalizedString: "kilograms", locale: locale, unitStyle: .long), UnitMass.kilograms)
+        XCTAssertNil(UnitMass(fromLocalizedString: "feet", locale: locale, unitStyle: .long))
+    }
+    
+    func testUnitForLocalizedString_AllForms() {
+        let locale = Locale(identifier: "en_US")
+        
+        // Symbols
+        XCTAssertEqual(UnitMass(fromLocalizedString: "kg", locale: locale, unitStyle: .long), UnitMass.kilograms)
+        XCTAssertEqual(UnitLength(fromLocalizedString: "cm", locale: locale, unitStyle: .long), UnitLength.centimeters)
+        
+        // Short names
+        let lengthFormatter = LengthFormatter()
+        lengthFormatter.numberFormatter.locale = locale
+        lengthFormatter.unitStyle = .short
+        let shortFoot = lengthFormatter.unitString(fromValue: 1, unit: .foot)
+        XCTAssertEqual(UnitLength(fromLocalizedString: shortFoot, locale: locale, unitStyle: .long), UnitLength.feet)
+        let massFormatter = MassFormatter()
+        massFormatter.numberFormatter.locale = locale
+        massFormatter.unitStyle = .short
+        let shortPound = massFormatter.unitString(fromValue: 1, unit: .pound)
+        XCTAssertEqual(UnitMass(fromLocalizedString: shortPound, locale: locale, unitStyle: .long), UnitMass.pounds)
+        
+        // Long and plural names
+        XCTAssertEqual(UnitMass(fromLocalizedString: "kilogram", locale: locale, unitStyle: .short), UnitMass.kilograms)
+        XCTAssertEqual(UnitMass(fromLocalizedString: "stones", locale: locale, unitStyle: .short), UnitMass.stones)
+        XCTAssertEqual(UnitLength(fromLocalizedString: "millimeters", locale: locale, unitStyle: .short), UnitLength.millimeters)
+    }
+    
     func testFeetAndInchesConverter() {
         let converter = RSDUnitConverter.feetAndInches
         
@@ -90,4 +133,68 @@ class UnitConversionTests: XCTestCase {
         let measurement = converter.measurement(fromLargeValue: 8, smallValue: 12)
         XCTAssertEqual(measurement.converted(to: .kilograms).value, 3.97, accuracy: 0.01)
     }
+    
+    func testBatchConvert() {
+        var values: [Double] = [0, 1, 12, 66]
+        RSDUnitConverter.convert(&values, from: UnitLength.inches, to: UnitLength.centimeters)
+        XCTAssertEqual(values.count, 4)
+        XCTAssertEqual(values[0], 0, accuracy: 0.0001)
+        XCTAssertEqual(values[1], 2.54, accuracy: 0.0001)
+        XCTAssertEqual(values[2], 30.48, accuracy: 0.0001)
+        XCTAssertEqual(values[3], 167.64, accuracy: 0.0001)
+        
+        var temperatures: [Double] = [0, 100]
+        RSDUnitConverter.convert(&temperatures, from: UnitTemperature.celsius, to: UnitTemperature.fahrenheit)
+        XCTAssertEqual(temperatures[0], 32, accuracy: 0.0001)
+        XCTAssertEqual(temperatures[1], 212, accuracy: 0.0001)
+        
+        var pounds: [Double] = [1, 8.75]
+        RSDUnitConverter.poundAndOunces.convertToBaseUnit(&pounds, from: .pounds)
+        XCTAssertEqual(pounds[0], 0.4536, accuracy: 0.0001)
+        XCTAssertEqual(pounds[1], 3.969, accuracy: 0.001)
+    }
+    
+    func testBatchFormatter_Length() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        defer { NSLocale.setCurrentTest(nil) }
+        
+        let formatter = RSDLengthFormatter()
+        formatter.isForPersonHeightUse = true
+        formatter.unitStyle = .medium
+        
+        let values: [Double] = [167.64, 152.4]
+        let strings = values.withUnsafeBufferPointer { formatter.strings(fromValues: $0.baseAddress!, count: $0.count) }
+        let expected = values.map { formatter.string(for: $0) }
+        XCTAssertEqual(strings, expected.compactMap { $0 })
+        XCTAssertEqual(strings.first, "5 ft, 6 in")
+    }
+    
+    func testBatchFormatter_Mass() {
+        NSLocale.setCurrentTest(Locale(identifier: "en_US"))
+        defer { NSLocale.setCurrentTest(nil) }
+        
+        let formatter = RSDMassFormatter()
+        formatter.isForInfantMassUse = true
+        formatter.unitStyle = .medium
+        formatter.toStringUnit = .ounces
+        
+        let values: [Double] = [86, 140]
+        let strings = values.withUnsafeBufferPointer { formatter.strings(fromValues: $0.baseAddress!, count: $0.count) }
+        XCTAssertEqual(strings, ["5 lb, 6 oz", "8 lb, 12 oz"])
+    }
+    
+    func testPerformance_BatchConvert() {
+        let values = (0..<100_000).map { Double($0) / 100.0 }
+        self.measure {
+            var converted = values
+            RSDUnitConverter.convert(&converted, from: UnitLength.centimeters, to: UnitLength.inches)
+        }
+    }
+    
+    func testPerformance_MeasurementConvert() {
+        let values = (0..<100_000).map { Double($0) / 100.0 }
+        self.measure {
+            _ = values.map { Measurement(value: $0, unit: UnitLength.centimeters).converted(to: .inches).value }
+        }
+    }
 }
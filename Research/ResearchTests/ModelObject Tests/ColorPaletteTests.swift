@@ -98,4 +98,52 @@ class ColorPaletteTests: XCTestCase {
         XCTAssertEqual(mapping.index, mapping0.index)
         XCTAssertEqual(mapping.normal, mapping0.normal)
     }
+    
+    func testFindColorKey_MatchesLinearSearch() {
+        let matrix = RSDColorMatrix.shared
+        var colorNames = Set<String>()
+        for library in matrix.registeredLibraries {
+            for swatch in library.swatches {
+                swatch.colorTiles.forEach {
+                    if let colorName = $0.colorName { colorNames.insert(colorName) }
+                }
+            }
+        }
+        XCTAssertFalse(colorNames.isEmpty)
+        colorNames.insert("not a color")
+        
+        for colorName in colorNames {
+            XCTAssertEqual(matrix.findColorKey(for: colorName), matrix._linearFindColorKey(for: colorName), colorName)
+        }
+    }
+    
+    func testFindColorTile_MatchesLinearSearch() {
+        let matrix = RSDColorMatrix.shared
+        var colors = RSDGrayScale().colorTiles.map { $0.color }
+        for library in matrix.registeredLibraries {
+            for swatch in library.swatches {
+                colors.append(contentsOf: swatch.colorTiles.map { $0.color })
+            }
+            if let grayScale = library.grayScale {
+                colors.append(contentsOf: grayScale.colorTiles.map { $0.color })
+            }
+        }
+        colors.append(RSDColor(red: 0.123, green: 0.456, blue: 0.789, alpha: 1))
+        
+        for color in colors {
+            XCTAssertEqual(matrix.findColorTile(for: color), matrix._linearFindColorTile(for: color))
+        }
+    }
+    
+    func testFindColorTile_Performance() {
+        let matrix = RSDColorMatrix.shared
+        let colors = matrix.registeredLibraries.flatMap { $0.swatches.flatMap { $0.colorTiles.map { $0.color } } }
+        measure {
+            for _ in 0..<100 {
+                for color in colors {
+                    _ = matrix.findColorTile(for: color)
+                }
+            }
+        }
+    }
 }
@@ -0,0 +1,131 @@
+//
+//  DecimationFilterTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class DecimationFilterTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+    }
+    
+    override func tearDown() {
+        super.tearDown()
+    }
+    
+    func testDecimationFilter_Coefficients() {
+        let filter = RSDDecimationFilter<Int>(factor: 4)
+        XCTAssertEqual(filter.coefficients.count, 81)
+        XCTAssertEqual(filter.delay, 40)
+        XCTAssertEqual(filter.coefficients.reduce(0, +), 1.0, accuracy: 0.000001)
+        for idx in 0..<filter.delay {
+            XCTAssertEqual(filter.coefficients[idx], filter.coefficients[80 - idx], accuracy: 0.000001)
+        }
+        
+        // An even number of taps is rounded up.
+        XCTAssertEqual(RSDDecimationFilter<Int>(factor: 2, tapCount: 10).coefficients.count, 11)
+        XCTAssertEqual(RSDDecimationFilter<Int>(factor: 1).coefficients, [1])
+    }
+    
+    func testDecimationFilter_Constant() {
+        let filter = RSDDecimationFilter<Int>(factor: 4)
+        var outputs = [(element: Int, vector: SIMD3<Double>)]()
+        for ii in 0..<200 {
+            if let output = filter.process(ii, x: 1, y: -2, z: 9.8) {
+                outputs.append(output)
+            }
+        }
+        
+        // The output is delayed by 40 samples and every 4th sample is kept.
+        XCTAssertEqual(outputs.map { $0.element }, Array(stride(from: 0, to: 160, by: 4)))
+        for output in outputs {
+            XCTAssertEqual(output.vector.x, 1, accuracy: 0.000001)
+            XCTAssertEqual(output.vector.y, -2, accuracy: 0.000001)
+            XCTAssertEqual(output.vector.z, 9.8, accuracy: 0.000001)
+        }
+    }
+    
+    func testDecimationFilter_Passband() {
+        // A 2 Hz signal sampled at 100 Hz should pass through the filter for a 25 Hz output.
+        let outputs = filterSine(frequency: 2, factor: 4, count: 400)
+        XCTAssertEqual(outputs.count, 90)
+        for output in outputs where output.element >= 40 {
+            let expected = sin(2 * Double.pi * 2 * Double(output.element) / 100)
+            XCTAssertEqual(output.vector.x, expected, accuracy: 0.002)
+            XCTAssertEqual(output.vector.y, 0, accuracy: 0.000001)
+            XCTAssertEqual(output.vector.z, -expected, accuracy: 0.002)
+        }
+    }
+    
+    func testDecimationFilter_Stopband() {
+        // A 40 Hz signal is above the 12.5 Hz Nyquist frequency of the output and should be removed.
+        let outputs = filterSine(frequency: 40, factor: 4, count: 400)
+        for output in outputs where output.element >= 40 {
+            XCTAssertEqual(output.vector.x, 0, accuracy: 0.001)
+        }
+        
+        // Without the filter, the samples alias to a 10 Hz signal.
+        let aliased = filterSine(frequency: 40, factor: 4, count: 400, tapCount: 1)
+        XCTAssertGreaterThan(aliased.map { abs($0.vector.x) }.max() ?? 0, 0.5)
+    }
+    
+    func testDecimationFilter_NoFilter() {
+        let outputs = filterSine(frequency: 2, factor: 2, count: 10, tapCount: 1)
+        XCTAssertEqual(outputs.map { $0.element }, [0, 2, 4, 6, 8])
+        for output in outputs {
+            XCTAssertEqual(output.vector.x, sin(2 * Double.pi * 2 * Double(output.element) / 100))
+        }
+    }
+    
+    func testDecimationFilter_Performance() {
+        self.measure {
+            let outputs = filterSine(frequency: 2, factor: 4, count: 100 * 60)
+            XCTAssertEqual(outputs.count, 1490)
+        }
+    }
+    
+    // helper methods
+    
+    func filterSine(frequency: Double, factor: Int, count: Int, tapCount: Int? = nil) -> [(element: Int, vector: SIMD3<Double>)] {
+        let filter = RSDDecimationFilter<Int>(factor: factor, tapCount: tapCount)
+        var outputs = [(element: Int, vector: SIMD3<Double>)]()
+        for ii in 0..<count {
+            let value = sin(2 * Double.pi * frequency * Double(ii) / 100)
+            if let output = filter.process(ii, x: value, y: 0, z: -value) {
+                outputs.append(output)
+            }
+        }
+        return outputs
+    }
+}
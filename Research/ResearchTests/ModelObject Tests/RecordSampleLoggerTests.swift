@@ -171,6 +171,65 @@ class RecordSampleLoggerTests: XCTestCase {
         }
     }
     
+    func testRecordSampleLogger_JSON_Compact() {
+        
+        do {
+            let url = try createTempFile("foo")
+            let recorder = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: true, jsonOutputFormat: .compact)
+            XCTAssertEqual(recorder.contentType, "application/json")
+            try recorder.writeSample(RSDRecordMarker(uptime: 0.0, timestamp: 0.0, date: Date(), stepPath: "Task/step1"))
+            try recorder.writeSamples([
+                TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "booRa", x: 1.2, y: 3.4, z: 5.6),
+                TestRecord(uptime: 0.1, stepPath: "Task/step1", label: "barRa", x: 1.3, y: 3.5, z: 5.7)
+                ])
+            XCTAssertEqual(recorder.sampleCount, 3)
+            try recorder.close()
+            
+            let data = try Data(contentsOf: recorder.url)
+            let decoder = RSDFactory.shared.createJSONDecoder()
+            let recordCollection = try decoder.decode(TestRecordCollection.self, from: data)
+            XCTAssertEqual(recordCollection.items.count, 3)
+            XCTAssertEqual(recordCollection.items.last?.label, "barRa")
+            
+            // Each sample should be written on a single line.
+            let lines = String(data: data, encoding: .utf8)!.components(separatedBy: "\n")
+            XCTAssertEqual(lines.count, 7, "\(lines)")
+            XCTAssertTrue(lines[3].hasPrefix("{"))
+            XCTAssertTrue(lines[3].hasSuffix("},"))
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_JSON_NewlineDelimited() {
+        
+        do {
+            let url = try createTempFile("foo")
+            let recorder = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: true, jsonOutputFormat: .newlineDelimited)
+            XCTAssertEqual(recorder.contentType, "application/x-ndjson")
+            try recorder.writeSample(RSDRecordMarker(uptime: 0.0, timestamp: 0.0, date: Date(), stepPath: "Task/step1"))
+            try recorder.writeSamples([
+                TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "booRa", x: 1.2, y: 3.4, z: 5.6),
+                TestRecord(uptime: 0.1, stepPath: "Task/step1", label: "barRa", x: 1.3, y: 3.5, z: 5.7)
+                ])
+            try recorder.close()
+            
+            let data = try Data(contentsOf: recorder.url)
+            let lines = String(data: data, encoding: .utf8)!.components(separatedBy: "\n")
+            XCTAssertEqual(lines.count, 3, "\(lines)")
+            
+            let decoder = RSDFactory.shared.createJSONDecoder()
+            let records = try lines.map { try decoder.decode(TestRecord.self, from: $0.data(using: .utf8)!) }
+            XCTAssertEqual(records[0].uptime, 0.0)
+            XCTAssertEqual(records[1].label, "booRa")
+            XCTAssertEqual(records[2].x, 1.3)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
     func testRecordSampleLogger_CSV() {
         
         do {
@@ -195,8 +254,7 @@ class RecordSampleLoggerTests: XCTestCase {
                 XCTFail("Failed to build CSV string from data")
                 return
             }
-            print(string)
-
+            
             let items = string.components(separatedBy: "\n")
             
             let expectedCount = 6
@@ -259,8 +317,527 @@ class RecordSampleLoggerTests: XCTestCase {
     }
     
     
+    func testDataLogger_FlushPolicy() {
+        
+        do {
+            let url = try createTempFile("foo")
+            let initialData = "abc".data(using: .utf8)!
+            let logger = try RSDDataLogger(identifier: "foo", url: url, initialData: initialData, flushPolicy: .init(maxBufferSize: 10))
+            XCTAssertEqual(logger.bytesWritten, 3)
+            
+            try logger.write("12345".data(using: .utf8)!)
+            XCTAssertEqual(logger.bufferedByteCount, 5)
+            XCTAssertEqual(logger.flushCount, 0)
+            XCTAssertEqual(logger.bytesWritten, 3)
+            
+            try logger.write("67890".data(using: .utf8)!)
+            XCTAssertEqual(logger.bufferedByteCount, 0)
+            XCTAssertEqual(logger.flushCount, 1)
+            XCTAssertEqual(logger.bytesWritten, 13)
+            
+            try logger.write("xyz".data(using: .utf8)!)
+            XCTAssertEqual(logger.bufferedByteCount, 3)
+            try logger.close()
+            XCTAssertEqual(logger.bufferedByteCount, 0)
+            XCTAssertEqual(logger.flushCount, 2)
+            XCTAssertEqual(logger.bytesWritten, 16)
+            XCTAssertEqual(logger.sampleCount, 3)
+            
+            let string = String(data: try Data(contentsOf: url), encoding: .utf8)
+            XCTAssertEqual(string, "abc1234567890xyz")
+            
+        } catch let err {
+            XCTFail("Error writing data: \(err)")
+        }
+    }
+    
+    func testDataLogger_FlushIfNeeded() {
+        
+        do {
+            let url = try createTempFile("foo")
+            let logger = try RSDDataLogger(identifier: "foo", url: url, initialData: nil, flushPolicy: .init(maxBufferSize: 1024, flushInterval: 0.05))
+            try logger.write("123".data(using: .utf8)!)
+            try logger.flushIfNeeded()
+            XCTAssertEqual(logger.bufferedByteCount, 3)
+            XCTAssertEqual(logger.flushCount, 0)
+            
+            // The data is flushed once the interval has elapsed even though nothing more was written.
+            Thread.sleep(forTimeInterval: 0.1)
+            try logger.flushIfNeeded()
+            XCTAssertEqual(logger.bufferedByteCount, 0)
+            XCTAssertEqual(logger.flushCount, 1)
+            XCTAssertEqual(logger.bytesWritten, 3)
+            try logger.close()
+            
+        } catch let err {
+            XCTFail("Error writing data: \(err)")
+        }
+    }
+    
+    func testDataLogger_WriteThrough() {
+        
+        do {
+            let url = try createTempFile("foo")
+            let logger = try RSDDataLogger(identifier: "foo", url: url, initialData: nil, flushPolicy: .writeThrough)
+            try logger.write("123".data(using: .utf8)!)
+            try logger.write("456".data(using: .utf8)!)
+            XCTAssertEqual(logger.bufferedByteCount, 0)
+            XCTAssertEqual(logger.flushCount, 2)
+            XCTAssertEqual(logger.bytesWritten, 6)
+            try logger.close()
+            
+            let string = String(data: try Data(contentsOf: url), encoding: .utf8)
+            XCTAssertEqual(string, "123456")
+            
+        } catch let err {
+            XCTFail("Error writing data: \(err)")
+        }
+    }
+    
+    func testDelimiterSeparatedEncoder_MatchesJSONRoundTrip() {
+        let samples: [RSDSampleRecord] = [
+            RSDRecordMarker(uptime: 0.0, timestamp: 0.0, date: Date(), stepPath: "Task/step1"),
+            TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "booRa", x: 1.2, y: 3.4, z: 5.6),
+            TestRecord(uptime: 12345.678901234567, stepPath: "Task/step1", label: nil, x: -0.1324615478515625, y: 1e-7, z: -3),
+            TestRecord(uptime: 0.2, stepPath: "Task/step2", label: "gooRa", x: .nan, y: .infinity, z: nil),
+            ]
+        let keys = TestRecord.codingKeys()
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: keys, delimiter: ",")
+        do {
+            for sample in samples {
+                let expected = try legacyDelimiterEncodedString(sample, codingKeys: keys, delimiter: ",")
+                let actual = try encoder.encodeString(sample)
+                XCTAssertEqual(actual, expected)
+                
+                var data = Data()
+                try encoder.encode(sample, appendingTo: &data)
+                XCTAssertEqual(String(data: data, encoding: .utf8), expected)
+            }
+        } catch let err {
+            XCTFail("Error encoding samples: \(err)")
+        }
+    }
+    
+    func testDelimiterSeparatedEncoder_StringContainsDelimiter() {
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: TestRecord.codingKeys(), delimiter: ",")
+        let sample = TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "boo,Ra", x: 1.2, y: 3.4, z: 5.6)
+        XCTAssertThrowsError(try encoder.encodeString(sample))
+        
+        // The encoder should recover from the error for the next row.
+        let next = TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "booRa", x: 1.2, y: 3.4, z: 5.6)
+        XCTAssertEqual(try? encoder.encodeString(next), "0.01,Task/step1,1.2,3.4,5.6,booRa")
+    }
+    
+    func testDelimiterSeparatedEncoder_NestedContainer() {
+        struct NestedRecord : Encodable {
+            let uptime: TimeInterval
+            let x: [Double]
+        }
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: TestRecord.codingKeys(), delimiter: ",")
+        XCTAssertThrowsError(try encoder.encodeString(NestedRecord(uptime: 0, x: [1, 2])))
+        XCTAssertThrowsError(try encoder.encodeString([1, 2, 3]))
+    }
+    
+    func testDelimiterSeparatedEncoder_Performance() {
+        let samples = (0..<10000).map {
+            TestRecord(uptime: Double($0) * 0.01, stepPath: "Task/step1", label: "booRa", x: 0.064788818359375, y: -0.1324615478515625, z: -0.9501953125)
+        }
+        let encoder = RSDDelimiterSeparatedEncoder(codingKeys: TestRecord.codingKeys(), delimiter: ",")
+        var data = Data()
+        self.measure {
+            data.removeAll(keepingCapacity: true)
+            for sample in samples {
+                try! encoder.encode(sample, appendingTo: &data)
+                data.append(0x0A)
+            }
+        }
+    }
+    
+    func testDelimiterSeparatedEncoder_LegacyPerformance() {
+        let samples = (0..<10000).map {
+            TestRecord(uptime: Double($0) * 0.01, stepPath: "Task/step1", label: "booRa", x: 0.064788818359375, y: -0.1324615478515625, z: -0.9501953125)
+        }
+        let keys = TestRecord.codingKeys()
+        var data = Data()
+        self.measure {
+            data.removeAll(keepingCapacity: true)
+            for sample in samples {
+                let string = try! legacyDelimiterEncodedString(sample, codingKeys: keys, delimiter: ",")
+                data.append("\(string)\n".data(using: .utf8)!)
+            }
+        }
+    }
+    
+    func testRecordSampleLogger_Columnar_MatchesJSON() {
+        let format = RSDColumnarSampleFormat(columns: [
+            .init("uptime", .double),
+            .init("stepPath", .string),
+            .init("timestampDate", .string),
+            .init("timestamp", .double),
+            .init("x", .double),
+            .init("y", .double),
+            .init("z", .double),
+            .init("label", .string)
+            ])
+        do {
+            let samples = columnarTestSamples()
+            let jsonURL = try createTempFile("foo")
+            let jsonLogger = try RSDRecordSampleLogger(identifier: "foo", url: jsonURL, usesRootDictionary: false)
+            try jsonLogger.writeSamples(samples)
+            try jsonLogger.close()
+            
+            let binaryURL = try createTempFile("foo")
+            var columnarFormat = format
+            columnarFormat.rowsPerBlock = 2
+            let binaryLogger = try RSDRecordSampleLogger(identifier: "foo", url: binaryURL, usesRootDictionary: false, columnarFormat: columnarFormat)
+            XCTAssertEqual(binaryLogger.contentType, "application/octet-stream")
+            try binaryLogger.writeSamples(samples)
+            try binaryLogger.close()
+            XCTAssertEqual(binaryLogger.sampleCount, samples.count)
+            
+            let reader = try RSDColumnarSampleReader(contentsOf: binaryLogger.url)
+            XCTAssertEqual(reader.format, format)
+            XCTAssertFalse(reader.isTruncated)
+            XCTAssertEqual(reader.rows.count, samples.count)
+            XCTAssertEqual(reader.rows.first?.stepPath, "Task/step1")
+            XCTAssertEqual(reader.rows.first?.timestamp, 0.0)
+            XCTAssertEqual(reader.rows.first?["timestampDate"], .string(RSDFactory.shared.encodeString(from: samples[0].timestampDate!, codingPath: [])))
+            XCTAssertEqual(reader.rows[1]["label"], .string("booRa"))
+            XCTAssertNil(reader.rows[2]["label"])
+            
+            let exportURL = try createTempFile("bar")
+            try reader.export(to: exportURL)
+            
+            let expected = try JSONSerialization.jsonObject(with: Data(contentsOf: jsonLogger.url), options: []) as? NSArray
+            let actual = try JSONSerialization.jsonObject(with: Data(contentsOf: exportURL), options: []) as? NSArray
+            XCTAssertNotNil(actual)
+            XCTAssertEqual(actual, expected)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_Columnar_MatchesCSV() {
+        let format = RSDColumnarSampleFormat(columns: [
+            .init("uptime", .double),
+            .init("stepPath", .string),
+            .init("x", .double),
+            .init("y", .double),
+            .init("z", .double),
+            .init("label", .string)
+            ])
+        do {
+            let samples = columnarTestSamples()
+            let csvURL = try createTempFile("foo")
+            let csvLogger = try RSDRecordSampleLogger(identifier: "foo", url: csvURL, usesRootDictionary: false, stringEncodingFormat: CSVEncodingFormat<TestRecord>())
+            try csvLogger.writeSamples(samples)
+            try csvLogger.close()
+            
+            let binaryURL = try createTempFile("foo")
+            let binaryLogger = try RSDRecordSampleLogger(identifier: "foo", url: binaryURL, usesRootDictionary: false, columnarFormat: format)
+            try binaryLogger.writeSamples(samples)
+            try binaryLogger.close()
+            
+            let exportURL = try createTempFile("bar").deletingPathExtension().appendingPathExtension("csv")
+            try RSDColumnarSampleReader.export(contentsOf: binaryLogger.url, to: exportURL)
+            
+            let expected = try String(contentsOf: csvLogger.url, encoding: .utf8)
+            let actual = try String(contentsOf: exportURL, encoding: .utf8)
+            XCTAssertEqual(actual, expected)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_Columnar_FileSize() {
+        let format = RSDColumnarSampleFormat(columns: [
+            .init("uptime", .double),
+            .init("stepPath", .string),
+            .init("x", .double),
+            .init("y", .double),
+            .init("z", .double),
+            .init("label", .string)
+            ])
+        do {
+            let samples: [RSDSampleRecord] = (0..<2000).map {
+                let t = Double($0) / 100.0
+                return TestRecord(uptime: t, stepPath: "Task/step1", label: nil, x: sin(t), y: cos(t), z: -0.9501953125)
+            }
+            let jsonURL = try createTempFile("foo")
+            let jsonLogger = try RSDRecordSampleLogger(identifier: "foo", url: jsonURL, usesRootDictionary: false, jsonOutputFormat: .compact)
+            try jsonLogger.writeSamples(samples)
+            try jsonLogger.close()
+            
+            let csvURL = try createTempFile("foo")
+            let csvLogger = try RSDRecordSampleLogger(identifier: "foo", url: csvURL, usesRootDictionary: false, stringEncodingFormat: CSVEncodingFormat<TestRecord>())
+            try csvLogger.writeSamples(samples)
+            try csvLogger.close()
+            
+            let binaryURL = try createTempFile("foo")
+            let binaryLogger = try RSDRecordSampleLogger(identifier: "foo", url: binaryURL, usesRootDictionary: false, columnarFormat: format)
+            try binaryLogger.writeSamples(samples)
+            try binaryLogger.close()
+            
+            XCTAssertLessThan(binaryLogger.bytesWritten, jsonLogger.bytesWritten)
+            XCTAssertLessThan(binaryLogger.bytesWritten, csvLogger.bytesWritten)
+            
+            let reader = try RSDColumnarSampleReader(contentsOf: binaryLogger.url)
+            XCTAssertEqual(reader.rows.count, samples.count)
+            XCTAssertEqual(reader.rows.last?["x"], .double(sin(19.99)))
+            XCTAssertNil(reader.rows.last?["label"])
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testColumnarSampleReader_Truncated() {
+        var format = RSDColumnarSampleFormat(columns: [
+            .init("uptime", .double),
+            .init("stepPath", .string)
+            ])
+        format.rowsPerBlock = 2
+        do {
+            let url = try createTempFile("foo")
+            let logger = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: false, columnarFormat: format)
+            try logger.writeSamples(columnarTestSamples())
+            try logger.close()
+            
+            // Drop the last byte to simulate a file that was not closed.
+            let data = try Data(contentsOf: logger.url)
+            let reader = try RSDColumnarSampleReader(data: data.dropLast())
+            XCTAssertTrue(reader.isTruncated)
+            XCTAssertEqual(reader.rows.count, 4)
+            
+            XCTAssertThrowsError(try RSDColumnarSampleReader(data: Data("[\n]".utf8)))
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testGzipEncoder_RoundTrip() {
+        do {
+            let expected = Data("123456789".utf8)
+            let encoder = try RSDGzipEncoder()
+            let data = try encoder.encode(expected.prefix(5)) + encoder.encode(expected.suffix(4)) + encoder.finish()
+            XCTAssertTrue(encoder.isFinished)
+            XCTAssertEqual(encoder.uncompressedByteCount, UInt64(expected.count))
+            XCTAssertEqual(Array(data.prefix(3)), [0x1f, 0x8b, 0x08])
+            XCTAssertEqual(gunzip(data), expected)
+            
+            // The decoder should fail if the trailer is missing.
+            XCTAssertNil(gunzip(data.dropLast(8)))
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding data: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_Gzip() {
+        
+        do {
+            let samples = (0..<500).map {
+                TestRecord(uptime: Double($0) / 100.0, stepPath: "Task/step1", label: "booRa", x: sin(Double($0)), y: 3.4, z: 5.6)
+            }
+            
+            let url = try createTempFile("foo")
+            let logger = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: false, jsonOutputFormat: .compact)
+            try logger.writeSamples(samples)
+            try logger.close()
+            let expected = try Data(contentsOf: logger.url)
+            
+            // Use a small buffer so that the data is compressed in several chunks.
+            let gzipURL = try createTempFile("foo").appendingPathExtension("gz")
+            let gzipLogger = try RSDRecordSampleLogger(identifier: "foo", url: gzipURL, usesRootDictionary: false, jsonOutputFormat: .compact, contentEncoding: .gzip, flushPolicy: .init(maxBufferSize: 1024))
+            XCTAssertEqual(gzipLogger.contentType, "application/json")
+            XCTAssertEqual(gzipLogger.contentEncoding, .gzip)
+            try gzipLogger.writeSamples(samples)
+            try gzipLogger.close()
+            XCTAssertGreaterThan(gzipLogger.flushCount, 1)
+            XCTAssertEqual(gzipLogger.uncompressedBytesWritten, UInt64(expected.count))
+            
+            let data = try Data(contentsOf: gzipLogger.url)
+            XCTAssertEqual(UInt64(data.count), gzipLogger.bytesWritten)
+            XCTAssertLessThan(data.count, expected.count)
+            
+            guard let decoded = gunzip(data) else {
+                XCTFail("Failed to decompress the file")
+                return
+            }
+            XCTAssertEqual(decoded, expected)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testDataLogger_SegmentURL() {
+        let url = URL(fileURLWithPath: "/tmp/abc/motion.json")
+        XCTAssertEqual(RSDDataLogger.segmentURL(for: url, index: 0), url)
+        XCTAssertEqual(RSDDataLogger.segmentURL(for: url, index: 2).lastPathComponent, "motion-2.json")
+        XCTAssertEqual(RSDDataLogger.segmentURL(for: url.appendingPathExtension("gz"), index: 1).lastPathComponent, "motion-1.json.gz")
+        XCTAssertEqual(RSDDataLogger.segmentURL(for: url.deletingPathExtension(), index: 3).lastPathComponent, "motion-3")
+    }
+    
+    func testRecordSampleLogger_Rotation_JSON() {
+        
+        do {
+            let samples = (0..<50).map {
+                TestRecord(uptime: Double($0) / 100.0, stepPath: "Task/step1", label: "booRa", x: sin(Double($0)), y: 3.4, z: 5.6)
+            }
+            
+            let url = try createTempFile("foo")
+            let logger = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: true, jsonOutputFormat: .compact)
+            logger.rotationPolicy = .init(maxSegmentSize: 1000)
+            var handledSegments = [RSDDataLogger.Segment]()
+            logger.segmentHandler = { (_, segment) in
+                handledSegments.append(segment)
+            }
+            try logger.writeSamples(samples)
+            try logger.close()
+            
+            XCTAssertGreaterThan(logger.closedSegments.count, 1)
+            XCTAssertEqual(handledSegments, logger.closedSegments)
+            XCTAssertEqual(logger.segmentIndex, logger.closedSegments.count)
+            XCTAssertEqual(logger.sampleCount, samples.count)
+            
+            // Each segment should be a complete file.
+            let urls = logger.closedSegments.map { $0.url } + [logger.url]
+            XCTAssertEqual(Set(urls).count, urls.count)
+            let decoder = RSDFactory.shared.createJSONDecoder()
+            var decodedCount = 0
+            for (idx, segmentURL) in urls.enumerated() {
+                let collection = try decoder.decode(TestRecordCollection.self, from: Data(contentsOf: segmentURL))
+                if idx < logger.closedSegments.count {
+                    XCTAssertEqual(collection.items.count, logger.closedSegments[idx].sampleCount)
+                    XCTAssertEqual(logger.closedSegments[idx].index, idx)
+                }
+                else {
+                    XCTAssertEqual(collection.items.count, logger.segmentSampleCount)
+                }
+                XCTAssertEqual(collection.items.first?.uptime, samples[decodedCount].uptime)
+                decodedCount += collection.items.count
+            }
+            XCTAssertEqual(decodedCount, samples.count)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_Rotation_CSV() {
+        
+        do {
+            let samples = (0..<50).map {
+                TestRecord(uptime: Double($0) / 100.0, stepPath: "Task/step1", label: "booRa", x: sin(Double($0)), y: 3.4, z: 5.6)
+            }
+            
+            let url = try createTempFile("foo")
+            let logger = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: false, stringEncodingFormat: CSVEncodingFormat<TestRecord>())
+            logger.rotationPolicy = .init(maxSegmentSize: 500)
+            try logger.writeSamples(samples)
+            try logger.close()
+            
+            XCTAssertGreaterThan(logger.closedSegments.count, 1)
+            
+            let urls = logger.closedSegments.map { $0.url } + [logger.url]
+            var rows = [String]()
+            for segmentURL in urls {
+                let lines = try String(contentsOf: segmentURL, encoding: .utf8).components(separatedBy: "\n")
+                XCTAssertEqual(lines.first, "uptime,stepPath,x,y,z,label")
+                rows.append(contentsOf: lines.dropFirst())
+            }
+            XCTAssertEqual(rows.count, samples.count)
+            XCTAssertEqual(rows.last?.hasPrefix("0.49,Task/step1,"), true)
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func testRecordSampleLogger_Rotation_Columnar() {
+        var format = RSDColumnarSampleFormat(columns: [
+            .init("uptime", .double),
+            .init("stepPath", .string),
+            .init("label", .string)
+            ])
+        format.rowsPerBlock = 4
+        do {
+            let samples = (0..<50).map {
+                TestRecord(uptime: Double($0) / 100.0, stepPath: "Task/step\($0 / 10)", label: nil, x: nil, y: nil, z: nil)
+            }
+            
+            let url = try createTempFile("foo")
+            let logger = try RSDRecordSampleLogger(identifier: "foo", url: url, usesRootDictionary: false, columnarFormat: format)
+            logger.rotationPolicy = .init(maxSegmentSize: 300)
+            try logger.writeSamples(samples)
+            try logger.close()
+            
+            XCTAssertGreaterThan(logger.closedSegments.count, 1)
+            XCTAssertEqual(logger.sampleCount, samples.count)
+            
+            // Each segment should include its own header and string table.
+            let urls = logger.closedSegments.map { $0.url } + [logger.url]
+            var uptimes = [RSDColumnarSampleReader.Value?]()
+            for segmentURL in urls {
+                let reader = try RSDColumnarSampleReader(contentsOf: segmentURL)
+                XCTAssertFalse(reader.isTruncated)
+                XCTAssertEqual(reader.rows.last?.stepPath, "Task/step\((uptimes.count + reader.rows.count - 1) / 10)")
+                uptimes.append(contentsOf: reader.rows.map { $0["uptime"] })
+            }
+            XCTAssertEqual(uptimes, samples.map { .double($0.uptime) })
+            
+        } catch let err {
+            XCTFail("Error encoding/decoding samples: \(err)")
+        }
+    }
+    
+    func columnarTestSamples() -> [RSDSampleRecord] {
+        return [
+            RSDRecordMarker(uptime: 0.0, timestamp: 0.0, date: Date(), stepPath: "Task/step1"),
+            TestRecord(uptime: 0.01, stepPath: "Task/step1", label: "booRa", x: 1.2, y: 3.4, z: 5.6),
+            TestRecord(uptime: 0.1, stepPath: "Task/step1", label: nil, x: -0.1324615478515625, y: 1e-7, z: -3),
+            RSDRecordMarker(uptime: 0.15, timestamp: 0.15, date: Date(), stepPath: "Task/step2"),
+            TestRecord(uptime: 0.2, stepPath: "Task/step2", label: "gooRa", x: 1.4, y: 3.6, z: 5.8)
+        ]
+    }
+    
     // helper methods
     
+    /// The original implementation of the delimiter-encoded string that encodes the object to JSON and
+    /// then deserializes the JSON into a dictionary.
+    func legacyDelimiterEncodedString(_ value: Encodable, codingKeys: [CodingKey], delimiter: String) throws -> String {
+        let dictionary = try value.rsd_jsonEncodedDictionary()
+        let values: [String] = try codingKeys.map { (key) -> String in
+            guard let value = dictionary[key.stringValue] else { return "" }
+            if ((value is [Any]) || (value is [String : Any])) {
+                let context = EncodingError.Context(codingPath: [], debugDescription: "A comma-delimited string encoding cannot encode a nested array or dictionary.")
+                throw EncodingError.invalidValue(value, context)
+            }
+            let string = "\(value)"
+            if string.contains(delimiter) {
+                let context = EncodingError.Context(codingPath: [], debugDescription: "A delimited string encoding cannot encode a string that contains the delimiter: '\(delimiter)'.")
+                throw EncodingError.invalidValue(string, context)
+            }
+            return string
+        }
+        return values.joined(separator: delimiter)
+    }
+    
+    /// Decompress a gzip file. The CRC-32 and size in the trailer are checked by libz.
+    func gunzip(_ data: Data) -> Data? {
+        let output = NSMutableData()
+        guard let stream = try? RSDZlibStream(direction: .gzipDecode),
+            (try? stream.process(data, finish: true, output: output)) != nil
+            else {
+                return nil
+        }
+        return output as Data
+    }
+    
     func createTempFile(_ identifier: String) throws -> URL {
         let tempDir = NSTemporaryDirectory()
         let dir = UUID().uuidString
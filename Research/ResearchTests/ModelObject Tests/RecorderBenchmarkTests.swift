@@ -0,0 +1,611 @@
+//
+//  RecorderBenchmarkTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+import Darwin
+@testable import Research
+
+/// A synthetic sample record used to benchmark the recording pipeline. The `uptime` is set to the
+/// system uptime when the sample is enqueued and is used to calculate the latency.
+protocol SyntheticSampleRecord : RSDSampleRecord, RSDDelimiterSeparatedEncodable {
+    var uptime: TimeInterval? { get }
+    init(uptime: TimeInterval, stream: Int, sequence: Int)
+}
+
+/// A synthetic record with the same schema as `RSDMotionRecord`.
+struct SyntheticMotionRecord : SyntheticSampleRecord {
+    let uptime: TimeInterval?
+    let timestamp: TimeInterval?
+    let stepPath: String
+    let timestampDate: Date?
+    let sensorType: String?
+    let eventAccuracy: Int?
+    let referenceCoordinate: String?
+    let heading: Double?
+    let x: Double?
+    let y: Double?
+    let z: Double?
+    let w: Double?
+    
+    private enum CodingKeys : String, CodingKey, CaseIterable {
+        case uptime, timestamp, stepPath, timestampDate, sensorType, eventAccuracy, referenceCoordinate, heading, x, y, z, w
+    }
+    
+    static func codingKeys() -> [CodingKey] {
+        return CodingKeys.allCases
+    }
+    
+    init(uptime: TimeInterval, stream: Int, sequence: Int) {
+        let t = Double(sequence) * 0.01
+        self.uptime = uptime
+        self.timestamp = t
+        self.stepPath = "Benchmark/step\(stream)"
+        self.timestampDate = nil
+        self.sensorType = (stream % 2 == 0) ? "userAcceleration" : "attitude"
+        self.eventAccuracy = nil
+        self.referenceCoordinate = (stream % 2 == 0) ? nil : "Z-Up"
+        self.heading = nil
+        self.x = sin(t)
+        self.y = cos(t)
+        self.z = sin(t + Double(stream))
+        self.w = (stream % 2 == 0) ? nil : cos(t + Double(stream))
+    }
+}
+
+/// A synthetic record with the same schema as `RSDDistanceRecord`.
+struct SyntheticDistanceRecord : SyntheticSampleRecord {
+    let uptime: TimeInterval?
+    let timestamp: TimeInterval?
+    let stepPath: String
+    let timestampDate: Date?
+    let timestampUnix: TimeInterval?
+    let horizontalAccuracy: Double?
+    let relativeDistance: Double?
+    let latitude: Double?
+    let longitude: Double?
+    let verticalAccuracy: Double?
+    let altitude: Double?
+    let totalDistance: Double?
+    let course: Double?
+    let bearingRadians: Double?
+    let speed: Double?
+    let floor: Int?
+    
+    private enum CodingKeys : String, CodingKey, CaseIterable {
+        case uptime, timestamp, stepPath, timestampDate, timestampUnix, horizontalAccuracy, relativeDistance, latitude, longitude, verticalAccuracy, altitude, totalDistance, course, bearingRadians, speed, floor
+    }
+    
+    static func codingKeys() -> [CodingKey] {
+        return CodingKeys.allCases
+    }
+    
+    init(uptime: TimeInterval, stream: Int, sequence: Int) {
+        let t = Double(sequence)
+        self.uptime = uptime
+        self.timestamp = t
+        self.stepPath = "Benchmark/step\(stream)"
+        self.timestampDate = Date()
+        self.timestampUnix = Date().timeIntervalSince1970
+        self.horizontalAccuracy = 5.0
+        self.relativeDistance = 1.25
+        self.latitude = nil
+        self.longitude = nil
+        self.verticalAccuracy = 3.0
+        self.altitude = 21.5 + sin(t)
+        self.totalDistance = t * 1.25
+        self.course = 76.2
+        self.bearingRadians = 0.5
+        self.speed = 1.4
+        self.floor = 1
+    }
+}
+
+/// `BenchmarkSampleLogger` records the latency of each synthetic sample from when it is produced until
+/// the data for the sample has been flushed to the file and synchronized to disk.
+///
+/// - note: The logger is only accessed on the recorder's `loggerQueue`.
+class BenchmarkSampleLogger : RSDRecordSampleLogger {
+    
+    /// The uptime for each sample that has been written but not yet flushed.
+    private var pendingUptimes = [TimeInterval]()
+    
+    /// The latency for each sample that has been flushed.
+    private(set) var latencies = [TimeInterval]()
+    
+    override func writeSample(_ sample: RSDSampleRecord) throws {
+        if let uptime = (sample as? SyntheticSampleRecord)?.uptime {
+            pendingUptimes.append(uptime)
+        }
+        try super.writeSample(sample)
+    }
+    
+    override func flush() throws {
+        let count = bufferedByteCount
+        try super.flush()
+        guard count > 0, pendingUptimes.count > 0 else { return }
+        
+        // `fsync()` applies to the file rather than the descriptor, so a separate descriptor can be
+        // used to wait for the flushed data to reach the disk.
+        let fd = Darwin.open(url.path, O_RDONLY)
+        if fd >= 0 {
+            fsync(fd)
+            Darwin.close(fd)
+        }
+        let now = ProcessInfo.processInfo.systemUptime
+        for uptime in pendingUptimes {
+            latencies.append(now - uptime)
+        }
+        pendingUptimes.removeAll(keepingCapacity: true)
+    }
+}
+
+/// `BenchmarkSampleRecorder` writes each synthetic sensor stream to its own logger. Each stream has a
+/// single producer queue so that the recorder's `ingestionPolicy` can be used.
+class BenchmarkSampleRecorder : RSDSampleRecorder {
+    
+    let streamCount: Int
+    let format: RSDStringSeparatedEncodingFormat?
+    
+    /// The loggers created by the recorder. This should only be accessed on the `loggerQueue` or after
+    /// the recorder has stopped.
+    private(set) var benchmarkLoggers = [BenchmarkSampleLogger]()
+    
+    init(streamCount: Int, format: RSDStringSeparatedEncodingFormat?, outputDirectory: URL) {
+        self.streamCount = streamCount
+        self.format = format
+        let navigator = RSDConditionalStepNavigatorObject(with: [])
+        let task = RSDTaskObject(identifier: "benchmark", stepNavigator: navigator)
+        let config = RSDStandardAsyncActionConfiguration(identifier: "benchmark", type: "benchmark", startStepIdentifier: nil, stopStepIdentifier: nil)
+        super.init(configuration: config, taskViewModel: RSDTaskViewModel(task: task), outputDirectory: outputDirectory)
+    }
+    
+    static func loggerIdentifier(for stream: Int) -> String {
+        return "stream\(stream)"
+    }
+    
+    override var loggerIdentifiers: Set<String> {
+        return Set((0..<streamCount).map { BenchmarkSampleRecorder.loggerIdentifier(for: $0) })
+    }
+    
+    override var defaultLoggerIdentifier: String {
+        return BenchmarkSampleRecorder.loggerIdentifier(for: 0)
+    }
+    
+    override func instantiateLogger(with identifier: String) throws -> RSDDataLogger? {
+        let url = try RSDFileResultUtility.createFileURL(identifier: identifier, ext: format?.fileExtension ?? "json", outputDirectory: outputDirectory)
+        let logger = try BenchmarkSampleLogger(identifier: identifier, url: url, usesRootDictionary: false, stringEncodingFormat: format)
+        benchmarkLoggers.append(logger)
+        return logger
+    }
+}
+
+/// `RecorderBenchmark` drives a `RSDSampleRecorder` with synthetic sensor streams without requiring
+/// CoreMotion or CoreLocation. Each stream is a separate producer queue that creates samples either at
+/// a fixed frequency or as fast as possible.
+///
+/// - note: The benchmark must be run on the main thread. The recorder updates its status on the main
+///         queue, so the main run loop is run while waiting for the recorder to start and stop.
+struct RecorderBenchmark {
+    
+    enum Schema : String, Codable {
+        case motion, distance
+    }
+    
+    enum Format : String, Codable {
+        case json, csv
+    }
+    
+    enum Ingestion : String, Codable {
+        /// Dispatch a block to the logger queue for each sample (the default recorder behavior).
+        case dispatch
+        /// Use the recorder's `ingestionPolicy` to add each sample to a ring buffer that is drained
+        /// in batches.
+        case ringBuffer
+    }
+    
+    struct Configuration : Codable {
+        var schema: Schema
+        var format: Format
+        var ingestion: Ingestion
+        
+        /// The sampling frequency (Hz) of each stream. If `0`, then the samples are produced as fast
+        /// as possible to measure sustained throughput.
+        var frequency: Double
+        
+        /// The number of concurrent streams.
+        var streamCount: Int
+        
+        /// The number of samples produced by each stream.
+        var samplesPerStream: Int
+    }
+    
+    struct Result : Codable {
+        let configuration: Configuration
+        let samplesProduced: Int
+        let samplesWritten: Int
+        let samplesDropped: Int
+        let elapsedTime: TimeInterval
+        let samplesPerSecond: Double
+        
+        /// The latency from when a sample is produced until it has been flushed and synchronized to
+        /// the file.
+        let latencyP50: TimeInterval
+        let latencyP99: TimeInterval
+        
+        let bytesWritten: UInt64
+        let peakResidentBytes: UInt64
+    }
+    
+    let configuration: Configuration
+    
+    /// The interval used to drain the ring buffers.
+    let drainInterval: TimeInterval = 0.05
+    
+    func run() throws -> Result {
+        switch configuration.schema {
+        case .motion:
+            return try run(SyntheticMotionRecord.self)
+        case .distance:
+            return try run(SyntheticDistanceRecord.self)
+        }
+    }
+    
+    private func run<Record : SyntheticSampleRecord>(_ recordType: Record.Type) throws -> Result {
+        let config = self.configuration
+        let format: RSDStringSeparatedEncodingFormat? = (config.format == .csv) ? CSVEncodingFormat<Record>() : nil
+        let outputDirectory = try RecorderBenchmark.createTempDirectory()
+        defer {
+            try? FileManager.default.removeItem(at: outputDirectory)
+        }
+        let recorder = BenchmarkSampleRecorder(streamCount: config.streamCount, format: format, outputDirectory: outputDirectory)
+        if config.ingestion == .ringBuffer {
+            recorder.ingestionPolicy = RSDSampleRecorder.IngestionPolicy(bufferCapacity: 1024, drainInterval: drainInterval)
+        }
+        
+        let start = ProcessInfo.processInfo.systemUptime
+        var startError: Error?
+        try RecorderBenchmark.runMainLoop { done in
+            recorder.start { (_, _, error) in
+                startError = error
+                done()
+            }
+        }
+        if let error = startError {
+            throw error
+        }
+        
+        let group = DispatchGroup()
+        var timers = [DispatchSourceTimer]()
+        for stream in 0..<config.streamCount {
+            let producerQueue = DispatchQueue(label: "org.sagebase.ResearchTests.benchmark.stream\(stream)")
+            let loggerIdentifier = BenchmarkSampleRecorder.loggerIdentifier(for: stream)
+            func produce(sequence: Int) {
+                let sample = Record(uptime: ProcessInfo.processInfo.systemUptime, stream: stream, sequence: sequence)
+                recorder.writeSample(sample, loggerIdentifier: loggerIdentifier)
+            }
+            group.enter()
+            if config.frequency > 0 {
+                var sequence = 0
+                let timer = DispatchSource.makeTimerSource(queue: producerQueue)
+                timer.schedule(deadline: .now(), repeating: 1.0 / config.frequency, leeway: .nanoseconds(0))
+                timer.setEventHandler {
+                    guard sequence < config.samplesPerStream else { return }
+                    produce(sequence: sequence)
+                    sequence += 1
+                    if sequence == config.samplesPerStream {
+                        timer.cancel()
+                        group.leave()
+                    }
+                }
+                timers.append(timer)
+                timer.resume()
+            } else {
+                producerQueue.async {
+                    for sequence in 0..<config.samplesPerStream {
+                        produce(sequence: sequence)
+                    }
+                    group.leave()
+                }
+            }
+        }
+        group.wait()
+        
+        // Wait for the samples that were dispatched to the logger queue. The recorder ignores samples
+        // that are dispatched after it has been asked to stop.
+        recorder.loggerQueue.sync {}
+        
+        // Stopping the recorder drains any buffered samples and closes the files.
+        var stopError: Error?
+        try RecorderBenchmark.runMainLoop { done in
+            recorder.stop { (_, _, error) in
+                stopError = error
+                done()
+            }
+        }
+        let elapsedTime = ProcessInfo.processInfo.systemUptime - start
+        if let error = stopError ?? recorder.error {
+            throw error
+        }
+        
+        let loggers = recorder.benchmarkLoggers
+        let latencies = loggers.flatMap { $0.latencies }.sorted()
+        let written = latencies.count
+        return Result(configuration: config,
+                      samplesProduced: config.streamCount * config.samplesPerStream,
+                      samplesWritten: written,
+                      samplesDropped: recorder.droppedSampleCount,
+                      elapsedTime: elapsedTime,
+                      samplesPerSecond: Double(written) / elapsedTime,
+                      latencyP50: RecorderBenchmark.percentile(0.5, of: latencies),
+                      latencyP99: RecorderBenchmark.percentile(0.99, of: latencies),
+                      bytesWritten: loggers.reduce(0) { $0 + $1.bytesWritten },
+                      peakResidentBytes: RecorderBenchmark.peakResidentBytes())
+    }
+    
+    enum BenchmarkError : Error {
+        case timeout
+    }
+    
+    /// Run the main run loop until the given block calls its completion handler.
+    static func runMainLoop(timeout: TimeInterval = 30, _ block: (@escaping () -> Void) -> Void) throws {
+        var isDone = false
+        block { isDone = true }
+        let deadline = Date(timeIntervalSinceNow: timeout)
+        while !isDone {
+            guard Date() < deadline else { throw BenchmarkError.timeout }
+            RunLoop.current.run(mode: .default, before: Date(timeIntervalSinceNow: 0.01))
+        }
+    }
+    
+    /// Returns the value at the given percentile of a sorted array.
+    static func percentile(_ p: Double, of sortedValues: [TimeInterval]) -> TimeInterval {
+        guard sortedValues.count > 0 else { return 0 }
+        let idx = Int((Double(sortedValues.count - 1) * p).rounded())
+        return sortedValues[idx]
+    }
+    
+    /// The peak resident memory size for the process. This is the high-water mark for the
+    /// lifetime of the process and not only for a single benchmark run.
+    static func peakResidentBytes() -> UInt64 {
+        var info = mach_task_basic_info()
+        var count = mach_msg_type_number_t(MemoryLayout<mach_task_basic_info>.size / MemoryLayout<natural_t>.size)
+        let result = withUnsafeMutablePointer(to: &info) {
+            $0.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(mach_task_self_, task_flavor_t(MACH_TASK_BASIC_INFO), $0, &count)
+            }
+        }
+        return (result == KERN_SUCCESS) ? UInt64(info.resident_size_max) : 0
+    }
+    
+    static func createTempDirectory() throws -> URL {
+        let path = (NSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        try FileManager.default.createDirectory(atPath: path, withIntermediateDirectories: true, attributes: nil)
+        return URL(fileURLWithPath: path, isDirectory: true)
+    }
+    
+    static func createTempFile(_ identifier: String, ext: String) throws -> URL {
+        let outputDirectory = try createTempDirectory()
+        return try RSDFileResultUtility.createFileURL(identifier: identifier, ext: ext, outputDirectory: outputDirectory)
+    }
+}
+
+/// `CompressionBenchmark` measures the cost of compressing a logging file as it is written compared
+/// with compressing the file when the archive is built at the end of the task.
+struct CompressionBenchmark {
+    
+    struct Configuration : Codable {
+        var format: RecorderBenchmark.Format
+        var contentEncoding: RSDContentEncoding?
+        var sampleCount: Int
+    }
+    
+    struct Result : Codable {
+        let configuration: Configuration
+        let uncompressedBytes: UInt64
+        let bytesWritten: UInt64
+        
+        /// The ratio of the uncompressed file size to the archived file size.
+        let compressionRatio: Double
+        
+        /// The CPU time used to write the file per MB of uncompressed data.
+        let cpuTimePerMB: TimeInterval
+        
+        /// The time to read (and compress if needed) the file when the archive is built.
+        let archiveTime: TimeInterval
+        
+        /// The size of the data added to the archive.
+        let archivedBytes: UInt64
+    }
+    
+    let configuration: Configuration
+    
+    func run() throws -> Result {
+        let config = self.configuration
+        let format: RSDStringSeparatedEncodingFormat? = (config.format == .csv) ? CSVEncodingFormat<SyntheticMotionRecord>() : nil
+        var ext = format?.fileExtension ?? "json"
+        if let encodingExt = config.contentEncoding?.fileExtension {
+            ext = "\(ext).\(encodingExt)"
+        }
+        let url = try RecorderBenchmark.createTempFile("benchmark", ext: ext)
+        defer {
+            try? FileManager.default.removeItem(at: url.deletingLastPathComponent())
+        }
+        let samples: [RSDSampleRecord] = (0..<config.sampleCount).map {
+            SyntheticMotionRecord(uptime: Double($0) * 0.01, stream: $0 % 2, sequence: $0)
+        }
+        
+        // Write the samples and measure the CPU time.
+        let startClock = clock()
+        let logger = try RSDRecordSampleLogger(identifier: "benchmark", url: url, usesRootDictionary: false, stringEncodingFormat: format, contentEncoding: config.contentEncoding)
+        try logger.writeSamples(samples)
+        try logger.close()
+        let cpuTime = TimeInterval(clock() - startClock) / TimeInterval(CLOCKS_PER_SEC)
+        
+        // Build the archive data. If the file is not already compressed, then compress it the way that
+        // an archive would compress it when the file is added.
+        let archiveStart = ProcessInfo.processInfo.systemUptime
+        var archivedData = try Data(contentsOf: url)
+        if config.contentEncoding == nil {
+            let encoder = try RSDGzipEncoder()
+            archivedData = try encoder.encode(archivedData) + encoder.finish()
+        }
+        let archiveTime = ProcessInfo.processInfo.systemUptime - archiveStart
+        
+        let uncompressedBytes = logger.uncompressedBytesWritten
+        let archivedBytes = UInt64(archivedData.count)
+        return Result(configuration: config,
+                      uncompressedBytes: uncompressedBytes,
+                      bytesWritten: logger.bytesWritten,
+                      compressionRatio: Double(uncompressedBytes) / Double(max(archivedBytes, 1)),
+                      cpuTimePerMB: cpuTime / (Double(uncompressedBytes) / 1_000_000),
+                      archiveTime: archiveTime,
+                      archivedBytes: archivedBytes)
+    }
+}
+
+/// The recorder benchmark suite.
+///
+/// The throughput tests use `measure()` and run with the other unit tests. The full configuration sweep
+/// and the compression comparison take much longer and are only run if the `RSD_RUN_BENCHMARK_SUITE`
+/// environment variable is set in the scheme.
+///
+/// The sweep results are written as JSON to the path defined by the `RSD_BENCHMARK_OUTPUT` environment
+/// variable or to "RecorderBenchmark.json" in the temporary directory. The duration of each paced
+/// run can be changed using the `RSD_BENCHMARK_DURATION` environment variable (default = 0.2 seconds).
+/// The compression results are written to the path defined by `RSD_COMPRESSION_BENCHMARK_OUTPUT` or to
+/// "CompressionBenchmark.json" in the temporary directory.
+class RecorderBenchmarkTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+    }
+    
+    override func tearDown() {
+        super.tearDown()
+    }
+    
+    /// Is the full benchmark suite enabled?
+    var isSuiteEnabled: Bool {
+        return ProcessInfo.processInfo.environment["RSD_RUN_BENCHMARK_SUITE"] != nil
+    }
+    
+    func testRecorderBenchmark_Suite() {
+        guard isSuiteEnabled else { return }
+        let environment = ProcessInfo.processInfo.environment
+        let duration = environment["RSD_BENCHMARK_DURATION"].flatMap { Double($0) } ?? 0.2
+        
+        var configurations = [RecorderBenchmark.Configuration]()
+        for schema in [RecorderBenchmark.Schema.motion, .distance] {
+            for format in [RecorderBenchmark.Format.json, .csv] {
+                for ingestion in [RecorderBenchmark.Ingestion.dispatch, .ringBuffer] {
+                    for streamCount in [1, 8] {
+                        // Paced runs to measure latency.
+                        for frequency in [100.0, 1000.0] {
+                            configurations.append(.init(schema: schema, format: format, ingestion: ingestion, frequency: frequency, streamCount: streamCount, samplesPerStream: max(1, Int(frequency * duration))))
+                        }
+                        // Unpaced runs to measure sustained throughput.
+                        configurations.append(.init(schema: schema, format: format, ingestion: ingestion, frequency: 0, streamCount: streamCount, samplesPerStream: 1000))
+                    }
+                }
+            }
+        }
+        
+        var results = [RecorderBenchmark.Result]()
+        for configuration in configurations {
+            do {
+                let result = try RecorderBenchmark(configuration: configuration).run()
+                XCTAssertEqual(result.samplesWritten + result.samplesDropped, result.samplesProduced, "\(configuration)")
+                XCTAssertGreaterThan(result.bytesWritten, 0)
+                results.append(result)
+            } catch let err {
+                XCTFail("Failed to run benchmark \(configuration): \(err)")
+            }
+        }
+        
+        do {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = .prettyPrinted
+            let data = try encoder.encode(results)
+            let path = environment["RSD_BENCHMARK_OUTPUT"] ?? (NSTemporaryDirectory() as NSString).appendingPathComponent("RecorderBenchmark.json")
+            try data.write(to: URL(fileURLWithPath: path))
+        } catch let err {
+            XCTFail("Failed to write benchmark results: \(err)")
+        }
+    }
+    
+    func testRecorderBenchmark_Compression() {
+        guard isSuiteEnabled else { return }
+        let environment = ProcessInfo.processInfo.environment
+        
+        var results = [CompressionBenchmark.Result]()
+        for format in [RecorderBenchmark.Format.json, .csv] {
+            for contentEncoding in [nil, RSDContentEncoding.gzip] {
+                let configuration = CompressionBenchmark.Configuration(format: format, contentEncoding: contentEncoding, sampleCount: 20000)
+                do {
+                    let result = try CompressionBenchmark(configuration: configuration).run()
+                    XCTAssertGreaterThan(result.compressionRatio, 1, "\(configuration)")
+                    if contentEncoding != nil {
+                        XCTAssertLessThan(result.bytesWritten, result.uncompressedBytes, "\(configuration)")
+                    }
+                    results.append(result)
+                } catch let err {
+                    XCTFail("Failed to run benchmark \(configuration): \(err)")
+                }
+            }
+        }
+        
+        do {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = .prettyPrinted
+            let data = try encoder.encode(results)
+            let path = environment["RSD_COMPRESSION_BENCHMARK_OUTPUT"] ?? (NSTemporaryDirectory() as NSString).appendingPathComponent("CompressionBenchmark.json")
+            try data.write(to: URL(fileURLWithPath: path))
+        } catch let err {
+            XCTFail("Failed to write benchmark results: \(err)")
+        }
+    }
+    
+    func testRecorderBenchmark_MotionCSVThroughput() {
+        let configuration = RecorderBenchmark.Configuration(schema: .motion, format: .csv, ingestion: .ringBuffer, frequency: 0, streamCount: 4, samplesPerStream: 2500)
+        self.measure {
+            _ = try? RecorderBenchmark(configuration: configuration).run()
+        }
+    }
+    
+    func testRecorderBenchmark_MotionJSONThroughput() {
+        let configuration = RecorderBenchmark.Configuration(schema: .motion, format: .json, ingestion: .ringBuffer, frequency: 0, streamCount: 4, samplesPerStream: 2500)
+        self.measure {
+            _ = try? RecorderBenchmark(configuration: configuration).run()
+        }
+    }
+}
@@ -112,4 +112,110 @@ class ResultTests: XCTestCase {
         XCTAssertNotEqual(a, c)
         XCTAssertNotEqual(a.hashValue, c.hashValue)
     }
+    
+    func testIndexedResults_DuplicatesAndRemoval() {
+        var results = RSDIndexedResults([RSDResultObject(identifier: "a"),
+                                         RSDResultObject(identifier: "b"),
+                                         RSDResultObject(identifier: "a"),
+                                         RSDResultObject(identifier: "c")])
+        XCTAssertEqual(results.index(of: "a"), 0)
+        XCTAssertEqual(results.index(of: "c"), 3)
+        
+        // Removing the first "a" should index the duplicate and shift the others.
+        XCTAssertNotNil(results.remove(with: "a"))
+        XCTAssertEqual(results.results.map { $0.identifier }, ["b", "a", "c"])
+        XCTAssertEqual(results.index(of: "b"), 0)
+        XCTAssertEqual(results.index(of: "a"), 1)
+        XCTAssertEqual(results.index(of: "c"), 2)
+        
+        XCTAssertNotNil(results.appendReplacing(RSDResultObject(identifier: "b")))
+        XCTAssertEqual(results.results.map { $0.identifier }, ["a", "c", "b"])
+        XCTAssertEqual(results.index(of: "b"), 2)
+        
+        let removed = results.removeAll(from: "c")
+        XCTAssertEqual(removed?.map { $0.identifier } ?? [], ["c", "b"])
+        XCTAssertEqual(results.results.map { $0.identifier }, ["a"])
+        XCTAssertNil(results.index(of: "b"))
+        XCTAssertNil(results.index(of: "c"))
+        XCTAssertNil(results.removeAll(from: "c"))
+    }
+    
+    func testIndexedResults_ChangeTokens() {
+        var results = RSDIndexedResults([RSDResultObject(identifier: "a"), RSDResultObject(identifier: "b")])
+        let tokenA = results.changeToken(for: "a")
+        let tokenB = results.changeToken(for: "b")
+        XCTAssertNotNil(tokenA)
+        XCTAssertNotEqual(tokenA, tokenB)
+        
+        // Replacing a result changes its token but not the tokens of the other results.
+        results.appendReplacing(RSDResultObject(identifier: "a"))
+        XCTAssertNotEqual(results.changeToken(for: "a"), tokenA)
+        XCTAssertEqual(results.changeToken(for: "b"), tokenB)
+        
+        // A result that is removed and added again gets a new token.
+        results.removeAll(from: "b")
+        XCTAssertNil(results.changeToken(for: "b"))
+        results.append(RSDResultObject(identifier: "b"))
+        XCTAssertNotEqual(results.changeToken(for: "b"), tokenB)
+        
+        // Copies share the tokens until they are changed.
+        let copy = results
+        XCTAssertEqual(copy.changeToken(for: "a"), results.changeToken(for: "a"))
+    }
+    
+    func testTaskResultExtensions() {
+        var taskResult = RSDTaskResultObject(identifier: "test")
+        for ii in 0..<5 {
+            taskResult.appendStepHistory(with: RSDResultObject(identifier: "step\(ii)"))
+        }
+        XCTAssertNotNil(taskResult.appendStepHistory(with: RSDResultObject(identifier: "step1")))
+        XCTAssertEqual(taskResult.stepHistory.map { $0.identifier }, ["step0", "step2", "step3", "step4", "step1"])
+        XCTAssertEqual(taskResult.findResult(with: "step3")?.identifier, "step3")
+        
+        let removed = taskResult.removeStepHistory(from: "step3")
+        XCTAssertEqual(removed?.map { $0.identifier } ?? [], ["step3", "step4", "step1"])
+        XCTAssertNil(taskResult.findResult(with: "step4"))
+        XCTAssertEqual(taskResult.stepHistory.map { $0.identifier }, ["step0", "step2"])
+        
+        taskResult.appendAsyncResult(with: RSDResultObject(identifier: "async"))
+        taskResult.appendAsyncResult(with: RSDResultObject(identifier: "async"))
+        XCTAssertEqual(taskResult.asyncResults?.count, 1)
+    }
+    
+    func testTaskResultAnswerIndex() {
+        var taskResult = RSDTaskResultObject(identifier: "test")
+        taskResult.usesAnswerIndex = true
+        var collection = RSDCollectionResultObject(identifier: "section1")
+        collection.appendInputResults(with: RSDAnswerResultObject(identifier: "a", answerType: .integer, value: 3))
+        taskResult.appendStepHistory(with: collection)
+        
+        XCTAssertEqual(taskResult.findAnswerResult(with: "a")?.value as? Int, 3)
+        XCTAssertEqual(taskResult.findAnswerResult(with: "a", inSection: "section1")?.value as? Int, 3)
+        XCTAssertNil(taskResult.findAnswerResult(with: "a", inSection: "section2"))
+        
+        // Replacing the section should invalidate the cached answers.
+        collection.appendInputResults(with: RSDAnswerResultObject(identifier: "a", answerType: .integer, value: 8))
+        taskResult.appendStepHistory(with: collection)
+        XCTAssertEqual(taskResult.findAnswerResult(with: "a")?.value as? Int, 8)
+        XCTAssertEqual(taskResult.findAnswerResult(with: "a", inSection: "section1")?.value as? Int, 8)
+        
+        // A copy made before mutation should keep the original answers.
+        let copy = taskResult
+        taskResult.removeStepHistory(from: "section1")
+        XCTAssertNil(taskResult.findAnswerResult(with: "a"))
+        XCTAssertEqual(copy.findAnswerResult(with: "a")?.value as? Int, 8)
+    }
+    
+    func testTaskResultLookupPerformance() {
+        var taskResult = RSDTaskResultObject(identifier: "test")
+        for ii in 0..<500 {
+            taskResult.appendStepHistory(with: RSDResultObject(identifier: "step\(ii)"))
+        }
+        measure {
+            for ii in 0..<500 {
+                _ = taskResult.findResult(with: "step\(ii)")
+                taskResult.appendStepHistory(with: RSDResultObject(identifier: "step\(ii)"))
+            }
+        }
+    }
 }
@@ -0,0 +1,160 @@
+//
+//  RingBufferTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class RingBufferTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+    }
+    
+    override func tearDown() {
+        super.tearDown()
+    }
+    
+    func testRingBuffer_Capacity() {
+        XCTAssertEqual(RSDRingBuffer<Int>(capacity: 1).capacity, 1)
+        XCTAssertEqual(RSDRingBuffer<Int>(capacity: 5).capacity, 8)
+        XCTAssertEqual(RSDRingBuffer<Int>(capacity: 1024).capacity, 1024)
+    }
+    
+    func testRingBuffer_PushAndDrain() {
+        let buffer = RSDRingBuffer<Int>(capacity: 4)
+        var values = [Int]()
+        
+        XCTAssertTrue(buffer.push(1))
+        XCTAssertTrue(buffer.push(2))
+        XCTAssertTrue(buffer.push(3))
+        XCTAssertEqual(buffer.count, 3)
+        XCTAssertEqual(buffer.drain(into: &values, maxCount: 2), 2)
+        XCTAssertEqual(values, [1, 2])
+        
+        // Wrap around the end of the buffer.
+        XCTAssertTrue(buffer.push(4))
+        XCTAssertTrue(buffer.push(5))
+        XCTAssertTrue(buffer.push(6))
+        XCTAssertEqual(buffer.count, 4)
+        
+        values.removeAll()
+        XCTAssertEqual(buffer.drain(into: &values), 4)
+        XCTAssertEqual(values, [3, 4, 5, 6])
+        XCTAssertEqual(buffer.count, 0)
+        XCTAssertEqual(buffer.droppedCount, 0)
+    }
+    
+    func testRingBuffer_DropsWhenFull() {
+        let buffer = RSDRingBuffer<Int>(capacity: 2)
+        XCTAssertTrue(buffer.push(1))
+        XCTAssertTrue(buffer.push(2))
+        XCTAssertFalse(buffer.push(3))
+        XCTAssertFalse(buffer.push(4))
+        XCTAssertEqual(buffer.droppedCount, 2)
+        
+        var values = [Int]()
+        buffer.drain(into: &values)
+        XCTAssertEqual(values, [1, 2])
+        XCTAssertTrue(buffer.push(5))
+        XCTAssertEqual(buffer.droppedCount, 2)
+    }
+    
+    func testRingBuffer_ScheduleDrain() {
+        let buffer = RSDRingBuffer<Int>(capacity: 2)
+        XCTAssertTrue(buffer.scheduleDrain())
+        XCTAssertFalse(buffer.scheduleDrain())
+        
+        var values = [Int]()
+        buffer.drain(into: &values)
+        XCTAssertTrue(buffer.scheduleDrain())
+    }
+    
+    func testRingBuffer_ReleasesDrainedValues() {
+        class Foo {}
+        let buffer = RSDRingBuffer<Foo>(capacity: 2)
+        weak var weakFoo: Foo?
+        do {
+            let foo = Foo()
+            weakFoo = foo
+            buffer.push(foo)
+            var values = [Foo]()
+            buffer.drain(into: &values)
+        }
+        XCTAssertNil(weakFoo)
+    }
+    
+    func testRingBuffer_ProducerConsumer() {
+        let buffer = RSDRingBuffer<Int>(capacity: 64)
+        let total = 100000
+        let producerQueue = DispatchQueue(label: "org.sagebase.ResearchTests.producer")
+        let consumerQueue = DispatchQueue(label: "org.sagebase.ResearchTests.consumer")
+        let expect = expectation(description: "Consumer finished")
+        
+        producerQueue.async {
+            var ii = 0
+            while ii < total {
+                if buffer.push(ii) {
+                    ii += 1
+                }
+            }
+        }
+        
+        consumerQueue.async {
+            var values = [Int]()
+            values.reserveCapacity(total)
+            while values.count < total {
+                buffer.drain(into: &values)
+            }
+            XCTAssertEqual(values, Array(0..<total))
+            expect.fulfill()
+        }
+        
+        waitForExpectations(timeout: 30, handler: nil)
+        XCTAssertEqual(buffer.count, 0)
+    }
+    
+    func testRingBuffer_Performance() {
+        let buffer = RSDRingBuffer<Int>(capacity: 1024)
+        var values = [Int]()
+        values.reserveCapacity(1024)
+        self.measure {
+            for _ in 0..<1000 {
+                for ii in 0..<1000 {
+                    buffer.push(ii)
+                }
+                values.removeAll(keepingCapacity: true)
+                buffer.drain(into: &values)
+            }
+        }
+    }
+}
@@ -0,0 +1,199 @@
+//
+//  SampleRecorderTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class TestSampleRecorder : RSDSampleRecorder {
+    
+    var testRotationPolicy: RSDDataLogger.RotationPolicy?
+    
+    override var rotationPolicy: RSDDataLogger.RotationPolicy? {
+        return testRotationPolicy
+    }
+    
+    override func stringEncodingFormat() -> RSDStringSeparatedEncodingFormat? {
+        return CSVEncodingFormat<TestRecord>()
+    }
+}
+
+class SampleRecorderTests: XCTestCase {
+    
+    var outputDirectory: URL!
+    
+    override func setUp() {
+        super.setUp()
+        outputDirectory = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(UUID().uuidString, isDirectory: true)
+        try? FileManager.default.createDirectory(at: outputDirectory, withIntermediateDirectories: true, attributes: nil)
+    }
+    
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: outputDirectory)
+        super.tearDown()
+    }
+    
+    func testSampleRecorder_Ingestion() {
+        let recorder = buildRecorder()
+        recorder.ingestionPolicy = RSDSampleRecorder.IngestionPolicy(bufferCapacity: 8, drainInterval: 0)
+        start(recorder)
+        
+        let identifier = recorder.defaultLoggerIdentifier
+        let producerQueue = DispatchQueue(label: "org.sagebase.ResearchTests.producer")
+        let burstCount = 2000
+        let burstSize = 4
+        var missedDrainCount = 0
+        producerQueue.sync {
+            for burst in 0..<burstCount {
+                let samples = (0..<burstSize).map {
+                    TestRecord(uptime: Double(burst * burstSize + $0), stepPath: "step1", label: nil, x: 1, y: 2, z: 3)
+                }
+                recorder.writeSamples(samples)
+                
+                // Wait for the burst to be written. If the drain is not scheduled, then the samples will
+                // stay in the buffer until the recorder is stopped. The start marker is the first sample.
+                let expectedCount = 1 + (burst + 1) * burstSize
+                let deadline = Date(timeIntervalSinceNow: 1)
+                while recorder.loggerQueue.sync(execute: { recorder.loggers[identifier]?.sampleCount ?? 0 }) < expectedCount {
+                    guard Date() < deadline else {
+                        missedDrainCount += 1
+                        break
+                    }
+                    usleep(50)
+                }
+            }
+        }
+        
+        stop(recorder)
+        
+        XCTAssertEqual(missedDrainCount, 0)
+        XCTAssertEqual(recorder.droppedSampleCount, 0)
+        guard let fileResult = recorder.result as? RSDFileResultObject, let url = fileResult.url else {
+            XCTFail("Failed to get the file result. \(String(describing: recorder.result))")
+            return
+        }
+        do {
+            let string = try String(contentsOf: url, encoding: .utf8)
+            let rows = string.components(separatedBy: "\n").filter { !$0.isEmpty }
+            XCTAssertEqual(rows.count, 2 + burstCount * burstSize)
+        } catch let err {
+            XCTFail("Failed to read the file: \(err)")
+        }
+    }
+    
+    func testSampleRecorder_Rotation() {
+        let recorder = buildRecorder()
+        recorder.testRotationPolicy = RSDDataLogger.RotationPolicy(maxSegmentSize: 256)
+        start(recorder)
+        
+        let sampleCount = 40
+        for ii in 0..<sampleCount {
+            recorder.writeSample(TestRecord(uptime: Double(ii), stepPath: "step1", label: nil, x: 1, y: 2, z: 3))
+        }
+        
+        stop(recorder)
+        
+        // Each segment should be added to the results with a unique identifier.
+        let fileResults = recorder.collectionResult.inputResults.compactMap { $0 as? RSDFileResultObject }
+        XCTAssertEqual(fileResults.count, recorder.collectionResult.inputResults.count)
+        XCTAssertGreaterThanOrEqual(fileResults.count, 3)
+        XCTAssertEqual(fileResults.map { $0.identifier }, (0..<fileResults.count).map { ($0 == 0) ? "test" : "test-\($0)" })
+        XCTAssertEqual(Set(fileResults.compactMap { $0.url }).count, fileResults.count)
+        
+        // Each segment starts with a header and a marker, and every sample should be in one of the segments.
+        var rowCount = 0
+        for fileResult in fileResults {
+            guard let url = fileResult.url else {
+                XCTFail("Missing url for \(fileResult.identifier)")
+                continue
+            }
+            do {
+                let string = try String(contentsOf: url, encoding: .utf8)
+                let rows = string.components(separatedBy: "\n").filter { !$0.isEmpty }
+                rowCount += rows.count - 2
+            } catch let err {
+                XCTFail("Failed to read the file: \(err)")
+            }
+        }
+        XCTAssertEqual(rowCount, sampleCount)
+    }
+    
+    func testSampleRecorder_Rotation_SegmentSmallerThanMarker() {
+        // The marker that starts each segment is the first write to the segment and should not rotate it
+        // even if the segment size is smaller than the header and marker.
+        let recorder = buildRecorder()
+        recorder.testRotationPolicy = RSDDataLogger.RotationPolicy(maxSegmentSize: 1)
+        start(recorder)
+        
+        let sampleCount = 5
+        for ii in 0..<sampleCount {
+            recorder.writeSample(TestRecord(uptime: Double(ii), stepPath: "step1", label: nil, x: 1, y: 2, z: 3))
+        }
+        
+        stop(recorder)
+        
+        let fileResults = recorder.collectionResult.inputResults.compactMap { $0 as? RSDFileResultObject }
+        XCTAssertEqual(fileResults.count, sampleCount + 1)
+    }
+    
+    // helper methods
+    
+    func buildRecorder(identifier: String = "test") -> TestSampleRecorder {
+        let navigator = RSDConditionalStepNavigatorObject(with: [])
+        let task = RSDTaskObject(identifier: "task", stepNavigator: navigator)
+        let taskViewModel = RSDTaskViewModel(task: task)
+        let config = RSDStandardAsyncActionConfiguration(identifier: identifier, type: RSDAsyncActionType(rawValue: identifier), startStepIdentifier: nil, stopStepIdentifier: nil)
+        return TestSampleRecorder(configuration: config, taskViewModel: taskViewModel, outputDirectory: outputDirectory)
+    }
+    
+    func start(_ recorder: RSDSampleRecorder) {
+        let expect = expectation(description: "Start \(recorder.configuration.identifier)")
+        recorder.start { (_, _, error) in
+            XCTAssertNil(error)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+    }
+    
+    func stop(_ recorder: RSDSampleRecorder) {
+        let expect = expectation(description: "Stop \(recorder.configuration.identifier)")
+        recorder.stop { (_, _, error) in
+            XCTAssertNil(error)
+            expect.fulfill()
+        }
+        waitForExpectations(timeout: 2) { (err) in
+            XCTAssertNil(err)
+        }
+    }
+}
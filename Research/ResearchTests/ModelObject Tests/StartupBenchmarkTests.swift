@@ -0,0 +1,122 @@
+//
+//  StartupBenchmarkTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class StartupBenchmarkTests: XCTestCase {
+    
+    var loadsLibrariesLazily: Bool = true
+    
+    override func setUp() {
+        super.setUp()
+        loadsLibrariesLazily = RSDColorMatrix.shared.loadsLibrariesLazily
+    }
+    
+    override func tearDown() {
+        RSDColorMatrix.shared.loadsLibrariesLazily = loadsLibrariesLazily
+        RSDColorMatrix.shared.releaseLibraries()
+        super.tearDown()
+    }
+    
+    func testLazyLibraries_MatchEagerLibraries() {
+        let matrix = RSDColorMatrix.shared
+        matrix.loadsLibrariesLazily = false
+        matrix.releaseLibraries()
+        let eager = matrix.registeredLibraries
+        let eagerCurrent = matrix.library(for: nil)
+        
+        matrix.loadsLibrariesLazily = true
+        matrix.releaseLibraries()
+        XCTAssertEqual(matrix.currentVersion, eagerCurrent.version)
+        XCTAssertEqual(matrix.library(for: nil), eagerCurrent)
+        XCTAssertEqual(matrix.library(for: 0), eager.first)
+        XCTAssertEqual(matrix.library(for: 1000), eagerCurrent)
+        XCTAssertEqual(matrix.registeredLibraries, eager)
+    }
+    
+    func testScanLibraryRanges() {
+        let json = """
+        [
+            { "version" : 0, "swatches" : [{ "name" : "a}b", "version" : 7 }] },
+            { "note" : "\\"version\\"", "version": 2 }
+        ]
+        """
+        let data = json.data(using: .utf8)!
+        guard let ranges = data.withUnsafeBytes({ RSDColorMatrix.scanLibraryRanges(in: $0) }) else {
+            XCTFail("Failed to scan the libraries.")
+            return
+        }
+        XCTAssertEqual(ranges.keys.sorted(), [0, 2])
+        if let range = ranges[0] {
+            XCTAssertEqual(String(data: data.subdata(in: range), encoding: .utf8),
+                           "{ \"version\" : 0, \"swatches\" : [{ \"name\" : \"a}b\", \"version\" : 7 }] }")
+        }
+        
+        let unclosed = "[{ \"version\" : 0 }".data(using: .utf8)!
+        XCTAssertNil(unclosed.withUnsafeBytes({ RSDColorMatrix.scanLibraryRanges(in: $0) }))
+    }
+    
+    func testTimeToFirstStep_LazyColorMatrix() {
+        measureTimeToFirstStep(loadsLibrariesLazily: true)
+    }
+    
+    func testTimeToFirstStep_EagerColorMatrix() {
+        measureTimeToFirstStep(loadsLibrariesLazily: false)
+    }
+    
+    func measureTimeToFirstStep(loadsLibrariesLazily: Bool) {
+        let matrix = RSDColorMatrix.shared
+        matrix.loadsLibrariesLazily = loadsLibrariesLazily
+        let resourceTransformer = RSDResourceTransformerObject(resourceName: "FactoryTest_TaskFoo", bundleIdentifier: BundleWrapper.bundleIdentifier!, classType: nil)
+        
+        measure {
+            matrix.releaseLibraries()
+            do {
+                let task = try RSDFactory.shared.decodeTask(with: resourceTransformer)
+                var taskResult: RSDTaskResult = RSDTaskResultObject(identifier: task.identifier)
+                let firstStep = task.stepNavigator.step(after: nil, with: &taskResult).step
+                XCTAssertNotNil(firstStep)
+                
+                // Build the colors for the first step the same way that a color palette is built.
+                _ = matrix.colorKey(for: .palette(.royal), shade: .light)
+                _ = matrix.colorKey(for: .palette(.rose), shade: .medium)
+                _ = matrix.colorKey(for: .palette(.apricot), shade: .medium)
+                _ = matrix.grayScale(for: nil)
+            }
+            catch let err {
+                XCTFail("Failed to decode the task: \(err)")
+            }
+        }
+    }
+}
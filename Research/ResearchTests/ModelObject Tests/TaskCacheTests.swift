@@ -0,0 +1,156 @@
+//
+//  TaskCacheTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+@testable import Research_UnitTest
+
+class TaskCacheTests: XCTestCase {
+    
+    final class CountingTransformer : RSDTaskTransformer {
+        let task: RSDTask
+        var fetchCount = 0
+        
+        init(task: RSDTask) {
+            self.task = task
+        }
+        
+        var estimatedFetchTime: TimeInterval {
+            return 0
+        }
+        
+        func fetchTask(with taskIdentifier: String, schemaInfo: RSDSchemaInfo?, callback: @escaping RSDTaskFetchCompletionHandler) {
+            fetchCount += 1
+            DispatchQueue.main.async {
+                callback(self.task, nil)
+            }
+        }
+    }
+    
+    final class CountingRepository : RSDTaskRepository {
+        let transformer: CountingTransformer
+        
+        init(transformer: CountingTransformer) {
+            self.transformer = transformer
+            super.init()
+        }
+        
+        override func taskTransformer(for taskInfo: RSDTaskInfo) throws -> RSDTaskTransformer {
+            return transformer
+        }
+    }
+    
+    func makeTask(_ identifier: String) -> TestTask {
+        return TestTask(identifier: identifier, stepNavigator: TestConditionalNavigator(steps: []))
+    }
+    
+    func testCache_EvictsLeastRecentlyUsed() {
+        let cache = RSDTaskCache(memoryBudget: 100)
+        let keyA = RSDTaskCache.Key(identifier: "a")
+        let keyB = RSDTaskCache.Key(identifier: "b")
+        let keyC = RSDTaskCache.Key(identifier: "c")
+        cache.insert(makeTask("a"), for: keyA, cost: 40)
+        cache.insert(makeTask("b"), for: keyB, cost: 40)
+        
+        // Touch "a" so that "b" is the least recently used.
+        XCTAssertNotNil(cache.task(for: keyA))
+        cache.insert(makeTask("c"), for: keyC, cost: 40)
+        
+        XCTAssertNotNil(cache.task(for: keyA))
+        XCTAssertNil(cache.task(for: keyB))
+        XCTAssertNotNil(cache.task(for: keyC))
+        XCTAssertEqual(cache.totalCost, 80)
+        
+        // A task that is larger than the budget is not cached.
+        cache.insert(makeTask("d"), for: RSDTaskCache.Key(identifier: "d"), cost: 200)
+        XCTAssertEqual(cache.count, 2)
+    }
+    
+    func testCache_KeyIncludesSchemaRevision() {
+        let cache = RSDTaskCache()
+        let keyV1 = RSDTaskCache.Key(identifier: "a", schemaInfo: RSDSchemaInfoObject(identifier: "a", revision: 1))
+        let keyV2 = RSDTaskCache.Key(identifier: "a", schemaInfo: RSDSchemaInfoObject(identifier: "a", revision: 2))
+        cache.insert(makeTask("a"), for: keyV1, cost: 1)
+        XCTAssertNil(cache.task(for: keyV2))
+    }
+    
+    func testRepository_CoalescesFetches() {
+        let transformer = CountingTransformer(task: makeTask("foo"))
+        let repository = CountingRepository(transformer: transformer)
+        repository.taskCache = RSDTaskCache()
+        let taskInfo = TestTaskInfo(task: makeTask("foo"))
+        
+        let first = expectation(description: "first fetch")
+        let second = expectation(description: "second fetch")
+        repository.fetchTask(for: taskInfo) { (_, task, error) in
+            XCTAssertNotNil(task)
+            XCTAssertNil(error)
+            first.fulfill()
+        }
+        repository.fetchTask(for: taskInfo) { (_, task, _) in
+            XCTAssertNotNil(task)
+            second.fulfill()
+        }
+        wait(for: [first, second], timeout: 2)
+        XCTAssertEqual(transformer.fetchCount, 1)
+        
+        let third = expectation(description: "cached fetch")
+        repository.fetchTask(for: taskInfo) { (_, task, _) in
+            XCTAssertEqual(task?.identifier, "foo")
+            third.fulfill()
+        }
+        wait(for: [third], timeout: 2)
+        XCTAssertEqual(transformer.fetchCount, 1)
+    }
+    
+    func testRepository_Prefetch() {
+        let transformer = CountingTransformer(task: makeTask("foo"))
+        let repository = CountingRepository(transformer: transformer)
+        repository.taskCache = RSDTaskCache()
+        let taskInfo = TestTaskInfo(task: makeTask("foo"))
+        
+        let prefetched = expectation(description: "prefetch")
+        repository.prefetchTasks(for: [taskInfo]) {
+            prefetched.fulfill()
+        }
+        wait(for: [prefetched], timeout: 2)
+        XCTAssertEqual(repository.taskCache?.count, 1)
+        
+        let fetched = expectation(description: "fetch")
+        repository.fetchTask(for: taskInfo) { (_, _, _) in
+            fetched.fulfill()
+        }
+        wait(for: [fetched], timeout: 2)
+        XCTAssertEqual(transformer.fetchCount, 1)
+    }
+}
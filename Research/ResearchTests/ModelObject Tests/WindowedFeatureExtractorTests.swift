@@ -0,0 +1,163 @@
+//
+//  WindowedFeatureExtractorTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+
+class WindowedFeatureExtractorTests: XCTestCase {
+    
+    override func setUp() {
+        super.setUp()
+    }
+    
+    override func tearDown() {
+        super.tearDown()
+    }
+    
+    func testWindowedFeatureExtractor_TumblingWindows() {
+        let extractor = RSDWindowedFeatureExtractor(identifier: "accelerometer", window: .init(duration: 1.0), samplingRate: 100)
+        XCTAssertEqual(extractor.windowLength, 100)
+        XCTAssertEqual(extractor.stride, 100)
+        
+        addTestSamples(to: extractor, count: 250)
+        XCTAssertEqual(extractor.sampleCount, 250)
+        XCTAssertEqual(extractor.windows.count, 2)
+        guard let window = extractor.windows.last else { return }
+        
+        XCTAssertEqual(window.sampleCount, 100)
+        XCTAssertEqual(window.startUptime, 1.0, accuracy: 0.0001)
+        XCTAssertEqual(window.endUptime, 1.99, accuracy: 0.0001)
+        
+        // x = 2 + sin(2π * 5t + 0.1)
+        XCTAssertEqual(window.x.mean, 2.0, accuracy: 0.0001)
+        XCTAssertEqual(window.x.variance, 0.5, accuracy: 0.0001)
+        XCTAssertEqual(window.x.rms, 4.5.squareRoot(), accuracy: 0.0001)
+        XCTAssertEqual(window.x.min, 2 + sin(-Double.pi / 2 + 0.1), accuracy: 0.0001)
+        XCTAssertEqual(window.x.max, 2 + sin(Double.pi / 2 + 0.1), accuracy: 0.0001)
+        XCTAssertEqual(window.x.zeroCrossings, 9)
+        XCTAssertEqual(window.x.dominantFrequency, 5.0, accuracy: 0.0001)
+        
+        // y = 0
+        XCTAssertEqual(window.y.mean, 0)
+        XCTAssertEqual(window.y.variance, 0)
+        XCTAssertEqual(window.y.zeroCrossings, 0)
+        XCTAssertEqual(window.y.dominantFrequency, 0)
+        
+        // z = cos(2π * 10t + 0.1)
+        XCTAssertEqual(window.z.mean, 0, accuracy: 0.0001)
+        XCTAssertEqual(window.z.rms, 0.5.squareRoot(), accuracy: 0.0001)
+        XCTAssertEqual(window.z.zeroCrossings, 20)
+        XCTAssertEqual(window.z.dominantFrequency, 10.0, accuracy: 0.0001)
+    }
+    
+    func testWindowedFeatureExtractor_SlidingWindows() {
+        let extractor = RSDWindowedFeatureExtractor(identifier: "gyro", window: .init(duration: 1.0, stride: 0.5), samplingRate: 100)
+        XCTAssertEqual(extractor.stride, 50)
+        
+        addTestSamples(to: extractor, count: 250)
+        XCTAssertEqual(extractor.windows.count, 4)
+        XCTAssertEqual(extractor.windows.map { $0.startUptime }, [0.0, 0.5, 1.0, 1.5])
+        
+        // Each window covers whole periods of the signal so the features should match.
+        let tumbling = RSDWindowedFeatureExtractor(identifier: "gyro", windowLength: 100, samplingRate: 100)
+        addTestSamples(to: tumbling, count: 100)
+        XCTAssertEqual(extractor.windows[1].x.mean, tumbling.windows[0].x.mean, accuracy: 0.0001)
+        XCTAssertEqual(extractor.windows[1].x.dominantFrequency, tumbling.windows[0].x.dominantFrequency)
+    }
+    
+    func testWindowedFeaturesResult_Archive() {
+        let extractor = RSDWindowedFeatureExtractor(identifier: "accelerometer", windowLength: 50, samplingRate: 100)
+        addTestSamples(to: extractor, count: 200)
+        let result = RSDWindowedFeaturesResultObject(identifier: "accelerometerFeatures", extractor: extractor)
+        XCTAssertEqual(result.type, .windowedFeatures)
+        XCTAssertEqual(result.windows.count, 4)
+        
+        do {
+            guard let archive = try result.buildArchiveData(at: "step1") else {
+                XCTFail("Failed to build the archive data")
+                return
+            }
+            XCTAssertEqual(archive.manifest.filename, "accelerometerFeatures.json")
+            XCTAssertEqual(archive.manifest.contentType, "application/json")
+            
+            let decoder = RSDFactory.shared.createJSONDecoder()
+            let decoded = try decoder.decode(RSDWindowedFeaturesResultObject.self, from: archive.data)
+            XCTAssertEqual(decoded.windows, result.windows)
+            XCTAssertEqual(decoded.windowLength, 50)
+            XCTAssertEqual(decoded.stride, 50)
+        
+        } catch let err {
+            XCTFail("Failed to encode/decode the result: \(err)")
+        }
+    }
+    
+    func testPowerSpectrum_MatchesDFT() {
+        // 64 is a power of two. 100 uses the chirp-z transform.
+        for length in [64, 100] {
+            let signal = (0..<length).map { sin(Double($0) * 0.7) + 0.5 * cos(Double($0 * $0) * 0.01) }
+            let spectrum = RSDPowerSpectrum(length: length)
+            spectrum.calculate { signal[$0] }
+            XCTAssertEqual(spectrum.power.count, length / 2 + 1)
+            for k in 0..<spectrum.power.count {
+                var real: Double = 0
+                var imag: Double = 0
+                for n in 0..<length {
+                    let angle = 2 * Double.pi * Double(k * n) / Double(length)
+                    real += signal[n] * cos(angle)
+                    imag -= signal[n] * sin(angle)
+                }
+                XCTAssertEqual(spectrum.power[k], real * real + imag * imag, accuracy: 1e-8, "length=\(length) k=\(k)")
+            }
+        }
+    }
+    
+    func testWindowedFeatureExtractor_Performance() {
+        self.measure {
+            let extractor = RSDWindowedFeatureExtractor(identifier: "accelerometer", window: .init(duration: 2.0, stride: 1.0), samplingRate: 100)
+            addTestSamples(to: extractor, count: 100 * 60)
+            XCTAssertEqual(extractor.windows.count, 59)
+        }
+    }
+    
+    // helper methods
+    
+    func addTestSamples(to extractor: RSDWindowedFeatureExtractor, count: Int) {
+        for ii in 0..<count {
+            let t = Double(ii) / 100.0
+            extractor.append(uptime: t,
+                             x: 2 + sin(2 * Double.pi * 5 * t + 0.1),
+                             y: 0,
+                             z: cos(2 * Double.pi * 10 * t + 0.1))
+        }
+    }
+}
@@ -0,0 +1,118 @@
+//
+//  StepNavigatorIndexTests.swift
+//  ResearchTests
+//
+//  Copyright © 2019 Sage Bionetworks. All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1.  Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+//
+// 2.  Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation and/or
+// other materials provided with the distribution.
+//
+// 3.  Neither the name of the copyright holder(s) nor the names of any contributors
+// may be used to endorse or promote products derived from this software without
+// specific prior written permission. No license is granted to the trademarks of
+// the copyright holders even if such marks are included in this software.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+import XCTest
+@testable import Research
+@testable import Research_UnitTest
+
+class StepNavigatorIndexTests: XCTestCase {
+    
+    /// Build a conditional task with a jump every 10 steps and a step that is skipped every 7 steps.
+    func buildSteps(count: Int) -> [RSDStep] {
+        return (0..<count).map { ii -> RSDStep in
+            var step = TestStep(identifier: "step\(ii)")
+            if ii % 10 == 3, ii + 3 < count {
+                step.nextStepIdentifier = "step\(ii + 3)"
+            }
+            if ii % 7 == 5 {
+                step.showBeforeIdentifier = "notFound"
+            }
+            return step
+        }
+    }
+    
+    func walk(_ navigator: RSDStepNavigator) -> (identifiers: [String], progress: [Int]) {
+        var taskResult: RSDTaskResult = RSDTaskResultObject(identifier: "test")
+        var identifiers: [String] = []
+        var progress: [Int] = []
+        var step = navigator.step(after: nil, with: &taskResult).step
+        while let currentStep = step {
+            identifiers.append(currentStep.identifier)
+            progress.append(navigator.progress(for: currentStep, with: taskResult)?.current ?? -1)
+            taskResult.appendStepHistory(with: RSDResultObject(identifier: currentStep.identifier))
+            step = navigator.step(after: currentStep, with: &taskResult).step
+        }
+        return (identifiers, progress)
+    }
+    
+    func testIndexedNavigation_MatchesUnindexed() {
+        let steps = buildSteps(count: 100)
+        let expected = walk(TestConditionalNavigator(steps: steps))
+        let actual = walk(RSDConditionalStepNavigatorObject(with: steps))
+        XCTAssertEqual(actual.identifiers, expected.identifiers)
+        XCTAssertEqual(actual.progress, expected.progress)
+        XCTAssertFalse(actual.identifiers.contains("step4"))
+        XCTAssertFalse(actual.identifiers.contains("step5"))
+    }
+    
+    func testIndexedProgressMarkers_MatchesUnindexed() {
+        let steps = buildSteps(count: 100)
+        let markers = stride(from: 0, to: 100, by: 4).map { "step\($0)" }
+        var expectedNavigator = TestConditionalNavigator(steps: steps)
+        expectedNavigator.progressMarkers = markers
+        var navigator = RSDConditionalStepNavigatorObject(with: steps)
+        navigator.progressMarkers = markers
+        XCTAssertEqual(walk(navigator).progress, walk(expectedNavigator).progress)
+    }
+    
+    func testCopyAndInsertAndRemove() {
+        var navigator = RSDConditionalStepNavigatorObject(with: buildSteps(count: 20))
+        navigator.insertAfterIdentifier = "step1"
+        let section = RSDSectionStepObject(identifier: "section", steps: TestStep.steps(from: ["a", "b"]))
+        
+        let inserted = navigator.copyAndInsert(section)
+        XCTAssertEqual(inserted.index(of: "section"), 2)
+        XCTAssertEqual(inserted.index(of: "step2"), 3)
+        XCTAssertEqual(inserted.step(with: "step19")?.identifier, "step19")
+        
+        let removed = inserted.copyAndRemove(["step0", "section"])
+        XCTAssertNil(removed.index(of: "section"))
+        XCTAssertEqual(removed.index(of: "step1"), 0)
+        XCTAssertEqual(removed.index(of: "step2"), 1)
+        XCTAssertEqual(walk(removed).identifiers, walk(TestConditionalNavigator(steps: removed.steps)).identifiers)
+    }
+    
+    func testNavigationPerformance_Unindexed() {
+        let navigator = TestConditionalNavigator(steps: buildSteps(count: 1000))
+        measure {
+            _ = walk(navigator)
+        }
+    }
+    
+    func testNavigationPerformance_Indexed() {
+        let navigator = RSDConditionalStepNavigatorObject(with: buildSteps(count: 1000))
+        measure {
+            _ = walk(navigator)
+        }
+    }
+}
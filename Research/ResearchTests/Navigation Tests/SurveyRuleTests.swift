@@ -1055,6 +1055,99 @@ class SurveyRuleTests: XCTestCase {
     }
     
     
+    // Compiled rules
+    
+    func testCompiledRule_MatchesPredicate() {
+        let ops: [RSDSurveyRuleOperator] = [.equal, .notEqual, .lessThan, .greaterThan, .lessThanEqual, .greaterThanEqual, .otherThan]
+        let date = Date(timeIntervalSinceReferenceDate: 500000000)
+        let arrayType = RSDAnswerResultType(baseType: .string, sequenceType: .array)
+        let intArrayType = RSDAnswerResultType(baseType: .integer, sequenceType: .array)
+        
+        let cases: [(RSDAnswerResultType, RSDComparable, [Any])] = [
+            (.integer, createRule(nil, 2, .equal), [1, 2, 3, 2.0, true]),
+            (.decimal, createRule(nil, 2.0, .equal), [1.5, 2.0, 2.000001, 2.1, 3]),
+            (.decimal, try! RSDChoiceObject<Double>(value: 0.3), [0.1 + 0.2, 0.30002, 0.2999]),
+            (.string, createRule(nil, "beta", .equal), ["alpha", "beta", "gamma", "Beta"]),
+            (.boolean, createRule(nil, true, .equal), [true, false, 1, 0]),
+            (.date, createRule(nil, date, .equal), [date, date.addingTimeInterval(-1), date.addingTimeInterval(1)]),
+            (arrayType, createRule(nil, "beta", .equal), [["alpha"], ["alpha", "beta"], "beta", ["beta", "gamma"]]),
+            (arrayType, createRule(nil, ["beta", "gamma"], .equal), [["alpha"], ["beta", "gamma"], ["gamma"], ["gamma", "beta"]]),
+            (intArrayType, createRule(nil, [1, 2], .equal), [[1], [2, 1], [3], [1, 2]]),
+            ]
+        
+        for (answerType, rule, values) in cases {
+            for op in ops {
+                let compiled = rule.compileRule(with: answerType, op: op)
+                guard !compiled.usesPredicate,
+                    let predicate = rule.rulePredicate(with: answerType, op: op)
+                    else {
+                        continue
+                }
+                for value in values {
+                    let expected = rule.convertValue(for: value, with: answerType).map { predicate.evaluate(with: $0) } ?? false
+                    XCTAssertEqual(compiled.evaluate(value), expected, "\(answerType) \(op.rawValue) \(value) \(String(describing: rule.matchingAnswer))")
+                }
+            }
+        }
+    }
+    
+    func testCompiledRule_ArrayOrdering_UsesPredicate() {
+        let arrayType = RSDAnswerResultType(baseType: .integer, sequenceType: .array)
+        let rule = createRule(nil, 2, .lessThan)
+        XCTAssertTrue(rule.compileRule(with: arrayType, op: .lessThan).usesPredicate)
+        XCTAssertFalse(rule.compileRule(with: .integer, op: .lessThan).usesPredicate)
+    }
+    
+    func testCompiledRule_Performance() {
+        var rules = [RSDComparableSurveyRuleObject<Int>]()
+        for ii in 0..<100 {
+            rules.append(createRule("equal\(ii)", ii, .equal))
+            rules.append(createRule("lessThan\(ii)", ii, .lessThan))
+        }
+        var answerResult = RSDAnswerResultObject(identifier: "field2", answerType: .integer)
+        answerResult.value = 50
+        let iterations = 100
+        self.measure {
+            var matches = 0
+            let start = ProcessInfo.processInfo.systemUptime
+            for _ in 0..<iterations {
+                for rule in rules where rule.evaluateRule(with: answerResult) != nil {
+                    matches += 1
+                }
+            }
+            let duration = ProcessInfo.processInfo.systemUptime - start
+            XCTAssertEqual(matches, 50 * iterations)
+            print("Compiled survey rules: \(Int(Double(rules.count * iterations) / duration)) evaluations/sec")
+        }
+    }
+    
+    func testPredicateRule_Performance() {
+        var rules = [RSDComparableSurveyRuleObject<Int>]()
+        for ii in 0..<100 {
+            rules.append(createRule("equal\(ii)", ii, .equal))
+            rules.append(createRule("lessThan\(ii)", ii, .lessThan))
+        }
+        let iterations = 100
+        self.measure {
+            var matches = 0
+            let start = ProcessInfo.processInfo.systemUptime
+            for _ in 0..<iterations {
+                for rule in rules {
+                    // The previous implementation built a new predicate for each evaluation.
+                    let op = rule.ruleOperator!
+                    if let predicate = rule.rulePredicate(with: .integer, op: op),
+                        let value = rule.convertValue(for: 50, with: .integer),
+                        predicate.evaluate(with: value) {
+                        matches += 1
+                    }
+                }
+            }
+            let duration = ProcessInfo.processInfo.systemUptime - start
+            XCTAssertEqual(matches, 50 * iterations)
+            print("NSPredicate survey rules: \(Int(Double(rules.count * iterations) / duration)) evaluations/sec")
+        }
+    }
+    
     // Helper methods
     
     func createRule<Value : Codable>(_ skipIdentifier: String?, _ matchingValue: Value, _ ruleOperator:RSDSurveyRuleOperator) -> RSDComparableSurveyRuleObject<Value> {